@@ -0,0 +1,229 @@
+/*
+===============================================================================
+
+  FILE:  blockcheck.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "blockcheck.hpp"
+#include "laskernels.hpp"
+#include "checkutility.hpp"
+
+void BLOCKcheck::end_run(LASheader* lasheader)
+{
+  CHAR note[256];
+
+  if (run_type == LASKERNELS_RECORD_ZERO)
+  {
+    if (run_length >= BLOCKCHECK_MIN_RUN)
+    {
+      if (number_of_zero_runs < BLOCKCHECK_MAX_REPORTS)
+      {
+        I64 start = offset_to_point_data + run_start * record_length;
+#ifdef _WIN32
+        sprintf(note, "%I64d records from %I64d to %I64d (bytes %I64d to %I64d) are all zero", run_length, run_start, run_start + run_length - 1, start, start + run_length * record_length);
+#else
+        sprintf(note, "%lld records from %lld to %lld (bytes %lld to %lld) are all zero", run_length, run_start, run_start + run_length - 1, start, start + run_length * record_length);
+#endif
+        lasheader->add_fail("point records", note);
+      }
+      number_of_zero_runs++;
+      number_of_zero_records += run_length;
+    }
+  }
+  else if (run_type == LASKERNELS_RECORD_REPEATED)
+  {
+    if (run_length >= BLOCKCHECK_MIN_RUN)
+    {
+      if (number_of_repeated_runs < BLOCKCHECK_MAX_REPORTS)
+      {
+        // the run includes the record that all the marked records repeat
+
+        I64 start = offset_to_point_data + (run_start - 1) * record_length;
+#ifdef _WIN32
+        sprintf(note, "%I64d records from %I64d to %I64d (bytes %I64d to %I64d) are identical", run_length + 1, run_start - 1, run_start + run_length - 1, start, start + (run_length + 1) * record_length);
+#else
+        sprintf(note, "%lld records from %lld to %lld (bytes %lld to %lld) are identical", run_length + 1, run_start - 1, run_start + run_length - 1, start, start + (run_length + 1) * record_length);
+#endif
+        lasheader->add_warning("point records", note);
+      }
+      number_of_repeated_runs++;
+      number_of_repeated_records += run_length + 1;
+    }
+  }
+  run_type = 0;
+  run_length = 0;
+}
+
+BOOL BLOCKcheck::check(const CHAR* file_name, LASheader* lasheader)
+{
+  CHAR note[256];
+  U32 i;
+
+  FILE* file = fopen(file_name, "rb");
+  if (file == 0)
+  {
+    return FALSE;
+  }
+  CHECKrawheader raw;
+  if (!raw.read(file))
+  {
+    fclose(file);
+    return FALSE;
+  }
+
+  // the header fields as stored in the file because compressed points cannot be scanned raw
+
+  U64 number_of_point_records = raw.number_of_point_records;
+  if ((raw.point_data_format & 0xC0) || (raw.point_data_record_length == 0) || (number_of_point_records == 0))
+  {
+    fclose(file);
+    return FALSE;
+  }
+
+  offset_to_point_data = raw.offset_to_point_data;
+  record_length = raw.point_data_record_length;
+  run_type = 0;
+  run_start = 0;
+  run_length = 0;
+  number_of_zero_runs = 0;
+  number_of_zero_records = 0;
+  number_of_repeated_runs = 0;
+  number_of_repeated_records = 0;
+
+  // one extra record in front of each block holds the last record of the previous block
+
+  U8* buffer = (U8*)malloc((size_t)(BLOCKCHECK_RECORDS_PER_BLOCK + 1) * record_length);
+  U8* classes = (U8*)malloc(BLOCKCHECK_RECORDS_PER_BLOCK);
+  if ((buffer == 0) || (classes == 0))
+  {
+    if (buffer) free(buffer);
+    if (classes) free(classes);
+    fclose(file);
+    return FALSE;
+  }
+
+  const LASkernels* laskernels = LASkernels::get();
+  U8* records = buffer + record_length;
+  I64 index = 0;
+  check_seek(file, offset_to_point_data);
+  while ((U64)index < number_of_point_records)
+  {
+    U32 want = BLOCKCHECK_RECORDS_PER_BLOCK;
+    if ((U64)(index + want) > number_of_point_records)
+    {
+      want = (U32)(number_of_point_records - index);
+    }
+    U32 n = (U32)fread(records, record_length, want, file);
+    if (n == 0)
+    {
+      break;
+    }
+    if (index == 0)
+    {
+      // the complement of the first record so that it cannot repeat what is in front of it
+
+      for (i = 0; i < record_length; i++)
+      {
+        buffer[i] = (U8)~records[i];
+      }
+    }
+    U32 marked = laskernels->classify_records(records, n, record_length, classes);
+    if (marked || run_type)
+    {
+      for (i = 0; i < n; i++)
+      {
+        if (classes[i] != run_type)
+        {
+          end_run(lasheader);
+          if (classes[i])
+          {
+            run_type = classes[i];
+            run_start = index + i;
+          }
+        }
+        if (run_type)
+        {
+          run_length++;
+        }
+      }
+    }
+    memcpy(buffer, records + (size_t)(n - 1) * record_length, record_length);
+    index += n;
+    if (n < want)
+    {
+      break;
+    }
+  }
+  end_run(lasheader);
+
+  free(buffer);
+  free(classes);
+  fclose(file);
+
+  // summarize what was not reported individually
+
+  if (number_of_zero_runs > BLOCKCHECK_MAX_REPORTS)
+  {
+#ifdef _WIN32
+    sprintf(note, "%I64d more runs of all zero records for a total of %I64d all zero records", number_of_zero_runs - BLOCKCHECK_MAX_REPORTS, number_of_zero_records);
+#else
+    sprintf(note, "%lld more runs of all zero records for a total of %lld all zero records", number_of_zero_runs - BLOCKCHECK_MAX_REPORTS, number_of_zero_records);
+#endif
+    lasheader->add_fail("point records", note);
+  }
+  if (number_of_repeated_runs > BLOCKCHECK_MAX_REPORTS)
+  {
+#ifdef _WIN32
+    sprintf(note, "%I64d more runs of identical records for a total of %I64d identical records", number_of_repeated_runs - BLOCKCHECK_MAX_REPORTS, number_of_repeated_records);
+#else
+    sprintf(note, "%lld more runs of identical records for a total of %lld identical records", number_of_repeated_runs - BLOCKCHECK_MAX_REPORTS, number_of_repeated_records);
+#endif
+    lasheader->add_warning("point records", note);
+  }
+  return TRUE;
+}
+
+BLOCKcheck::BLOCKcheck()
+{
+  offset_to_point_data = 0;
+  record_length = 0;
+  run_type = 0;
+  run_start = 0;
+  run_length = 0;
+  number_of_zero_runs = 0;
+  number_of_zero_records = 0;
+  number_of_repeated_runs = 0;
+  number_of_repeated_records = 0;
+}
+
+BLOCKcheck::~BLOCKcheck()
+{
+}
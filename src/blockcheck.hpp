@@ -0,0 +1,73 @@
+/*
+===============================================================================
+
+  FILE:  blockcheck.hpp
+
+  CONTENTS:
+
+    Scans the raw point records of an uncompressed LAS file for runs of
+    records that are all zero or that repeat the record before them byte
+    for byte. Failed copies, sparse files, and truncated transfers leave
+    such blocks behind and they pass every check of the header as valid
+    points at the offset. The records are read in large blocks directly
+    from the file and classified by the record kernel of LASkernels, which
+    compares eight bytes at a time. Runs of at least BLOCKCHECK_MIN_RUN
+    records are reported with their byte ranges. Compressed files are not
+    scanned.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    19 October 2026 -- reads the raw header with the helper of layout check
+    19 October 2026 -- created for catching zeroed blocks left by failed copies
+
+===============================================================================
+*/
+#ifndef BLOCK_CHECK_HPP
+#define BLOCK_CHECK_HPP
+
+#include <stdio.h>
+
+#include "lasheader.hpp"
+
+#define BLOCKCHECK_RECORDS_PER_BLOCK 8192
+#define BLOCKCHECK_MIN_RUN 16
+#define BLOCKCHECK_MAX_REPORTS 5
+
+class BLOCKcheck
+{
+public:
+
+  BOOL check(const CHAR* file_name, LASheader* lasheader);
+
+  BLOCKcheck();
+  ~BLOCKcheck();
+
+private:
+  I64 offset_to_point_data;
+  U32 record_length;
+  U32 run_type;
+  I64 run_start;
+  I64 run_length;
+  I64 number_of_zero_runs;
+  I64 number_of_zero_records;
+  I64 number_of_repeated_runs;
+  I64 number_of_repeated_records;
+  void end_run(LASheader* lasheader);
+};
+
+#endif
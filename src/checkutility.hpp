@@ -0,0 +1,135 @@
+/*
+===============================================================================
+
+  FILE:  checkutility.hpp
+
+  CONTENTS:
+
+    Small helpers that several of the checks share, such as the number of
+    decimal digits that a scale factor calls for when printing coordinates,
+    whether a point data format stores a GPS time stamp, and the fields of
+    the LAS header as they are stored in the file for the checks that read
+    the file raw.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    19 October 2026 -- raw header parse and seeks shared by layout and block check
+    19 October 2026 -- created from copies in four of the checks
+
+===============================================================================
+*/
+#ifndef CHECK_UTILITY_HPP
+#define CHECK_UTILITY_HPP
+
+#include <stdio.h>
+#include <string.h>
+
+#include "mydefs.hpp"
+
+#ifdef _WIN32
+#define check_seek(file, offset) _fseeki64(file, offset, SEEK_SET)
+#define check_seek_end(file) _fseeki64(file, 0, SEEK_END)
+#define check_tell(file) _ftelli64(file)
+#else
+#define check_seek(file, offset) fseeko(file, (off_t)(offset), SEEK_SET)
+#define check_seek_end(file) fseeko(file, 0, SEEK_END)
+#define check_tell(file) ((I64)ftello(file))
+#endif
+
+// the number of digits after the decimal point that a scale factor resolves,
+// for example 2 for a scale of 0.01, but never more than 8
+
+inline I32 decimal_digits(F64 scale)
+{
+  I32 digits = 0;
+  while ((scale < 1.0) && (digits < 8))
+  {
+    scale *= 10.0;
+    digits++;
+  }
+  return digits;
+}
+
+// all point data formats except 0 and 2 store a GPS time stamp
+
+inline BOOL format_has_gps_time(const U8 point_data_format)
+{
+  return ((point_data_format != 0) && (point_data_format != 2));
+}
+
+// the header fields as stored in the file because the reader may have changed
+// some of them and because compressed points cannot be scanned raw. the fields
+// that the version or the header size does not have are zero.
+
+class CHECKrawheader
+{
+public:
+  U8 version_minor;
+  U16 header_size;
+  U32 offset_to_point_data;
+  U32 number_of_variable_length_records;
+  U8 point_data_format;
+  U16 point_data_record_length;
+  U64 start_of_waveform_data_packet_record;
+  U64 start_of_first_extended_variable_length_record;
+  U32 number_of_extended_variable_length_records;
+  U64 number_of_point_records;
+
+  BOOL read(FILE* file);
+};
+
+inline BOOL CHECKrawheader::read(FILE* file)
+{
+  U8 bytes[375];
+  U32 legacy_number_of_point_records;
+
+  memset(bytes, 0, 375);
+  check_seek(file, 0);
+  if (fread(bytes, 1, 375, file) < 227)
+  {
+    return FALSE;
+  }
+  version_minor = bytes[25];
+  point_data_format = bytes[104];
+  start_of_waveform_data_packet_record = 0;
+  start_of_first_extended_variable_length_record = 0;
+  number_of_extended_variable_length_records = 0;
+  number_of_point_records = 0;
+  memcpy(&header_size, bytes + 94, 2);
+  memcpy(&offset_to_point_data, bytes + 96, 4);
+  memcpy(&number_of_variable_length_records, bytes + 100, 4);
+  memcpy(&point_data_record_length, bytes + 105, 2);
+  memcpy(&legacy_number_of_point_records, bytes + 107, 4);
+  if ((version_minor >= 3) && (header_size >= 235))
+  {
+    memcpy(&start_of_waveform_data_packet_record, bytes + 227, 8);
+  }
+  if ((version_minor >= 4) && (header_size >= 375))
+  {
+    memcpy(&start_of_first_extended_variable_length_record, bytes + 235, 8);
+    memcpy(&number_of_extended_variable_length_records, bytes + 243, 4);
+    memcpy(&number_of_point_records, bytes + 247, 8);
+  }
+  if (number_of_point_records == 0)
+  {
+    number_of_point_records = legacy_number_of_point_records;
+  }
+  return TRUE;
+}
+
+#endif
@@ -0,0 +1,691 @@
+/*
+===============================================================================
+
+  FILE:  crsbench.cpp
+
+  CONTENTS:
+
+    A benchmark that resolves synthetic GeoKeyDirectories the way the CRS
+    check resolves those of a file: one with a ProjectedCSTypeGeoKey for
+    every EPSG code that the CRS check supports, one for every combination
+    of a supported ellipsoid, linear units, and a set of parameters for a
+    user-defined transverse mercator or lambert conformal conic projection,
+    and one for every supported VerticalCSTypeGeoKey. It reports the time
+    per directory for each kind and with '-times' for each directory. With
+    '-golden' it writes everything that each directory resolves to into a
+    file and with '-compare' it checks that this has not changed, so that
+    the CRS check can be optimized without silently changing its results.
+    With '-print' it lists the description of each supported EPSG code.
+    With '-projected_compare' it checks what every value of the geokey
+    ProjectedCSTypeGeoKey resolves to on its own against a file that was
+    written by the switch statement that the table of zones replaced.
+    With '-area' it checks that a real tile passes the area of use check
+    of its EPSG code and fails it with x and y swapped.
+    With '-write_database' it writes what the built-in tables resolve to a
+    CRS database file and with '-database' it resolves the codes with one.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    19 October 2026 -- real tiles with x and y swapped against the area of use
+    19 October 2026 -- every ProjectedCSTypeGeoKey compared with the old switch
+    19 October 2026 -- user-defined projections, vertical codes, and golden output
+    19 October 2026 -- one CRScheck is reset and reused for all codes
+    19 October 2026 -- writing and loading a memory-mapped CRS database
+    19 October 2026 -- created for timing the look-up of EPSG codes
+
+===============================================================================
+*/
+
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "crscheck.hpp"
+#include "crsdatabase.hpp"
+
+#define CRSBENCH_EPSG      0
+#define CRSBENCH_TM        1
+#define CRSBENCH_LCC       2
+#define CRSBENCH_VERTICAL  3
+#define CRSBENCH_KINDS     4
+
+static const CHAR* crsbench_kind_names[CRSBENCH_KINDS] = { "EPSG codes", "user-defined TM projections", "user-defined LCC projections", "vertical codes" };
+
+// in the order of the CRS_PROJECTION_* types in crscheck.cpp
+
+static const CHAR* crsbench_projection_names[7] = { "UTM", "LCC", "TM", "longlat", "latlong", "ECEF", "none" };
+
+// the GeogEllipsoidGeoKey codes that CRScheck::check_geokeys() knows
+
+static const U16 crsbench_ellipsoids[] = { 7001, 7002, 7003, 7004, 7005, 7006, 7008, 7009, 7010, 7011, 7012, 7013, 7014, 7015, 7016, 7017, 7018, 7019, 7020, 7022, 7023, 7024, 7030, 7034 };
+
+// no units and the three ProjLinearUnitsGeoKey codes
+
+static const U16 crsbench_units[] = { 0, 9001, 9002, 9003 };
+
+// false easting, false northing, latitude of origin, central meridian, and scale factor
+
+static const F64 crsbench_tm_parameters[][5] =
+{
+  { 500000.0, 0.0, 0.0, -117.0, 0.9996 },
+  { 200000.0, 5000000.0, 49.0, 10.3333333333333, 1.0 },
+  { 0.0, -10000000.0, -33.5, 151.0, 0.99994 },
+};
+
+// false easting, false northing, latitude of origin, central meridian, and both standard parallels
+
+static const F64 crsbench_lcc_parameters[][6] =
+{
+  { 2000000.0, 500000.0, 33.3333333333333, -96.0, 33.0, 45.0 },
+  { 600000.0, 200000.0, 46.5, 3.0, 44.0, 49.0 },
+  { 0.0, 0.0, -23.0, 135.0, -18.0, -36.0 },
+  { 1000000.0, 0.0, 40.0, -100.0, 40.0, 40.0 },
+};
+
+// EPSG code, min x, min y, max x, and max y of a real tile in the coordinate units
+// of the code. swapping x and y moves each of them out of the area of use.
+
+static const F64 crsbench_area_tiles[][5] =
+{
+  { 2157, 610000.0, 910000.0, 611000.0, 911000.0 }, // Letterkenny
+  { 2180, 775000.0, 140000.0, 776000.0, 141000.0 }, // Bieszczady
+  { 2248, 1420000.0, 590000.0, 1425000.0, 595000.0 }, // Baltimore
+  { 2991, 683000.0, 250000.0, 684000.0, 251000.0 }, // Ontario, Oregon
+  { 3034, 6700000.0, 1900000.0, 6701000.0, 1901000.0 }, // Lake Van
+  { 32148, 387000.0, 67000.0, 388000.0, 68000.0 }, // Seattle
+};
+
+#define CRSBENCH_MAX_KEYS 12
+
+class CRSbenchDirectory
+{
+public:
+  CHAR name[32];
+  U32 kind;
+  U16 number_of_keys;
+  U16 number_of_doubles;
+  LASgeokey_entry keys[CRSBENCH_MAX_KEYS];
+  F64 doubles[6];
+};
+
+static double taketime()
+{
+  return (double)(clock())/CLOCKS_PER_SEC;
+}
+
+static void usage()
+{
+  fprintf(stderr,"Usage:\n");
+  fprintf(stderr,"crsbench\n");
+  fprintf(stderr,"crsbench -repeat 100\n");
+  fprintf(stderr,"crsbench -repeat 1000 -times > times.txt\n");
+  fprintf(stderr,"crsbench -print > codes.txt\n");
+  fprintf(stderr,"crsbench -golden crs_golden.txt\n");
+  fprintf(stderr,"crsbench -compare crs_golden.txt\n");
+  fprintf(stderr,"crsbench -projected_golden crs_projected.txt\n");
+  fprintf(stderr,"crsbench -projected_compare crs_projected.txt\n");
+  fprintf(stderr,"crsbench -area\n");
+  fprintf(stderr,"crsbench -write_database lasvalidate_crs.bin\n");
+  fprintf(stderr,"crsbench -database lasvalidate_crs.bin -print > codes.txt\n");
+  fprintf(stderr,"crsbench -database lasvalidate_crs.bin -compare crs_golden.txt\n");
+  fprintf(stderr,"crsbench -h\n");
+  exit(1);
+}
+
+static void add_key(CRSbenchDirectory* directory, const U16 key_id, const U16 value)
+{
+  LASgeokey_entry* key = &(directory->keys[directory->number_of_keys++]);
+  key->key_id = key_id;
+  key->tiff_tag_location = 0;
+  key->count = 1;
+  key->value_offset = value;
+}
+
+static void add_double(CRSbenchDirectory* directory, const U16 key_id, const F64 value)
+{
+  LASgeokey_entry* key = &(directory->keys[directory->number_of_keys++]);
+  key->key_id = key_id;
+  key->tiff_tag_location = 34736; // GeoDoubleParamsTag
+  key->count = 1;
+  key->value_offset = directory->number_of_doubles;
+  directory->doubles[directory->number_of_doubles++] = value;
+}
+
+static CRSbenchDirectory* new_directory(CRSbenchDirectory** directories, U32* number_of_directories, U32* allocated_directories, const U32 kind)
+{
+  if (*number_of_directories == *allocated_directories)
+  {
+    *allocated_directories = (*allocated_directories ? 2*(*allocated_directories) : 1024);
+    *directories = (CRSbenchDirectory*)realloc(*directories, sizeof(CRSbenchDirectory)*(*allocated_directories));
+  }
+  CRSbenchDirectory* directory = &((*directories)[(*number_of_directories)++]);
+  memset(directory, 0, sizeof(CRSbenchDirectory));
+  directory->kind = kind;
+  add_key(directory, 1024, 1); // GTModelTypeGeoKey = ModelTypeProjected
+  return directory;
+}
+
+// resolves one directory the way the geokeys of a file with only these keys would be checked
+
+static BOOL resolve(CRScheck* crscheck, LASheader* lasheader, CRSbenchDirectory* directory, CHAR* description)
+{
+  lasheader->geokeys->number_of_keys = directory->number_of_keys;
+  lasheader->geokey_entries = directory->keys;
+  lasheader->geokey_double_params = directory->doubles;
+  description[0] = '\0';
+  crscheck->reset();
+  return crscheck->check_geokeys(lasheader, description);
+}
+
+// the ellipsoid and the projection that were resolved from the geokeys. the parameters
+// are printed with enough digits that any change of the arithmetic that sets them shows up.
+
+static void describe_resolved(const CRScheck* crscheck, CHAR* line)
+{
+  const CRSprojectionEllipsoid* ellipsoid = crscheck->get_ellipsoid(TRUE);
+  if (ellipsoid)
+  {
+    line += sprintf(line, " ellipsoid %d '%s' %.17g %.17g", ellipsoid->id, ellipsoid->name, ellipsoid->equatorial_radius, ellipsoid->polar_radius);
+  }
+  const CRSprojectionParameters* projection = crscheck->get_projection(TRUE);
+  if (projection)
+  {
+    if ((projection->type < 0) || (projection->type > 6))
+    {
+      sprintf(line, " projection %d", projection->type);
+    }
+    else if (projection->type == 0)
+    {
+      const CRSprojectionParametersUTM* utm = (const CRSprojectionParametersUTM*)projection;
+      sprintf(line, " projection UTM %d%c %s", utm->utm_zone_number, (((utm->utm_zone_letter >= 'A') && (utm->utm_zone_letter <= 'Z')) ? utm->utm_zone_letter : '-'), (utm->utm_northern_hemisphere ? "north" : "south"));
+    }
+    else if (projection->type == 1)
+    {
+      const CRSprojectionParametersLCC* lcc = (const CRSprojectionParametersLCC*)projection;
+      sprintf(line, " projection LCC %.17g %.17g %.17g %.17g %.17g %.17g", lcc->lcc_false_easting_meter, lcc->lcc_false_northing_meter, lcc->lcc_lat_origin_degree, lcc->lcc_long_meridian_degree, lcc->lcc_first_std_parallel_degree, lcc->lcc_second_std_parallel_degree);
+    }
+    else if (projection->type == 2)
+    {
+      const CRSprojectionParametersTM* tm = (const CRSprojectionParametersTM*)projection;
+      sprintf(line, " projection TM %.17g %.17g %.17g %.17g %.17g", tm->tm_false_easting_meter, tm->tm_false_northing_meter, tm->tm_lat_origin_degree, tm->tm_long_meridian_degree, tm->tm_scale_factor);
+    }
+    else
+    {
+      sprintf(line, " projection %s", crsbench_projection_names[projection->type]);
+    }
+  }
+}
+
+// one line with everything that was resolved
+
+static void describe(const CRScheck* crscheck, const LASheader* lasheader, const CRSbenchDirectory* directory, const BOOL resolved, const CHAR* description, CHAR* line)
+{
+  CRSidentity identity;
+  crscheck->get_identity(lasheader, &identity);
+  line += sprintf(line, "%s: %s '%.200s' horizontal %u units %u vertical %u elevation %u", directory->name, (resolved ? "resolved" : "unresolved"), description, identity.horizontal_epsg, identity.coordinate_units, identity.vertical_epsg, identity.elevation_units);
+  describe_resolved(crscheck, line);
+}
+
+// the area of use check of one tile with or without x and y swapped. it must find
+// nothing for the real tile and that the swapped one would be inside if swapped.
+
+static BOOL check_area_tile(CRScheck* crscheck, const F64* tile, const BOOL swapped)
+{
+  LASheader lasheader;
+  lasheader.x_scale_factor = 0.01;
+  lasheader.y_scale_factor = 0.01;
+  lasheader.number_of_point_records = 1;
+  lasheader.legacy_number_of_point_records = 1;
+  lasheader.min_x = tile[swapped ? 2 : 1];
+  lasheader.min_y = tile[swapped ? 1 : 2];
+  lasheader.max_x = tile[swapped ? 4 : 3];
+  lasheader.max_y = tile[swapped ? 3 : 4];
+  crscheck->check_area_of_use(&lasheader);
+  const CHAR* note = (lasheader.fail_num ? lasheader.fails[1] : "nothing");
+  BOOL success = (swapped ? (strstr(note, "would be inside with x and y swapped") != 0) : (lasheader.fail_num == 0));
+  fprintf(stderr, "%s epsg %.0f%s: %s\n", (success ? "ok  " : "FAIL"), tile[0], (swapped ? " swapped" : ""), note);
+  return success;
+}
+
+// compares with the golden output line by line and reports the first few differences
+
+static BOOL compare(FILE* file, const CHAR* const* lines, const U32 number_of_lines)
+{
+  CHAR golden[2048];
+  U32 l = 0;
+  U32 differences = 0;
+  while (fgets(golden, 2048, file))
+  {
+    U32 length = (U32)strlen(golden);
+    while (length && ((golden[length-1] == '\n') || (golden[length-1] == '\r')))
+    {
+      golden[--length] = '\0';
+    }
+    if ((l >= number_of_lines) || (strcmp(golden, lines[l]) != 0))
+    {
+      if (differences < 10)
+      {
+        fprintf(stderr, "line %u differs\n  golden: %s\n  now:    %s\n", l+1, golden, (l < number_of_lines ? lines[l] : "(nothing)"));
+      }
+      differences++;
+    }
+    l++;
+  }
+  if (l < number_of_lines)
+  {
+    if (differences < 10)
+    {
+      fprintf(stderr, "line %u differs\n  golden: (nothing)\n  now:    %s\n", l+1, lines[l]);
+    }
+    differences += number_of_lines - l;
+  }
+  if (differences)
+  {
+    fprintf(stderr, "%u of %u lines differ from the golden output\n", differences, (l > number_of_lines ? l : number_of_lines));
+    return FALSE;
+  }
+  fprintf(stderr, "all %u lines are the same as the golden output\n", number_of_lines);
+  return TRUE;
+}
+
+// writes the lines as golden output and/or compares them with the golden output
+
+static BOOL write_or_compare(const CHAR* golden_file_name, const CHAR* compare_file_name, CHAR** lines, const U32 number_of_lines)
+{
+  BOOL success = TRUE;
+  if (golden_file_name)
+  {
+    FILE* file = fopen(golden_file_name, "w");
+    if (file == 0)
+    {
+      fprintf(stderr, "ERROR: cannot open golden output '%s' for writing\n", golden_file_name);
+      success = FALSE;
+    }
+    else
+    {
+      for (U32 l = 0; l < number_of_lines; l++)
+      {
+        fprintf(file, "%s\n", lines[l]);
+      }
+      if (fclose(file) != 0)
+      {
+        fprintf(stderr, "ERROR: cannot write golden output '%s'\n", golden_file_name);
+        success = FALSE;
+      }
+      else
+      {
+        fprintf(stderr, "wrote %u lines of golden output to '%s'\n", number_of_lines, golden_file_name);
+      }
+    }
+  }
+  if (compare_file_name)
+  {
+    FILE* file = fopen(compare_file_name, "r");
+    if (file == 0)
+    {
+      fprintf(stderr, "ERROR: cannot open golden output '%s'\n", compare_file_name);
+      success = FALSE;
+    }
+    else
+    {
+      if (!compare(file, lines, number_of_lines)) success = FALSE;
+      fclose(file);
+    }
+  }
+  return success;
+}
+
+int main(int argc, char *argv[])
+{
+  int i;
+  U32 repeat = 10;
+  BOOL print = FALSE;
+  BOOL times = FALSE;
+  CHAR* golden_file_name = 0;
+  CHAR* compare_file_name = 0;
+  CHAR* projected_golden_file_name = 0;
+  CHAR* projected_compare_file_name = 0;
+  BOOL area = FALSE;
+  CHAR description[1024];
+  CHAR line[2048];
+
+  for (i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i],"-h") == 0 || strcmp(argv[i],"-help") == 0)
+    {
+      usage();
+    }
+    else if (strcmp(argv[i],"-repeat") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        fprintf(stderr,"ERROR: '%s' needs 1 argument: number of times\n", argv[i]);
+        usage();
+      }
+      i++;
+      repeat = atoi(argv[i]);
+    }
+    else if (strcmp(argv[i],"-print") == 0)
+    {
+      print = TRUE;
+    }
+    else if (strcmp(argv[i],"-times") == 0)
+    {
+      times = TRUE;
+    }
+    else if (strcmp(argv[i],"-golden") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        fprintf(stderr,"ERROR: '%s' needs 1 argument: file name\n", argv[i]);
+        usage();
+      }
+      i++;
+      golden_file_name = argv[i];
+    }
+    else if (strcmp(argv[i],"-compare") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        fprintf(stderr,"ERROR: '%s' needs 1 argument: file name\n", argv[i]);
+        usage();
+      }
+      i++;
+      compare_file_name = argv[i];
+    }
+    else if (strcmp(argv[i],"-projected_golden") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        fprintf(stderr,"ERROR: '%s' needs 1 argument: file name\n", argv[i]);
+        usage();
+      }
+      i++;
+      projected_golden_file_name = argv[i];
+    }
+    else if (strcmp(argv[i],"-projected_compare") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        fprintf(stderr,"ERROR: '%s' needs 1 argument: file name\n", argv[i]);
+        usage();
+      }
+      i++;
+      projected_compare_file_name = argv[i];
+    }
+    else if (strcmp(argv[i],"-area") == 0)
+    {
+      area = TRUE;
+    }
+    else if (strcmp(argv[i],"-write_database") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        fprintf(stderr,"ERROR: '%s' needs 1 argument: file name\n", argv[i]);
+        usage();
+      }
+      i++;
+      return (CRScheck::write_database(argv[i]) ? 0 : 1);
+    }
+    else if (strcmp(argv[i],"-database") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        fprintf(stderr,"ERROR: '%s' needs 1 argument: file name\n", argv[i]);
+        usage();
+      }
+      i++;
+      CRSdatabase::set_file_name(argv[i]);
+    }
+    else
+    {
+      fprintf(stderr,"ERROR: cannot understand argument '%s'\n", argv[i]);
+      usage();
+    }
+  }
+
+  // the keys are replaced for each directory
+
+  LASgeokeys geokeys;
+  memset(&geokeys, 0, sizeof(LASgeokeys));
+  geokeys.key_directory_version = 1;
+  geokeys.key_revision = 1;
+
+  LASheader lasheader;
+  lasheader.geokeys = &geokeys;
+
+  // one object is reused for all directories
+
+  CRScheck crscheck;
+
+  // every value of the ProjectedCSTypeGeoKey that resolves on its own
+
+  if (projected_golden_file_name || projected_compare_file_name)
+  {
+    U32 number_of_lines = 0;
+    CHAR** lines = (CHAR**)malloc(sizeof(CHAR*)*65536);
+    for (U32 value = 1; value < 65536; value++)
+    {
+      description[0] = '\0';
+      crscheck.reset();
+      if (crscheck.set_projection_from_ProjectedCSTypeGeoKey((U16)value, description))
+      {
+        CRSidentity identity;
+        crscheck.get_identity(&lasheader, &identity);
+        CHAR* end = line + sprintf(line, "projected %u: '%.200s' units %u", value, description, identity.coordinate_units);
+        describe_resolved(&crscheck, end);
+        lines[number_of_lines++] = strdup(line);
+      }
+    }
+    BOOL success = write_or_compare(projected_golden_file_name, projected_compare_file_name, lines, number_of_lines);
+    for (U32 l = 0; l < number_of_lines; l++)
+    {
+      free(lines[l]);
+    }
+    free(lines);
+    lasheader.geokeys = 0;
+    return (success ? 0 : 1);
+  }
+
+  // real tiles that must pass the area of use check and fail it with x and y swapped
+
+  if (area)
+  {
+    CRSbenchDirectory tile;
+    memset(&tile, 0, sizeof(CRSbenchDirectory));
+    add_key(&tile, 1024, 1); // GTModelTypeGeoKey = ModelTypeProjected
+    add_key(&tile, 3072, 0); // ProjectedCSTypeGeoKey
+    U32 failed = 0;
+    for (U32 t = 0; t < sizeof(crsbench_area_tiles)/sizeof(crsbench_area_tiles[0]); t++)
+    {
+      tile.keys[1].value_offset = (U16)crsbench_area_tiles[t][0];
+      if (!resolve(&crscheck, &lasheader, &tile, description))
+      {
+        fprintf(stderr, "FAIL epsg %.0f: unresolved\n", crsbench_area_tiles[t][0]);
+        failed++;
+        continue;
+      }
+      if (!check_area_tile(&crscheck, crsbench_area_tiles[t], FALSE)) failed++;
+      if (!check_area_tile(&crscheck, crsbench_area_tiles[t], TRUE)) failed++;
+    }
+    lasheader.geokeys = 0;
+    lasheader.geokey_entries = 0;
+    lasheader.geokey_double_params = 0;
+    return (failed ? 1 : 0);
+  }
+
+  U32 code, e, u, p;
+  U32 number_of_directories = 0;
+  U32 allocated_directories = 0;
+  CRSbenchDirectory* directories = 0;
+  CRSbenchDirectory* directory;
+
+  // a ProjectedCSTypeGeoKey for each supported EPSG code
+
+  CRSbenchDirectory probe;
+  memset(&probe, 0, sizeof(CRSbenchDirectory));
+  add_key(&probe, 1024, 1); // GTModelTypeGeoKey = ModelTypeProjected
+  add_key(&probe, 3072, 0); // ProjectedCSTypeGeoKey
+  for (code = 1; code < 65536; code++)
+  {
+    probe.keys[1].value_offset = (U16)code;
+    if (resolve(&crscheck, &lasheader, &probe, description))
+    {
+      directory = new_directory(&directories, &number_of_directories, &allocated_directories, CRSBENCH_EPSG);
+      sprintf(directory->name, "epsg %u", code);
+      add_key(directory, 3072, (U16)code);
+      if (print)
+      {
+        fprintf(stdout, "%u %s\n", code, description);
+      }
+    }
+  }
+
+  // a user-defined projection for each ellipsoid, units, and set of parameters
+
+  for (e = 0; e < sizeof(crsbench_ellipsoids)/sizeof(U16); e++)
+  {
+    for (u = 0; u < sizeof(crsbench_units)/sizeof(U16); u++)
+    {
+      for (p = 0; p < sizeof(crsbench_tm_parameters)/sizeof(crsbench_tm_parameters[0]); p++)
+      {
+        directory = new_directory(&directories, &number_of_directories, &allocated_directories, CRSBENCH_TM);
+        sprintf(directory->name, "tm %u %u %u", crsbench_ellipsoids[e], crsbench_units[u], p);
+        add_key(directory, 2056, crsbench_ellipsoids[e]); // GeogEllipsoidGeoKey
+        add_key(directory, 3072, 32767); // ProjectedCSTypeGeoKey = user-defined
+        add_key(directory, 3075, 1); // ProjCoordTransGeoKey = CT_TransverseMercator
+        if (crsbench_units[u]) add_key(directory, 3076, crsbench_units[u]); // ProjLinearUnitsGeoKey
+        add_double(directory, 3082, crsbench_tm_parameters[p][0]); // ProjFalseEastingGeoKey
+        add_double(directory, 3083, crsbench_tm_parameters[p][1]); // ProjFalseNorthingGeoKey
+        add_double(directory, 3081, crsbench_tm_parameters[p][2]); // ProjNatOriginLatGeoKey
+        add_double(directory, 3088, crsbench_tm_parameters[p][3]); // ProjCenterLongGeoKey
+        add_double(directory, 3092, crsbench_tm_parameters[p][4]); // ProjScaleAtNatOriginGeoKey
+      }
+      for (p = 0; p < sizeof(crsbench_lcc_parameters)/sizeof(crsbench_lcc_parameters[0]); p++)
+      {
+        directory = new_directory(&directories, &number_of_directories, &allocated_directories, CRSBENCH_LCC);
+        sprintf(directory->name, "lcc %u %u %u", crsbench_ellipsoids[e], crsbench_units[u], p);
+        add_key(directory, 2056, crsbench_ellipsoids[e]); // GeogEllipsoidGeoKey
+        add_key(directory, 3072, 32767); // ProjectedCSTypeGeoKey = user-defined
+        add_key(directory, 3075, 8); // ProjCoordTransGeoKey = CT_LambertConfConic_2SP
+        if (crsbench_units[u]) add_key(directory, 3076, crsbench_units[u]); // ProjLinearUnitsGeoKey
+        add_double(directory, 3082, crsbench_lcc_parameters[p][0]); // ProjFalseEastingGeoKey
+        add_double(directory, 3083, crsbench_lcc_parameters[p][1]); // ProjFalseNorthingGeoKey
+        add_double(directory, 3081, crsbench_lcc_parameters[p][2]); // ProjNatOriginLatGeoKey
+        add_double(directory, 3088, crsbench_lcc_parameters[p][3]); // ProjCenterLongGeoKey
+        add_double(directory, 3078, crsbench_lcc_parameters[p][4]); // ProjStdParallel1GeoKey
+        add_double(directory, 3079, crsbench_lcc_parameters[p][5]); // ProjStdParallel2GeoKey
+      }
+    }
+  }
+
+  // a VerticalCSTypeGeoKey for each supported code. the three VerticalUnitsGeoKey
+  // codes take turns so that each of them is resolved without tripling the list.
+
+  CRSidentity identity;
+  probe.number_of_keys = 1;
+  add_key(&probe, 4096, 0); // VerticalCSTypeGeoKey
+  U32 number_of_vertical_codes = 0;
+  for (code = 1; code < 65536; code++)
+  {
+    probe.keys[1].value_offset = (U16)code;
+    resolve(&crscheck, &lasheader, &probe, description);
+    crscheck.get_identity(&lasheader, &identity);
+    if (identity.vertical_epsg)
+    {
+      directory = new_directory(&directories, &number_of_directories, &allocated_directories, CRSBENCH_VERTICAL);
+      sprintf(directory->name, "vertical %u", code);
+      add_key(directory, 4096, (U16)code);
+      add_key(directory, 4099, (U16)(9001 + (number_of_vertical_codes % 3))); // VerticalUnitsGeoKey
+      number_of_vertical_codes++;
+    }
+  }
+
+  // what each directory resolves to
+
+  if (golden_file_name || compare_file_name)
+  {
+    CHAR** lines = (CHAR**)malloc(sizeof(CHAR*)*(number_of_directories ? number_of_directories : 1));
+    for (U32 d = 0; d < number_of_directories; d++)
+    {
+      BOOL resolved = resolve(&crscheck, &lasheader, &(directories[d]), description);
+      describe(&crscheck, &lasheader, &(directories[d]), resolved, description, line);
+      lines[d] = strdup(line);
+    }
+    BOOL success = write_or_compare(golden_file_name, compare_file_name, lines, number_of_directories);
+    for (U32 d = 0; d < number_of_directories; d++)
+    {
+      free(lines[d]);
+    }
+    free(lines);
+    if (!success)
+    {
+      free(directories);
+      lasheader.geokeys = 0;
+      lasheader.geokey_entries = 0;
+      lasheader.geokey_double_params = 0;
+      return 1;
+    }
+  }
+
+  // time resolving each kind of directory
+
+  U32 r, d, k;
+  F64 start_time, seconds;
+  for (k = 0; k < CRSBENCH_KINDS; k++)
+  {
+    U32 number = 0;
+    start_time = taketime();
+    for (r = 0; r < repeat; r++)
+    {
+      for (d = 0; d < number_of_directories; d++)
+      {
+        if (directories[d].kind == k)
+        {
+          resolve(&crscheck, &lasheader, &(directories[d]), description);
+          if (r == 0) number++;
+        }
+      }
+    }
+    seconds = taketime() - start_time;
+    fprintf(stderr, "resolved %u %s %u times in %.3f sec (%.0f ns per directory)\n", number, crsbench_kind_names[k], repeat, seconds, (number && repeat ? 1.0e9*seconds/((F64)number*repeat) : 0.0));
+  }
+
+  // and each directory on its own
+
+  if (times)
+  {
+    for (d = 0; d < number_of_directories; d++)
+    {
+      start_time = taketime();
+      for (r = 0; r < repeat; r++)
+      {
+        resolve(&crscheck, &lasheader, &(directories[d]), description);
+      }
+      seconds = taketime() - start_time;
+      fprintf(stdout, "%s %.0f ns\n", directories[d].name, (repeat ? 1.0e9*seconds/repeat : 0.0));
+    }
+  }
+
+  free(directories);
+  lasheader.geokeys = 0;
+  lasheader.geokey_entries = 0;
+  lasheader.geokey_double_params = 0;
+  return 0;
+}
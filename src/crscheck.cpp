@@ -30,10 +30,22 @@
 */
 
 #include <time.h>
+#include <stdlib.h>
 #include <string.h>
 #include <math.h>
 
+#include <new>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
 #include "crscheck.hpp"
+#include "crsdatabase.hpp"
+#include "crswkt.hpp"
 
 static const F64 PI = 3.141592653589793238462643383279502884197169;
 static const F64 TWO_PI = PI * 2;
@@ -685,6 +697,264 @@ static const StatePlaneTM state_plane_tm_nad83_list[] =
   StatePlaneTM(0,0,-1,-1,-1,-1,-1)
 };
 
+// one index over the four state plane lists keyed by list and zone name and
+// by geokey. it is a perfect hash that is built once when the program starts:
+// the keys are spread over buckets and each bucket gets the displacement that
+// sends all of its keys to free slots, so every look-up probes a single slot.
+// if no displacement is found the look-ups fall back to scanning the lists.
+
+#define CRS_STATE_PLANE_LCC_NAD27 0
+#define CRS_STATE_PLANE_LCC_NAD83 1
+#define CRS_STATE_PLANE_TM_NAD27  2
+#define CRS_STATE_PLANE_TM_NAD83  3
+
+#define CRS_STATE_PLANE_SLOTS   1024
+#define CRS_STATE_PLANE_BUCKETS 256
+
+static U32 state_plane_hash(const U32 key, const U32 displacement)
+{
+  U32 h = key ^ (displacement * 0x9E3779B9);
+  h ^= h >> 16;
+  h *= 0x85EBCA6B;
+  h ^= h >> 13;
+  h *= 0xC2B2AE35;
+  h ^= h >> 16;
+  return h;
+}
+
+static U32 state_plane_name_key(const U32 list, const CHAR* zone)
+{
+  U32 h = 2166136261u;
+  while (*zone)
+  {
+    h ^= (U8)(*zone);
+    h *= 16777619u;
+    zone++;
+  }
+  h ^= list;
+  h *= 16777619u;
+  return h;
+}
+
+static U32 state_plane_geokey_key(const U32 geokey)
+{
+  return state_plane_hash(geokey, 0xFFFFFFFF);
+}
+
+class StatePlaneSlot
+{
+public:
+  U32 key;
+  I16 list;
+  I16 index;
+  BOOL by_geokey;
+};
+
+class StatePlaneIndex
+{
+public:
+  StatePlaneIndex();
+  I32 find(const U32 list, const CHAR* zone) const;
+  I32 find(const U16 geokey, U32* list) const;
+private:
+  BOOL built;
+  U32 displacements[CRS_STATE_PLANE_BUCKETS];
+  StatePlaneSlot slots[CRS_STATE_PLANE_SLOTS];
+  const StatePlaneSlot* probe(const U32 key) const;
+};
+
+static const CHAR* state_plane_zone(const U32 list, const I32 index)
+{
+  switch (list)
+  {
+  case CRS_STATE_PLANE_LCC_NAD27:
+    return state_plane_lcc_nad27_list[index].zone;
+  case CRS_STATE_PLANE_LCC_NAD83:
+    return state_plane_lcc_nad83_list[index].zone;
+  case CRS_STATE_PLANE_TM_NAD27:
+    return state_plane_tm_nad27_list[index].zone;
+  }
+  return state_plane_tm_nad83_list[index].zone;
+}
+
+static U16 state_plane_geokey(const U32 list, const I32 index)
+{
+  switch (list)
+  {
+  case CRS_STATE_PLANE_LCC_NAD27:
+    return (U16)state_plane_lcc_nad27_list[index].geokey;
+  case CRS_STATE_PLANE_LCC_NAD83:
+    return (U16)state_plane_lcc_nad83_list[index].geokey;
+  case CRS_STATE_PLANE_TM_NAD27:
+    return (U16)state_plane_tm_nad27_list[index].geokey;
+  }
+  return (U16)state_plane_tm_nad83_list[index].geokey;
+}
+
+StatePlaneIndex::StatePlaneIndex()
+{
+  U32 i, j, list;
+  StatePlaneSlot keys[CRS_STATE_PLANE_SLOTS/2];
+  U32 number_of_keys = 0;
+
+  built = FALSE;
+  memset(displacements, 0, sizeof(displacements));
+  memset(slots, 0, sizeof(slots));
+  for (i = 0; i < CRS_STATE_PLANE_SLOTS; i++)
+  {
+    slots[i].list = -1;
+  }
+
+  // every zone once by name and once by geokey
+
+  for (list = 0; list < 4; list++)
+  {
+    for (i = 0; state_plane_zone(list, i); i++)
+    {
+      if (number_of_keys + 2 > CRS_STATE_PLANE_SLOTS/2)
+      {
+        return;
+      }
+      keys[number_of_keys].key = state_plane_name_key(list, state_plane_zone(list, i));
+      keys[number_of_keys].list = (I16)list;
+      keys[number_of_keys].index = (I16)i;
+      keys[number_of_keys].by_geokey = FALSE;
+      number_of_keys++;
+      keys[number_of_keys].key = state_plane_geokey_key(state_plane_geokey(list, i));
+      keys[number_of_keys].list = (I16)list;
+      keys[number_of_keys].index = (I16)i;
+      keys[number_of_keys].by_geokey = TRUE;
+      number_of_keys++;
+    }
+  }
+
+  // place the buckets with more keys first while there are many free slots
+
+  U32 bucket_sizes[CRS_STATE_PLANE_BUCKETS];
+  memset(bucket_sizes, 0, sizeof(bucket_sizes));
+  for (i = 0; i < number_of_keys; i++)
+  {
+    bucket_sizes[state_plane_hash(keys[i].key, 0) & (CRS_STATE_PLANE_BUCKETS-1)]++;
+  }
+  U32 size, placed = 0;
+  for (size = number_of_keys; size > 0; size--)
+  {
+    for (U32 bucket = 0; bucket < CRS_STATE_PLANE_BUCKETS; bucket++)
+    {
+      if (bucket_sizes[bucket] != size)
+      {
+        continue;
+      }
+      U32 displacement;
+      U32 bucket_slots[CRS_STATE_PLANE_SLOTS/2];
+      for (displacement = 1; displacement < 65536; displacement++)
+      {
+        U32 n = 0;
+        for (i = 0; i < number_of_keys; i++)
+        {
+          if ((state_plane_hash(keys[i].key, 0) & (CRS_STATE_PLANE_BUCKETS-1)) != bucket)
+          {
+            continue;
+          }
+          U32 slot = state_plane_hash(keys[i].key, displacement) & (CRS_STATE_PLANE_SLOTS-1);
+          if (slots[slot].list != -1)
+          {
+            break;
+          }
+          for (j = 0; j < n; j++)
+          {
+            if ((bucket_slots[j] & 0xFFFF) == slot)
+            {
+              break;
+            }
+          }
+          if (j < n)
+          {
+            break;
+          }
+          bucket_slots[n++] = slot | (i << 16);
+        }
+        if (i == number_of_keys)
+        {
+          break;
+        }
+      }
+      if (displacement == 65536)
+      {
+        return;
+      }
+      displacements[bucket] = displacement;
+      for (j = 0; j < size; j++)
+      {
+        slots[bucket_slots[j] & 0xFFFF] = keys[bucket_slots[j] >> 16];
+      }
+      placed += size;
+    }
+  }
+  built = (placed == number_of_keys);
+}
+
+const StatePlaneSlot* StatePlaneIndex::probe(const U32 key) const
+{
+  U32 displacement = displacements[state_plane_hash(key, 0) & (CRS_STATE_PLANE_BUCKETS-1)];
+  const StatePlaneSlot* slot = &(slots[state_plane_hash(key, displacement) & (CRS_STATE_PLANE_SLOTS-1)]);
+  if ((slot->list == -1) || (slot->key != key))
+  {
+    return 0;
+  }
+  return slot;
+}
+
+I32 StatePlaneIndex::find(const U32 list, const CHAR* zone) const
+{
+  I32 i;
+  if (built)
+  {
+    const StatePlaneSlot* slot = probe(state_plane_name_key(list, zone));
+    if (slot && !slot->by_geokey && ((U32)slot->list == list) && (strcmp(zone, state_plane_zone(list, slot->index)) == 0))
+    {
+      return slot->index;
+    }
+    return -1;
+  }
+  for (i = 0; state_plane_zone(list, i); i++)
+  {
+    if (strcmp(zone, state_plane_zone(list, i)) == 0)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+I32 StatePlaneIndex::find(const U16 geokey, U32* list) const
+{
+  I32 i;
+  if (built)
+  {
+    const StatePlaneSlot* slot = probe(state_plane_geokey_key(geokey));
+    if (slot && slot->by_geokey && (state_plane_geokey(slot->list, slot->index) == geokey))
+    {
+      *list = slot->list;
+      return slot->index;
+    }
+    return -1;
+  }
+  for (*list = 0; *list < 4; (*list)++)
+  {
+    for (i = 0; state_plane_zone(*list, i); i++)
+    {
+      if (state_plane_geokey(*list, i) == geokey)
+      {
+        return i;
+      }
+    }
+  }
+  return -1;
+}
+
+static const StatePlaneIndex state_plane_index;
+
 static I32 lidardouble2string(CHAR* string, F64 value)
 {
   I32 len;
@@ -753,61 +1023,51 @@ void CRScheck::set_coordinates_in_meter(const BOOL from_geokeys)
 void CRScheck::set_elevation_in_survey_feet(const BOOL from_geokeys)
 {
   if (from_geokeys)
-    coordinate_units[0] = 3;
+    elevation_units[0] = 3;
   else
-    coordinate_units[1] = 3;
+    elevation_units[1] = 3;
 }
 
 void CRScheck::set_elevation_in_feet(const BOOL from_geokeys)
 {
   if (from_geokeys)
-    coordinate_units[0] = 2;
+    elevation_units[0] = 2;
   else
-    coordinate_units[1] = 2;
+    elevation_units[1] = 2;
 }
 
 void CRScheck::set_elevation_in_meter(const BOOL from_geokeys)
 {
   if (from_geokeys)
-    coordinate_units[0] = 1;
+    elevation_units[0] = 1;
   else
-    coordinate_units[1] = 1;
+    elevation_units[1] = 1;
 }
 
-BOOL CRScheck::set_ellipsoid(const I32 ellipsoid_id, const BOOL from_geokeys, char* description)
+static void fill_ellipsoid(CRSprojectionEllipsoid* ellipsoid, const I32 ellipsoid_id)
 {
-  if ((ellipsoid_id <= 0) || (ellipsoid_id >= 25))
-  {
-    return FALSE;
-  }
-
-  CRSprojectionEllipsoid* ellipsoid;
-
-  if (from_geokeys)
-  {
-    if (ellipsoids[0] == 0)
-    {
-      ellipsoids[0] = new CRSprojectionEllipsoid();
-    }
-    ellipsoid = ellipsoids[0];
-  }
-  else
-  {
-    if (ellipsoids[1] == 0)
-    {
-      ellipsoids[1] = new CRSprojectionEllipsoid();
-    }
-    ellipsoid = ellipsoids[1];
-  }
-
   ellipsoid->id = ellipsoid_id;
   ellipsoid->name = ellipsoid_list[ellipsoid_id].name;
   ellipsoid->equatorial_radius = ellipsoid_list[ellipsoid_id].equatorialRadius;
   ellipsoid->eccentricity_squared = ellipsoid_list[ellipsoid_id].eccentricitySquared;
+  ellipsoid->inverse_flattening = ellipsoid_list[ellipsoid_id].inverseFlattening;
   ellipsoid->eccentricity_prime_squared = (ellipsoid->eccentricity_squared)/(1-ellipsoid->eccentricity_squared);
   ellipsoid->polar_radius = ellipsoid->equatorial_radius*sqrt(1-ellipsoid->eccentricity_squared);    
   ellipsoid->eccentricity = sqrt(ellipsoid->eccentricity_squared);
   ellipsoid->eccentricity_e1 = (1-sqrt(1-ellipsoid->eccentricity_squared))/(1+sqrt(1-ellipsoid->eccentricity_squared));
+}
+
+BOOL CRScheck::set_ellipsoid(const I32 ellipsoid_id, const BOOL from_geokeys, char* description)
+{
+  if ((ellipsoid_id <= 0) || (ellipsoid_id >= 25))
+  {
+    return FALSE;
+  }
+
+  U32 slot = (from_geokeys ? 0 : 1);
+  CRSprojectionEllipsoid* ellipsoid = &(ellipsoid_storage[slot]);
+  fill_ellipsoid(ellipsoid, ellipsoid_id);
+  ellipsoids[slot] = ellipsoid;
 
   if (description)
   {
@@ -817,26 +1077,38 @@ BOOL CRScheck::set_ellipsoid(const I32 ellipsoid_id, const BOOL from_geokeys, ch
   return TRUE;
 }
 
-void CRScheck::set_projection(CRSprojectionParameters* projection, const BOOL from_geokeys)
+// the projection of a slot is constructed in its inline storage and replaces
+// whatever projection was there before
+
+CRSprojectionParameters* CRScheck::init_projection(const I32 type, const BOOL from_geokeys)
 {
-  if (from_geokeys)
+  U32 slot = (from_geokeys ? 0 : 1);
+  CRSprojectionParameters* projection;
+  if (type == CRS_PROJECTION_UTM)
+  {
+    projection = new (projection_storage[slot].bytes) CRSprojectionParametersUTM();
+  }
+  else if (type == CRS_PROJECTION_LCC)
+  {
+    projection = new (projection_storage[slot].bytes) CRSprojectionParametersLCC();
+  }
+  else if (type == CRS_PROJECTION_TM)
   {
-    if (projections[0]) delete projections[0];
-    projections[0] = projection;
+    projection = new (projection_storage[slot].bytes) CRSprojectionParametersTM();
   }
   else
   {
-    if (projections[1]) delete projections[1];
-    projections[1] = projection;
+    projection = new (projection_storage[slot].bytes) CRSprojectionParameters();
   }
+  projection->type = type;
+  projections[slot] = projection;
+  return projection;
 }
 
 BOOL CRScheck::set_no_projection(const BOOL from_geokeys, CHAR* description)
 {
-  CRSprojectionParameters* no = new CRSprojectionParameters();
-  no->type = CRS_PROJECTION_NONE;
+  CRSprojectionParameters* no = init_projection(CRS_PROJECTION_NONE, from_geokeys);
   sprintf(no->name, "intentionally no projection");
-  set_projection(no, from_geokeys);
   if (description)
   {
     sprintf(description, "%s", no->name);
@@ -846,10 +1118,8 @@ BOOL CRScheck::set_no_projection(const BOOL from_geokeys, CHAR* description)
 
 BOOL CRScheck::set_latlong_projection(const BOOL from_geokeys, CHAR* description)
 {
-  CRSprojectionParameters* latlong = new CRSprojectionParameters();
-  latlong->type = CRS_PROJECTION_LAT_LONG;
+  CRSprojectionParameters* latlong = init_projection(CRS_PROJECTION_LAT_LONG, from_geokeys);
   sprintf(latlong->name, "latitude/longitude");
-  set_projection(latlong, from_geokeys);
   if (description)
   {
     sprintf(description, "%s", latlong->name);
@@ -859,10 +1129,8 @@ BOOL CRScheck::set_latlong_projection(const BOOL from_geokeys, CHAR* description
 
 BOOL CRScheck::set_longlat_projection(const BOOL from_geokeys, CHAR* description)
 {
-  CRSprojectionParameters* longlat = new CRSprojectionParameters();
-  longlat->type = CRS_PROJECTION_LONG_LAT;
+  CRSprojectionParameters* longlat = init_projection(CRS_PROJECTION_LONG_LAT, from_geokeys);
   sprintf(longlat->name, "longitude/latitude");
-  set_projection(longlat, from_geokeys);
   if (description)
   {
     sprintf(description, "%s", longlat->name);
@@ -872,10 +1140,8 @@ BOOL CRScheck::set_longlat_projection(const BOOL from_geokeys, CHAR* description
 
 BOOL CRScheck::set_ecef_projection(const BOOL from_geokeys, CHAR* description)
 {
-  CRSprojectionParameters* ecef = new CRSprojectionParameters();
-  ecef->type = CRS_PROJECTION_ECEF;
+  CRSprojectionParameters* ecef = init_projection(CRS_PROJECTION_ECEF, from_geokeys);
   sprintf(ecef->name, "ECEF");
-  set_projection(ecef, from_geokeys);
   if (description)
   {
     sprintf(description, "%s", ecef->name);
@@ -896,8 +1162,7 @@ BOOL CRScheck::set_utm_projection(const CHAR* zone, const BOOL from_geokeys, CHA
   {
     return FALSE;
   }
-  CRSprojectionParametersUTM* utm = new CRSprojectionParametersUTM();
-  utm->type = CRS_PROJECTION_UTM;
+  CRSprojectionParametersUTM* utm = (CRSprojectionParametersUTM*)init_projection(CRS_PROJECTION_UTM, from_geokeys);
   utm->utm_zone_number = zone_number;
   utm->utm_zone_letter = *zone_letter;
   if((*zone_letter - 'N') >= 0)
@@ -910,7 +1175,6 @@ BOOL CRScheck::set_utm_projection(const CHAR* zone, const BOOL from_geokeys, CHA
   }
   sprintf(utm->name, "UTM zone %s (%s)", zone, (utm->utm_northern_hemisphere ? "northern hemisphere" : "southern hemisphere"));
   utm->utm_long_origin = (zone_number - 1) * 6 - 180 + 3; // + 3 puts origin in middle of zone
-  set_projection(utm, from_geokeys);
   if (description)
   {
     sprintf(description, "UTM %d %s", zone_number, (utm->utm_northern_hemisphere ? "northern hemisphere" : "southern hemisphere"));
@@ -924,14 +1188,12 @@ BOOL CRScheck::set_utm_projection(const I32 zone_number, const BOOL northern, co
   {
     return FALSE;
   }
-  CRSprojectionParametersUTM* utm = new CRSprojectionParametersUTM();
-  utm->type = CRS_PROJECTION_UTM;
+  CRSprojectionParametersUTM* utm = (CRSprojectionParametersUTM*)init_projection(CRS_PROJECTION_UTM, from_geokeys);
   utm->utm_zone_number = zone_number;
   utm->utm_zone_letter = ' ';
   utm->utm_northern_hemisphere = northern;
   sprintf(utm->name, "UTM zone %d (%s)", zone_number, (utm->utm_northern_hemisphere ? "northern hemisphere" : "southern hemisphere"));
   utm->utm_long_origin = (zone_number - 1) * 6 - 180 + 3;  // + 3 puts origin in middle of zone
-  set_projection(utm, from_geokeys);
   if (description)
   {
     sprintf(description, "UTM %d %s", zone_number, (utm->utm_northern_hemisphere ? "northern hemisphere" : "southern hemisphere"));
@@ -945,14 +1207,12 @@ BOOL CRScheck::set_mga_projection(const I32 zone_number, const BOOL northern, co
   {
     return FALSE;
   }
-  CRSprojectionParametersUTM* utm = new CRSprojectionParametersUTM();
-  utm->type = CRS_PROJECTION_UTM;
+  CRSprojectionParametersUTM* utm = (CRSprojectionParametersUTM*)init_projection(CRS_PROJECTION_UTM, from_geokeys);
   utm->utm_zone_number = zone_number;
   utm->utm_zone_letter = ' ';
   utm->utm_northern_hemisphere = northern;
   sprintf(utm->name, "MGA zone %d (%s)", zone_number, (utm->utm_northern_hemisphere ? "northern hemisphere" : "southern hemisphere"));
   utm->utm_long_origin = (zone_number - 1) * 6 - 180 + 3;  // + 3 puts origin in middle of zone
-  set_projection(utm, from_geokeys);
   if (description)
   {
     sprintf(description, "MGA %d %s", zone_number, (utm->utm_northern_hemisphere ? "northern hemisphere" : "southern hemisphere"));
@@ -978,8 +1238,7 @@ BOOL CRScheck::set_mga_projection(const I32 zone_number, const BOOL northern, co
 // where the "cone" intersects the earth. They bracket the area being projected.
 void CRScheck::set_lambert_conformal_conic_projection(const F64 falseEasting, const F64 falseNorthing, const F64 latOriginDegree, const F64 longMeridianDegree, const F64 firstStdParallelDegree, const F64 secondStdParallelDegree, const BOOL from_geokeys, CHAR* description)
 {
-  CRSprojectionParametersLCC* lcc = new CRSprojectionParametersLCC();
-  lcc->type = CRS_PROJECTION_LCC;
+  CRSprojectionParametersLCC* lcc = (CRSprojectionParametersLCC*)init_projection(CRS_PROJECTION_LCC, from_geokeys);
   sprintf(lcc->name, "Lambert Conformal Conic");
   lcc->lcc_false_easting_meter = falseEasting;
   lcc->lcc_false_northing_meter = falseNorthing;
@@ -991,7 +1250,6 @@ void CRScheck::set_lambert_conformal_conic_projection(const F64 falseEasting, co
   lcc->lcc_long_meridian_radian = deg2rad*lcc->lcc_long_meridian_degree;
   lcc->lcc_first_std_parallel_radian = deg2rad*lcc->lcc_first_std_parallel_degree;
   lcc->lcc_second_std_parallel_radian = deg2rad*lcc->lcc_second_std_parallel_degree;
-  set_projection(lcc, from_geokeys);
   if (description)
   {
     sprintf(description, "false east/north: %g/%g [m], origin lat/ meridian long: %g/%g, parallel 1st/2nd: %g/%g", lcc->lcc_false_easting_meter, lcc->lcc_false_northing_meter, lcc->lcc_lat_origin_degree, lcc->lcc_long_meridian_degree, lcc->lcc_first_std_parallel_degree, lcc->lcc_second_std_parallel_degree);
@@ -1010,8 +1268,7 @@ void CRScheck::set_lambert_conformal_conic_projection(const F64 falseEasting, co
 */
 void CRScheck::set_transverse_mercator_projection(const F64 falseEasting, const F64 falseNorthing, const F64 latOriginDegree, const F64 longMeridianDegree, const F64 scaleFactor, const BOOL from_geokeys, CHAR* description)
 {
-  CRSprojectionParametersTM* tm = new CRSprojectionParametersTM();
-  tm->type = CRS_PROJECTION_TM;
+  CRSprojectionParametersTM* tm = (CRSprojectionParametersTM*)init_projection(CRS_PROJECTION_TM, from_geokeys);
   sprintf(tm->name, "Transverse Mercator");
   tm->tm_false_easting_meter = falseEasting;
   tm->tm_false_northing_meter = falseNorthing;
@@ -1020,7 +1277,6 @@ void CRScheck::set_transverse_mercator_projection(const F64 falseEasting, const
   tm->tm_scale_factor = scaleFactor;
   tm->tm_lat_origin_radian = deg2rad*tm->tm_lat_origin_degree;
   tm->tm_long_meridian_radian = deg2rad*tm->tm_long_meridian_degree;
-  set_projection(tm, from_geokeys);
   if (description)
   {
     sprintf(description, "false east/north: %g/%g [m], origin lat/meridian long: %g/%g, scale: %g", tm->tm_false_easting_meter, tm->tm_false_northing_meter, tm->tm_lat_origin_degree, tm->tm_long_meridian_degree, tm->tm_scale_factor);
@@ -1029,97 +1285,85 @@ void CRScheck::set_transverse_mercator_projection(const F64 falseEasting, const
 
 BOOL CRScheck::set_state_plane_nad27_lcc(const CHAR* zone, const BOOL from_geokeys, CHAR* description)
 {
-  I32 i = 0;
-  while (state_plane_lcc_nad27_list[i].zone)
+  I32 i = state_plane_index.find(CRS_STATE_PLANE_LCC_NAD27, zone);
+  if (i == -1)
   {
-    if (strcmp(zone, state_plane_lcc_nad27_list[i].zone) == 0)
-    {
-      set_ellipsoid(CRS_ELLIPSOID_NAD27, from_geokeys);
-      set_lambert_conformal_conic_projection(state_plane_lcc_nad27_list[i].falseEasting, state_plane_lcc_nad27_list[i].falseNorthing, state_plane_lcc_nad27_list[i].latOriginDegree, state_plane_lcc_nad27_list[i].longMeridianDegree, state_plane_lcc_nad27_list[i].firstStdParallelDegree, state_plane_lcc_nad27_list[i].secondStdParallelDegree, from_geokeys);
-      if (description)
-      {
-        sprintf(description, "stateplane27 %s", state_plane_lcc_nad27_list[i].zone);
-      }
-      return TRUE;
-    }
-    i++;
+    return FALSE;
   }
-  return FALSE;
+  const StatePlaneLCC* state_plane = &(state_plane_lcc_nad27_list[i]);
+  set_ellipsoid(CRS_ELLIPSOID_NAD27, from_geokeys);
+  set_lambert_conformal_conic_projection(state_plane->falseEasting, state_plane->falseNorthing, state_plane->latOriginDegree, state_plane->longMeridianDegree, state_plane->firstStdParallelDegree, state_plane->secondStdParallelDegree, from_geokeys);
+  if (description)
+  {
+    sprintf(description, "stateplane27 %s", state_plane->zone);
+  }
+  return TRUE;
 }
 
 BOOL CRScheck::set_state_plane_nad83_lcc(const CHAR* zone, const BOOL from_geokeys, CHAR* description)
 {
-  I32 i = 0;
-  while (state_plane_lcc_nad83_list[i].zone)
+  I32 i = state_plane_index.find(CRS_STATE_PLANE_LCC_NAD83, zone);
+  if (i == -1)
   {
-    if (strcmp(zone, state_plane_lcc_nad83_list[i].zone) == 0)
-    {
-      set_ellipsoid(CRS_ELLIPSOID_NAD83, from_geokeys);
-      set_lambert_conformal_conic_projection(state_plane_lcc_nad83_list[i].falseEasting, state_plane_lcc_nad83_list[i].falseNorthing, state_plane_lcc_nad83_list[i].latOriginDegree, state_plane_lcc_nad83_list[i].longMeridianDegree, state_plane_lcc_nad83_list[i].firstStdParallelDegree, state_plane_lcc_nad83_list[i].secondStdParallelDegree, from_geokeys);
-      if (description)
-      {
-        sprintf(description, "stateplane83 %s", state_plane_lcc_nad83_list[i].zone);
-      }
-      return TRUE;
-    }
-    i++;
+    return FALSE;
   }
-  return FALSE;
+  const StatePlaneLCC* state_plane = &(state_plane_lcc_nad83_list[i]);
+  set_ellipsoid(CRS_ELLIPSOID_NAD83, from_geokeys);
+  set_lambert_conformal_conic_projection(state_plane->falseEasting, state_plane->falseNorthing, state_plane->latOriginDegree, state_plane->longMeridianDegree, state_plane->firstStdParallelDegree, state_plane->secondStdParallelDegree, from_geokeys);
+  if (description)
+  {
+    sprintf(description, "stateplane83 %s", state_plane->zone);
+  }
+  return TRUE;
 }
 
 BOOL CRScheck::set_state_plane_nad27_tm(const CHAR* zone, const BOOL from_geokeys, CHAR* description)
 {
-  I32 i = 0;
-  while (state_plane_tm_nad27_list[i].zone)
+  I32 i = state_plane_index.find(CRS_STATE_PLANE_TM_NAD27, zone);
+  if (i == -1)
   {
-    if (strcmp(zone, state_plane_tm_nad27_list[i].zone) == 0)
-    {
-      set_ellipsoid(CRS_ELLIPSOID_NAD27, from_geokeys);
-      set_transverse_mercator_projection(state_plane_tm_nad27_list[i].falseEasting, state_plane_tm_nad27_list[i].falseNorthing, state_plane_tm_nad27_list[i].latOriginDegree, state_plane_tm_nad27_list[i].longMeridianDegree, state_plane_tm_nad27_list[i].scaleFactor, from_geokeys);
-      if (description)
-      {
-        sprintf(description, "stateplane27 %s", state_plane_tm_nad27_list[i].zone);
-      }
-      return TRUE;
-    }
-    i++;
+    return FALSE;
   }
-  return FALSE;
+  const StatePlaneTM* state_plane = &(state_plane_tm_nad27_list[i]);
+  set_ellipsoid(CRS_ELLIPSOID_NAD27, from_geokeys);
+  set_transverse_mercator_projection(state_plane->falseEasting, state_plane->falseNorthing, state_plane->latOriginDegree, state_plane->longMeridianDegree, state_plane->scaleFactor, from_geokeys);
+  if (description)
+  {
+    sprintf(description, "stateplane27 %s", state_plane->zone);
+  }
+  return TRUE;
 }
 
 BOOL CRScheck::set_state_plane_nad83_tm(const CHAR* zone, const BOOL from_geokeys, CHAR* description)
 {
-  I32 i = 0;
-  while (state_plane_tm_nad83_list[i].zone)
+  I32 i = state_plane_index.find(CRS_STATE_PLANE_TM_NAD83, zone);
+  if (i == -1)
   {
-    if (strcmp(zone, state_plane_tm_nad83_list[i].zone) == 0)
-    {
-      set_ellipsoid(CRS_ELLIPSOID_NAD83, from_geokeys);
-      set_transverse_mercator_projection(state_plane_tm_nad83_list[i].falseEasting, state_plane_tm_nad83_list[i].falseNorthing, state_plane_tm_nad83_list[i].latOriginDegree, state_plane_tm_nad83_list[i].longMeridianDegree, state_plane_tm_nad83_list[i].scaleFactor, from_geokeys);
-      if (description)
-      {
-        sprintf(description, "stateplane83 %s", state_plane_tm_nad83_list[i].zone);
-      }
-      return TRUE;
-    }
-    i++;
+    return FALSE;
   }
-  return FALSE;
+  const StatePlaneTM* state_plane = &(state_plane_tm_nad83_list[i]);
+  set_ellipsoid(CRS_ELLIPSOID_NAD83, from_geokeys);
+  set_transverse_mercator_projection(state_plane->falseEasting, state_plane->falseNorthing, state_plane->latOriginDegree, state_plane->longMeridianDegree, state_plane->scaleFactor, from_geokeys);
+  if (description)
+  {
+    sprintf(description, "stateplane83 %s", state_plane->zone);
+  }
+  return TRUE;
 }
 
 BOOL CRScheck::set_vertical_from_VerticalCSTypeGeoKey(U16 value)
 {
   if ((5000 <= value) && (value <= 5099))      // [5000, 5099] = EPSG Ellipsoid Vertical CS Codes
   {
-    vertical_epsg[1] = value;
+    vertical_epsg[0] = value;
   }
   else if ((5101 <= value) && (value <= 5199)) // [5100, 5199] = EPSG Orthometric Vertical CS Codes
   {
-    vertical_epsg[1] = value;
+    vertical_epsg[0] = value;
   }
   else if ((5200 <= value) && (value <= 5999)) // [5200, 5999] = Reserved EPSG
   {
-    vertical_epsg[1] = value;
+    vertical_epsg[0] = value;
   }
   else
   {
@@ -1237,7 +1481,8 @@ static const short EPSG_ETRS89_UTM33_north_zE_N = 5650;
 static const short EPSG_OSGB_1936 = 27700;
 static const short EPSG_Belgian_Lambert_1972 = 31370;
 
-// simple name look-up for all EPSG codes (without resolving of projection)
+// simple name look-up for all EPSG codes (without resolving of projection).
+// the codes must stay sorted for the binary search in get_epsg_table_description()
 
 static const short epsg_codes[] =
 {
@@ -12301,2188 +12546,2492 @@ static const char * epsg_descriptions[] =
 NULL
 };
 
+static const I32 epsg_named_number = sizeof(epsg_codes) / sizeof(short) - 1;
 
-BOOL CRScheck::set_projection_from_ProjectedCSTypeGeoKey(const U16 value, CHAR* description)
+static const CHAR* get_epsg_table_description(const U16 code)
+{
+  I32 lo = 0;
+  I32 hi = epsg_named_number - 1;
+  while (lo <= hi)
+  {
+    I32 mid = (lo + hi) / 2;
+    if ((I32)code < epsg_codes[mid])
+    {
+      hi = mid - 1;
+    }
+    else if ((I32)code > epsg_codes[mid])
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      return epsg_descriptions[mid];
+    }
+  }
+  return 0;
+}
+
+const CHAR* CRScheck::get_epsg_description(const U16 code)
+{
+  const CHAR* name = CRSdatabase::find_name(code);
+  if (name)
+  {
+    return name;
+  }
+  return get_epsg_table_description(code);
+}
+
+// the projected CRS that the ProjectedCSTypeGeoKey resolves by zone. each
+// entry is a range of codes whose UTM or MGA zone counts up from the zone of
+// its first code, or a single code of a state plane zone. sorted by code for
+// a binary search.
+
+static const int CRS_EPSG_UTM  = 0;
+static const int CRS_EPSG_MGA  = 1;
+static const int CRS_EPSG_SP27 = 2;
+static const int CRS_EPSG_SP83 = 3;
+
+class CRSepsgZone
+{
+public:
+  U16 first;
+  U16 last;
+  U8 kind;
+  U8 zone;
+  BOOL northern;
+  I16 ellipsoid_id;
+  const CHAR* sp;
+};
+
+static const CRSepsgZone epsg_zone_list[] =
+{
+  {3154, 3157, CRS_EPSG_UTM, 7, TRUE, CRS_ELLIPSOID_NAD83, 0}, // NAD83(CSRS) / UTM zone 7N to 10N
+  {3158, 3160, CRS_EPSG_UTM, 14, TRUE, CRS_ELLIPSOID_NAD83, 0}, // NAD83(CSRS) / UTM zone 14N to 16N
+  {20137, 20138, CRS_EPSG_UTM, 37, TRUE, -1, 0}, // PCS_Adindan_UTM_zone_37N to 38N
+  {20437, 20439, CRS_EPSG_UTM, 37, TRUE, -1, 0}, // PCS_Ain_el_Abd_UTM_zone_37N to 39N
+  {20538, 20539, CRS_EPSG_UTM, 38, TRUE, -1, 0}, // PCS_Afgooye_UTM_zone_38N to 39N
+  {20822, 20824, CRS_EPSG_UTM, 22, FALSE, -1, 0}, // PCS_Aratu_UTM_zone_22S to 24S
+  {21148, 21150, CRS_EPSG_UTM, 48, FALSE, -1, 0}, // PCS_Batavia_UTM_zone_48S to 50S
+  {21817, 21818, CRS_EPSG_UTM, 17, TRUE, -1, 0}, // PCS_Bogota_UTM_zone_17N to 18N
+  {22032, 22033, CRS_EPSG_UTM, 32, FALSE, -1, 0}, // PCS_Camacupa_UTM_32S to 33S
+  {22332, 22332, CRS_EPSG_UTM, 32, TRUE, -1, 0}, // PCS_Carthage_UTM_zone_32N
+  {22523, 22524, CRS_EPSG_UTM, 23, FALSE, -1, 0}, // PCS_Corrego_Alegre_UTM_23S to 24S
+  {22832, 22832, CRS_EPSG_UTM, 32, TRUE, -1, 0}, // PCS_Douala_UTM_zone_32N
+  {23028, 23038, CRS_EPSG_UTM, 28, TRUE, CRS_ELLIPSOID_Inter, 0}, // PCS_ED50_UTM_zone_28N to 38N
+  {23239, 23240, CRS_EPSG_UTM, 39, TRUE, -1, 0}, // PCS_Fahud_UTM_zone_39N to 40N
+  {23433, 23433, CRS_EPSG_UTM, 33, TRUE, -1, 0}, // PCS_Garoua_UTM_zone_33N
+  {23846, 23853, CRS_EPSG_UTM, 46, TRUE, CRS_ELLIPSOID_ID74, 0}, // PCS_ID74_UTM_zone_46N to 53N
+  {23886, 23894, CRS_EPSG_UTM, 46, FALSE, CRS_ELLIPSOID_ID74, 0}, // PCS_ID74_UTM_zone_46S to 54S
+  {23947, 23948, CRS_EPSG_UTM, 47, TRUE, -1, 0}, // PCS_Indian_1954_UTM_47N to 48N
+  {24047, 24048, CRS_EPSG_UTM, 47, TRUE, -1, 0}, // PCS_Indian_1975_UTM_47N to 48N
+  {24547, 24548, CRS_EPSG_UTM, 47, TRUE, -1, 0}, // PCS_Kertau_UTM_zone_47N to 48N
+  {24720, 24721, CRS_EPSG_UTM, 20, TRUE, -1, 0}, // PCS_La_Canoa_UTM_zone_20N to 21N
+  {24818, 24821, CRS_EPSG_UTM, 18, TRUE, -1, 0}, // PCS_PSAD56_UTM_zone_18N to 21N
+  {24877, 24880, CRS_EPSG_UTM, 17, FALSE, -1, 0}, // PCS_PSAD56_UTM_zone_17S to 20S
+  {25231, 25231, CRS_EPSG_UTM, 31, TRUE, -1, 0}, // PCS_Lome_UTM_zone_31N
+  {25828, 25838, CRS_EPSG_UTM, 28, TRUE, CRS_ELLIPSOID_NAD83, 0}, // PCS_ETRS89_UTM_zone_28N to 38N
+  {25932, 25932, CRS_EPSG_UTM, 32, FALSE, -1, 0}, // PCS_Malongo_1987_UTM_32S
+  {26237, 26237, CRS_EPSG_UTM, 37, TRUE, -1, 0}, // PCS_Massawa_UTM_zone_37N
+  {26331, 26332, CRS_EPSG_UTM, 31, TRUE, -1, 0}, // PCS_Minna_UTM_zone_31N to 32N
+  {26432, 26432, CRS_EPSG_UTM, 32, FALSE, -1, 0}, // PCS_Mhast_UTM_zone_32S
+  {26632, 26632, CRS_EPSG_UTM, 32, TRUE, -1, 0}, // PCS_M_poraloko_UTM_32N
+  {26692, 26692, CRS_EPSG_UTM, 32, FALSE, -1, 0}, // PCS_Minna_UTM_zone_32S
+  {26703, 26722, CRS_EPSG_UTM, 3, TRUE, CRS_ELLIPSOID_NAD27, 0}, // PCS_NAD27_UTM_zone_3N to 22N
+  {26729, 26729, CRS_EPSG_SP27, 0, FALSE, -1, "AL_E"}, // PCS_NAD27_Alabama_East
+  {26730, 26730, CRS_EPSG_SP27, 0, FALSE, -1, "AL_W"}, // PCS_NAD27_Alabama_West
+  {26731, 26731, CRS_EPSG_SP27, 0, FALSE, -1, "AK_1"}, // PCS_NAD27_Alaska_zone_1
+  {26732, 26732, CRS_EPSG_SP27, 0, FALSE, -1, "AK_2"}, // PCS_NAD27_Alaska_zone_2
+  {26733, 26733, CRS_EPSG_SP27, 0, FALSE, -1, "AK_3"}, // PCS_NAD27_Alaska_zone_3
+  {26734, 26734, CRS_EPSG_SP27, 0, FALSE, -1, "AK_4"}, // PCS_NAD27_Alaska_zone_4
+  {26735, 26735, CRS_EPSG_SP27, 0, FALSE, -1, "AK_5"}, // PCS_NAD27_Alaska_zone_5
+  {26736, 26736, CRS_EPSG_SP27, 0, FALSE, -1, "AK_6"}, // PCS_NAD27_Alaska_zone_6
+  {26737, 26737, CRS_EPSG_SP27, 0, FALSE, -1, "AK_7"}, // PCS_NAD27_Alaska_zone_7
+  {26738, 26738, CRS_EPSG_SP27, 0, FALSE, -1, "AK_8"}, // PCS_NAD27_Alaska_zone_8
+  {26739, 26739, CRS_EPSG_SP27, 0, FALSE, -1, "AK_9"}, // PCS_NAD27_Alaska_zone_9
+  {26740, 26740, CRS_EPSG_SP27, 0, FALSE, -1, "AK_10"}, // PCS_NAD27_Alaska_zone_10
+  {26741, 26741, CRS_EPSG_SP27, 0, FALSE, -1, "CA_I"}, // PCS_NAD27_California_I
+  {26742, 26742, CRS_EPSG_SP27, 0, FALSE, -1, "CA_II"}, // PCS_NAD27_California_II
+  {26743, 26743, CRS_EPSG_SP27, 0, FALSE, -1, "CA_III"}, // PCS_NAD27_California_III
+  {26744, 26744, CRS_EPSG_SP27, 0, FALSE, -1, "CA_IV"}, // PCS_NAD27_California_IV
+  {26745, 26745, CRS_EPSG_SP27, 0, FALSE, -1, "CA_V"}, // PCS_NAD27_California_V
+  {26746, 26746, CRS_EPSG_SP27, 0, FALSE, -1, "CA_VI"}, // PCS_NAD27_California_VI
+  {26747, 26747, CRS_EPSG_SP27, 0, FALSE, -1, "CA_VII"}, // PCS_NAD27_California_VII
+  {26748, 26748, CRS_EPSG_SP27, 0, FALSE, -1, "AZ_E"}, // PCS_NAD27_Arizona_East
+  {26749, 26749, CRS_EPSG_SP27, 0, FALSE, -1, "AZ_C"}, // PCS_NAD27_Arizona_Central
+  {26750, 26750, CRS_EPSG_SP27, 0, FALSE, -1, "AZ_W"}, // PCS_NAD27_Arizona_West
+  {26751, 26751, CRS_EPSG_SP27, 0, FALSE, -1, "AR_N"}, // PCS_NAD27_Arkansas_North
+  {26752, 26752, CRS_EPSG_SP27, 0, FALSE, -1, "AR_S"}, // PCS_NAD27_Arkansas_South
+  {26753, 26753, CRS_EPSG_SP27, 0, FALSE, -1, "CO_N"}, // PCS_NAD27_Colorado_North
+  {26754, 26754, CRS_EPSG_SP27, 0, FALSE, -1, "CO_C"}, // PCS_NAD27_Colorado_Central
+  {26755, 26755, CRS_EPSG_SP27, 0, FALSE, -1, "CO_S"}, // PCS_NAD27_Colorado_South
+  {26756, 26756, CRS_EPSG_SP27, 0, FALSE, -1, "CT"}, // PCS_NAD27_Connecticut
+  {26757, 26757, CRS_EPSG_SP27, 0, FALSE, -1, "DE"}, // PCS_NAD27_Delaware
+  {26758, 26758, CRS_EPSG_SP27, 0, FALSE, -1, "FL_E"}, // PCS_NAD27_Florida_East
+  {26759, 26759, CRS_EPSG_SP27, 0, FALSE, -1, "FL_W"}, // PCS_NAD27_Florida_West
+  {26760, 26760, CRS_EPSG_SP27, 0, FALSE, -1, "FL_N"}, // PCS_NAD27_Florida_North
+  {26761, 26761, CRS_EPSG_SP27, 0, FALSE, -1, "HI_1"}, // PCS_NAD27_Hawaii_zone_1
+  {26762, 26762, CRS_EPSG_SP27, 0, FALSE, -1, "HI_2"}, // PCS_NAD27_Hawaii_zone_2
+  {26763, 26763, CRS_EPSG_SP27, 0, FALSE, -1, "HI_3"}, // PCS_NAD27_Hawaii_zone_3
+  {26764, 26764, CRS_EPSG_SP27, 0, FALSE, -1, "HI_4"}, // PCS_NAD27_Hawaii_zone_4
+  {26765, 26765, CRS_EPSG_SP27, 0, FALSE, -1, "HI_5"}, // PCS_NAD27_Hawaii_zone_5
+  {26766, 26766, CRS_EPSG_SP27, 0, FALSE, -1, "GA_E"}, // PCS_NAD27_Georgia_East
+  {26767, 26767, CRS_EPSG_SP27, 0, FALSE, -1, "GA_W"}, // PCS_NAD27_Georgia_West
+  {26768, 26768, CRS_EPSG_SP27, 0, FALSE, -1, "ID_E"}, // PCS_NAD27_Idaho_East
+  {26769, 26769, CRS_EPSG_SP27, 0, FALSE, -1, "ID_C"}, // PCS_NAD27_Idaho_Central
+  {26770, 26770, CRS_EPSG_SP27, 0, FALSE, -1, "ID_W"}, // PCS_NAD27_Idaho_West
+  {26771, 26771, CRS_EPSG_SP27, 0, FALSE, -1, "IL_E"}, // PCS_NAD27_Illinois_East
+  {26772, 26772, CRS_EPSG_SP27, 0, FALSE, -1, "IL_W"}, // PCS_NAD27_Illinois_West
+  {26773, 26773, CRS_EPSG_SP27, 0, FALSE, -1, "IN_E"}, // PCS_NAD27_Indiana_East
+  {26774, 26774, CRS_EPSG_SP27, 0, FALSE, -1, "IN_W"}, // PCS_NAD27_Indiana_West
+  {26775, 26775, CRS_EPSG_SP27, 0, FALSE, -1, "IA_N"}, // PCS_NAD27_Iowa_North
+  {26776, 26776, CRS_EPSG_SP27, 0, FALSE, -1, "IA_S"}, // PCS_NAD27_Iowa_South
+  {26777, 26777, CRS_EPSG_SP27, 0, FALSE, -1, "KS_N"}, // PCS_NAD27_Kansas_North
+  {26778, 26778, CRS_EPSG_SP27, 0, FALSE, -1, "KS_S"}, // PCS_NAD27_Kansas_South
+  {26779, 26779, CRS_EPSG_SP27, 0, FALSE, -1, "KY_N"}, // PCS_NAD27_Kentucky_North
+  {26780, 26780, CRS_EPSG_SP27, 0, FALSE, -1, "KY_S"}, // PCS_NAD27_Kentucky_South
+  {26781, 26781, CRS_EPSG_SP27, 0, FALSE, -1, "LA_N"}, // PCS_NAD27_Louisiana_North
+  {26782, 26782, CRS_EPSG_SP27, 0, FALSE, -1, "LA_S"}, // PCS_NAD27_Louisiana_South
+  {26783, 26783, CRS_EPSG_SP27, 0, FALSE, -1, "ME_E"}, // PCS_NAD27_Maine_East
+  {26784, 26784, CRS_EPSG_SP27, 0, FALSE, -1, "ME_W"}, // PCS_NAD27_Maine_West
+  {26785, 26785, CRS_EPSG_SP27, 0, FALSE, -1, "MD"}, // PCS_NAD27_Maryland
+  {26786, 26786, CRS_EPSG_SP27, 0, FALSE, -1, "M_M"}, // PCS_NAD27_Massachusetts
+  {26787, 26787, CRS_EPSG_SP27, 0, FALSE, -1, "M_I"}, // PCS_NAD27_Massachusetts_Is
+  {26788, 26788, CRS_EPSG_SP27, 0, FALSE, -1, "MI_N"}, // PCS_NAD27_Michigan_North
+  {26789, 26789, CRS_EPSG_SP27, 0, FALSE, -1, "MI_C"}, // PCS_NAD27_Michigan_Central
+  {26790, 26790, CRS_EPSG_SP27, 0, FALSE, -1, "MI_S"}, // PCS_NAD27_Michigan_South
+  {26791, 26791, CRS_EPSG_SP27, 0, FALSE, -1, "MN_N"}, // PCS_NAD27_Minnesota_North
+  {26792, 26792, CRS_EPSG_SP27, 0, FALSE, -1, "MN_C"}, // PCS_NAD27_Minnesota_Cent
+  {26793, 26793, CRS_EPSG_SP27, 0, FALSE, -1, "MN_S"}, // PCS_NAD27_Minnesota_South
+  {26794, 26794, CRS_EPSG_SP27, 0, FALSE, -1, "MS_E"}, // PCS_NAD27_Mississippi_East
+  {26795, 26795, CRS_EPSG_SP27, 0, FALSE, -1, "MS_W"}, // PCS_NAD27_Mississippi_West
+  {26796, 26796, CRS_EPSG_SP27, 0, FALSE, -1, "MO_E"}, // PCS_NAD27_Missouri_East
+  {26797, 26797, CRS_EPSG_SP27, 0, FALSE, -1, "MO_C"}, // PCS_NAD27_Missouri_Central
+  {26798, 26798, CRS_EPSG_SP27, 0, FALSE, -1, "MO_W"}, // PCS_NAD27_Missouri_West
+  {26903, 26923, CRS_EPSG_UTM, 3, TRUE, CRS_ELLIPSOID_NAD83, 0}, // PCS_NAD83_UTM_zone_3N to 23N
+  {26929, 26929, CRS_EPSG_SP83, 0, FALSE, -1, "AL_E"}, // PCS_NAD83_Alabama_East
+  {26930, 26930, CRS_EPSG_SP83, 0, FALSE, -1, "AL_W"}, // PCS_NAD83_Alabama_West
+  {26931, 26931, CRS_EPSG_SP83, 0, FALSE, -1, "AK_1"}, // PCS_NAD83_Alaska_zone_1
+  {26932, 26932, CRS_EPSG_SP83, 0, FALSE, -1, "AK_2"}, // PCS_NAD83_Alaska_zone_2
+  {26933, 26933, CRS_EPSG_SP83, 0, FALSE, -1, "AK_3"}, // PCS_NAD83_Alaska_zone_3
+  {26934, 26934, CRS_EPSG_SP83, 0, FALSE, -1, "AK_4"}, // PCS_NAD83_Alaska_zone_4
+  {26935, 26935, CRS_EPSG_SP83, 0, FALSE, -1, "AK_5"}, // PCS_NAD83_Alaska_zone_5
+  {26936, 26936, CRS_EPSG_SP83, 0, FALSE, -1, "AK_6"}, // PCS_NAD83_Alaska_zone_6
+  {26937, 26937, CRS_EPSG_SP83, 0, FALSE, -1, "AK_7"}, // PCS_NAD83_Alaska_zone_7
+  {26938, 26938, CRS_EPSG_SP83, 0, FALSE, -1, "AK_8"}, // PCS_NAD83_Alaska_zone_8
+  {26939, 26939, CRS_EPSG_SP83, 0, FALSE, -1, "AK_9"}, // PCS_NAD83_Alaska_zone_9
+  {26940, 26940, CRS_EPSG_SP83, 0, FALSE, -1, "AK_10"}, // PCS_NAD83_Alaska_zone_10
+  {26941, 26941, CRS_EPSG_SP83, 0, FALSE, -1, "CA_I"}, // PCS_NAD83_California_I
+  {26942, 26942, CRS_EPSG_SP83, 0, FALSE, -1, "CA_II"}, // PCS_NAD83_California_II
+  {26943, 26943, CRS_EPSG_SP83, 0, FALSE, -1, "CA_III"}, // PCS_NAD83_California_III
+  {26944, 26944, CRS_EPSG_SP83, 0, FALSE, -1, "CA_IV"}, // PCS_NAD83_California_IV
+  {26945, 26945, CRS_EPSG_SP83, 0, FALSE, -1, "CA_V"}, // PCS_NAD83_California_V
+  {26946, 26946, CRS_EPSG_SP83, 0, FALSE, -1, "CA_VI"}, // PCS_NAD83_California_VI
+  {26947, 26947, CRS_EPSG_SP83, 0, FALSE, -1, "CA_VII"}, // PCS_NAD83_California_VII
+  {26948, 26948, CRS_EPSG_SP83, 0, FALSE, -1, "AZ_E"}, // PCS_NAD83_Arizona_East
+  {26949, 26949, CRS_EPSG_SP83, 0, FALSE, -1, "AZ_C"}, // PCS_NAD83_Arizona_Central
+  {26950, 26950, CRS_EPSG_SP83, 0, FALSE, -1, "AZ_W"}, // PCS_NAD83_Arizona_West
+  {26951, 26951, CRS_EPSG_SP83, 0, FALSE, -1, "AR_N"}, // PCS_NAD83_Arkansas_North
+  {26952, 26952, CRS_EPSG_SP83, 0, FALSE, -1, "AR_S"}, // PCS_NAD83_Arkansas_South
+  {26953, 26953, CRS_EPSG_SP83, 0, FALSE, -1, "CO_N"}, // PCS_NAD83_Colorado_North
+  {26954, 26954, CRS_EPSG_SP83, 0, FALSE, -1, "CO_C"}, // PCS_NAD83_Colorado_Central
+  {26955, 26955, CRS_EPSG_SP83, 0, FALSE, -1, "CO_S"}, // PCS_NAD83_Colorado_South
+  {26956, 26956, CRS_EPSG_SP83, 0, FALSE, -1, "CT"}, // PCS_NAD83_Connecticut
+  {26957, 26957, CRS_EPSG_SP83, 0, FALSE, -1, "DE"}, // PCS_NAD83_Delaware
+  {26958, 26958, CRS_EPSG_SP83, 0, FALSE, -1, "FL_E"}, // PCS_NAD83_Florida_East
+  {26959, 26959, CRS_EPSG_SP83, 0, FALSE, -1, "FL_W"}, // PCS_NAD83_Florida_West
+  {26960, 26960, CRS_EPSG_SP83, 0, FALSE, -1, "FL_N"}, // PCS_NAD83_Florida_North
+  {26961, 26961, CRS_EPSG_SP83, 0, FALSE, -1, "HI_1"}, // PCS_NAD83_Hawaii_zone_1
+  {26962, 26962, CRS_EPSG_SP83, 0, FALSE, -1, "HI_2"}, // PCS_NAD83_Hawaii_zone_2
+  {26963, 26963, CRS_EPSG_SP83, 0, FALSE, -1, "HI_3"}, // PCS_NAD83_Hawaii_zone_3
+  {26964, 26964, CRS_EPSG_SP83, 0, FALSE, -1, "HI_4"}, // PCS_NAD83_Hawaii_zone_4
+  {26965, 26965, CRS_EPSG_SP83, 0, FALSE, -1, "HI_5"}, // PCS_NAD83_Hawaii_zone_5
+  {26966, 26966, CRS_EPSG_SP83, 0, FALSE, -1, "GA_E"}, // PCS_NAD83_Georgia_East
+  {26967, 26967, CRS_EPSG_SP83, 0, FALSE, -1, "GA_W"}, // PCS_NAD83_Georgia_West
+  {26968, 26968, CRS_EPSG_SP83, 0, FALSE, -1, "ID_E"}, // PCS_NAD83_Idaho_East
+  {26969, 26969, CRS_EPSG_SP83, 0, FALSE, -1, "ID_C"}, // PCS_NAD83_Idaho_Central
+  {26970, 26970, CRS_EPSG_SP83, 0, FALSE, -1, "ID_W"}, // PCS_NAD83_Idaho_West
+  {26971, 26971, CRS_EPSG_SP83, 0, FALSE, -1, "IL_E"}, // PCS_NAD83_Illinois_East
+  {26972, 26972, CRS_EPSG_SP83, 0, FALSE, -1, "IL_W"}, // PCS_NAD83_Illinois_West
+  {26973, 26973, CRS_EPSG_SP83, 0, FALSE, -1, "IN_E"}, // PCS_NAD83_Indiana_East
+  {26974, 26974, CRS_EPSG_SP83, 0, FALSE, -1, "IN_W"}, // PCS_NAD83_Indiana_West
+  {26975, 26975, CRS_EPSG_SP83, 0, FALSE, -1, "IA_N"}, // PCS_NAD83_Iowa_North
+  {26976, 26976, CRS_EPSG_SP83, 0, FALSE, -1, "IA_S"}, // PCS_NAD83_Iowa_South
+  {26977, 26977, CRS_EPSG_SP83, 0, FALSE, -1, "KS_N"}, // PCS_NAD83_Kansas_North
+  {26978, 26978, CRS_EPSG_SP83, 0, FALSE, -1, "KS_S"}, // PCS_NAD83_Kansas_South
+  {26979, 26979, CRS_EPSG_SP83, 0, FALSE, -1, "KY_N"}, // PCS_NAD83_Kentucky_North
+  {26980, 26980, CRS_EPSG_SP83, 0, FALSE, -1, "KY_S"}, // PCS_NAD83_Kentucky_South
+  {26981, 26981, CRS_EPSG_SP83, 0, FALSE, -1, "LA_N"}, // PCS_NAD83_Louisiana_North
+  {26982, 26982, CRS_EPSG_SP83, 0, FALSE, -1, "LA_S"}, // PCS_NAD83_Louisiana_South
+  {26983, 26983, CRS_EPSG_SP83, 0, FALSE, -1, "ME_E"}, // PCS_NAD83_Maine_East
+  {26984, 26984, CRS_EPSG_SP83, 0, FALSE, -1, "ME_W"}, // PCS_NAD83_Maine_West
+  {26985, 26985, CRS_EPSG_SP83, 0, FALSE, -1, "MD"}, // PCS_NAD83_Maryland
+  {26986, 26986, CRS_EPSG_SP83, 0, FALSE, -1, "M_M"}, // PCS_NAD83_Massachusetts
+  {26987, 26987, CRS_EPSG_SP83, 0, FALSE, -1, "M_I"}, // PCS_NAD83_Massachusetts_Is
+  {26988, 26988, CRS_EPSG_SP83, 0, FALSE, -1, "MI_N"}, // PCS_NAD83_Michigan_North
+  {26989, 26989, CRS_EPSG_SP83, 0, FALSE, -1, "MI_C"}, // PCS_NAD83_Michigan_Central
+  {26990, 26990, CRS_EPSG_SP83, 0, FALSE, -1, "MI_S"}, // PCS_NAD83_Michigan_South
+  {26991, 26991, CRS_EPSG_SP83, 0, FALSE, -1, "MN_N"}, // PCS_NAD83_Minnesota_North
+  {26992, 26992, CRS_EPSG_SP83, 0, FALSE, -1, "MN_C"}, // PCS_NAD83_Minnesota_Cent
+  {26993, 26993, CRS_EPSG_SP83, 0, FALSE, -1, "MN_S"}, // PCS_NAD83_Minnesota_South
+  {26994, 26994, CRS_EPSG_SP83, 0, FALSE, -1, "MS_E"}, // PCS_NAD83_Mississippi_East
+  {26995, 26995, CRS_EPSG_SP83, 0, FALSE, -1, "MS_W"}, // PCS_NAD83_Mississippi_West
+  {26996, 26996, CRS_EPSG_SP83, 0, FALSE, -1, "MO_E"}, // PCS_NAD83_Missouri_East
+  {26997, 26997, CRS_EPSG_SP83, 0, FALSE, -1, "MO_C"}, // PCS_NAD83_Missouri_Central
+  {26998, 26998, CRS_EPSG_SP83, 0, FALSE, -1, "MO_W"}, // PCS_NAD83_Missouri_West
+  {28348, 28358, CRS_EPSG_MGA, 48, FALSE, CRS_ELLIPSOID_NAD83, 0}, // PCS_GDA94_MGA_zone_48 to 58
+  {29118, 29122, CRS_EPSG_UTM, 18, TRUE, CRS_ELLIPSOID_SAD69, 0}, // PCS_SAD69_UTM_zone_18N to 22N
+  {29177, 29185, CRS_EPSG_UTM, 17, FALSE, CRS_ELLIPSOID_SAD69, 0}, // PCS_SAD69_UTM_zone_17S to 25S
+  {29220, 29221, CRS_EPSG_UTM, 20, FALSE, -1, 0}, // PCS_Sapper_Hill_UTM_20S to 21S
+  {29333, 29333, CRS_EPSG_UTM, 33, FALSE, -1, 0}, // PCS_Schwarzeck_UTM_33S
+  {29635, 29636, CRS_EPSG_UTM, 35, TRUE, -1, 0}, // PCS_Sudan_UTM_zone_35N
+  {29738, 29739, CRS_EPSG_UTM, 38, FALSE, -1, 0}, // PCS_Tananarive_UTM_38S to 39S
+  {29849, 29850, CRS_EPSG_UTM, 49, TRUE, -1, 0}, // PCS_Timbalai_1948_UTM_49N to 50N
+  {30339, 30340, CRS_EPSG_UTM, 39, TRUE, -1, 0}, // PCS_TC_1948_UTM_zone_39N to 40N
+  {30729, 30732, CRS_EPSG_UTM, 29, TRUE, -1, 0}, // PCS_Nord_Sahara_UTM_29N to 32N
+  {31028, 31028, CRS_EPSG_UTM, 28, TRUE, -1, 0}, // PCS_Yoff_UTM_zone_28N
+  {31121, 31121, CRS_EPSG_UTM, 21, TRUE, -1, 0}, // PCS_Zanderij_UTM_zone_21N
+  {32001, 32001, CRS_EPSG_SP27, 0, FALSE, -1, "MT_N"}, // PCS_NAD27_Montana_North
+  {32002, 32002, CRS_EPSG_SP27, 0, FALSE, -1, "MT_C"}, // PCS_NAD27_Montana_Central
+  {32003, 32003, CRS_EPSG_SP27, 0, FALSE, -1, "MT_S"}, // PCS_NAD27_Montana_South
+  {32005, 32005, CRS_EPSG_SP27, 0, FALSE, -1, "NE_N"}, // PCS_NAD27_Nebraska_North
+  {32006, 32006, CRS_EPSG_SP27, 0, FALSE, -1, "NE_S"}, // PCS_NAD27_Nebraska_South
+  {32007, 32007, CRS_EPSG_SP27, 0, FALSE, -1, "NV_E"}, // PCS_NAD27_Nevada_East
+  {32008, 32008, CRS_EPSG_SP27, 0, FALSE, -1, "NV_C"}, // PCS_NAD27_Nevada_Central
+  {32009, 32009, CRS_EPSG_SP27, 0, FALSE, -1, "NV_W"}, // PCS_NAD27_Nevada_West
+  {32010, 32010, CRS_EPSG_SP27, 0, FALSE, -1, "NH"}, // PCS_NAD27_New_Hampshire
+  {32011, 32011, CRS_EPSG_SP27, 0, FALSE, -1, "NJ"}, // PCS_NAD27_New_Jersey
+  {32012, 32012, CRS_EPSG_SP27, 0, FALSE, -1, "NM_E"}, // PCS_NAD27_New_Mexico_East
+  {32013, 32013, CRS_EPSG_SP27, 0, FALSE, -1, "NM_C"}, // PCS_NAD27_New_Mexico_Cent
+  {32014, 32014, CRS_EPSG_SP27, 0, FALSE, -1, "NM_W"}, // PCS_NAD27_New_Mexico_West
+  {32015, 32015, CRS_EPSG_SP27, 0, FALSE, -1, "NY_E"}, // PCS_NAD27_New_York_East
+  {32016, 32016, CRS_EPSG_SP27, 0, FALSE, -1, "NY_C"}, // PCS_NAD27_New_York_Central
+  {32017, 32017, CRS_EPSG_SP27, 0, FALSE, -1, "NY_W"}, // PCS_NAD27_New_York_West
+  {32018, 32018, CRS_EPSG_SP27, 0, FALSE, -1, "NT_LI"}, // PCS_NAD27_New_York_Long_Is
+  {32019, 32019, CRS_EPSG_SP27, 0, FALSE, -1, "NC"}, // PCS_NAD27_North_Carolina
+  {32020, 32020, CRS_EPSG_SP27, 0, FALSE, -1, "ND_N"}, // PCS_NAD27_North_Dakota_N
+  {32021, 32021, CRS_EPSG_SP27, 0, FALSE, -1, "ND_S"}, // PCS_NAD27_North_Dakota_S
+  {32022, 32022, CRS_EPSG_SP27, 0, FALSE, -1, "OH_N"}, // PCS_NAD27_Ohio_North
+  {32023, 32023, CRS_EPSG_SP27, 0, FALSE, -1, "OH_S"}, // PCS_NAD27_Ohio_South
+  {32024, 32024, CRS_EPSG_SP27, 0, FALSE, -1, "OK_N"}, // PCS_NAD27_Oklahoma_North
+  {32025, 32025, CRS_EPSG_SP27, 0, FALSE, -1, "OK_S"}, // PCS_NAD27_Oklahoma_South
+  {32026, 32026, CRS_EPSG_SP27, 0, FALSE, -1, "OR_N"}, // PCS_NAD27_Oregon_North
+  {32027, 32027, CRS_EPSG_SP27, 0, FALSE, -1, "OR_S"}, // PCS_NAD27_Oregon_South
+  {32028, 32028, CRS_EPSG_SP27, 0, FALSE, -1, "PA_N"}, // PCS_NAD27_Pennsylvania_N
+  {32029, 32029, CRS_EPSG_SP27, 0, FALSE, -1, "PA_S"}, // PCS_NAD27_Pennsylvania_S
+  {32030, 32030, CRS_EPSG_SP27, 0, FALSE, -1, "RI"}, // PCS_NAD27_Rhode_Island
+  {32031, 32031, CRS_EPSG_SP27, 0, FALSE, -1, "SC_N"}, // PCS_NAD27_South_Carolina_N
+  {32033, 32033, CRS_EPSG_SP27, 0, FALSE, -1, "SC_S"}, // PCS_NAD27_South_Carolina_S
+  {32034, 32034, CRS_EPSG_SP27, 0, FALSE, -1, "SD_N"}, // PCS_NAD27_South_Dakota_N
+  {32035, 32035, CRS_EPSG_SP27, 0, FALSE, -1, "SD_S"}, // PCS_NAD27_South_Dakota_S
+  {32036, 32036, CRS_EPSG_SP27, 0, FALSE, -1, "TN"}, // PCS_NAD27_Tennessee
+  {32037, 32037, CRS_EPSG_SP27, 0, FALSE, -1, "TX_N"}, // PCS_NAD27_Texas_North
+  {32038, 32038, CRS_EPSG_SP27, 0, FALSE, -1, "TX_NC"}, // PCS_NAD27_Texas_North_Cen
+  {32039, 32039, CRS_EPSG_SP27, 0, FALSE, -1, "TX_C"}, // PCS_NAD27_Texas_Central
+  {32040, 32040, CRS_EPSG_SP27, 0, FALSE, -1, "TX_SC"}, // PCS_NAD27_Texas_South_Cen
+  {32041, 32041, CRS_EPSG_SP27, 0, FALSE, -1, "TX_S"}, // PCS_NAD27_Texas_South
+  {32042, 32042, CRS_EPSG_SP27, 0, FALSE, -1, "UT_N"}, // PCS_NAD27_Utah_North
+  {32043, 32043, CRS_EPSG_SP27, 0, FALSE, -1, "UT_C"}, // PCS_NAD27_Utah_Central
+  {32044, 32044, CRS_EPSG_SP27, 0, FALSE, -1, "UT_S"}, // PCS_NAD27_Utah_South
+  {32045, 32045, CRS_EPSG_SP27, 0, FALSE, -1, "VT"}, // PCS_NAD27_Vermont
+  {32046, 32046, CRS_EPSG_SP27, 0, FALSE, -1, "VA_N"}, // PCS_NAD27_Virginia_North
+  {32047, 32047, CRS_EPSG_SP27, 0, FALSE, -1, "VA_S"}, // PCS_NAD27_Virginia_South
+  {32048, 32048, CRS_EPSG_SP27, 0, FALSE, -1, "WA_N"}, // PCS_NAD27_Washington_North
+  {32049, 32049, CRS_EPSG_SP27, 0, FALSE, -1, "WA_S"}, // PCS_NAD27_Washington_South
+  {32050, 32050, CRS_EPSG_SP27, 0, FALSE, -1, "WV_N"}, // PCS_NAD27_West_Virginia_N
+  {32051, 32051, CRS_EPSG_SP27, 0, FALSE, -1, "WV_S"}, // PCS_NAD27_West_Virginia_S
+  {32052, 32052, CRS_EPSG_SP27, 0, FALSE, -1, "WI_N"}, // PCS_NAD27_Wisconsin_North
+  {32053, 32053, CRS_EPSG_SP27, 0, FALSE, -1, "WI_C"}, // PCS_NAD27_Wisconsin_Cen
+  {32054, 32054, CRS_EPSG_SP27, 0, FALSE, -1, "WI_S"}, // PCS_NAD27_Wisconsin_South
+  {32055, 32055, CRS_EPSG_SP27, 0, FALSE, -1, "WY_E"}, // PCS_NAD27_Wyoming_East
+  {32056, 32056, CRS_EPSG_SP27, 0, FALSE, -1, "WY_EC"}, // PCS_NAD27_Wyoming_E_Cen
+  {32057, 32057, CRS_EPSG_SP27, 0, FALSE, -1, "WY_WC"}, // PCS_NAD27_Wyoming_W_Cen
+  {32058, 32058, CRS_EPSG_SP27, 0, FALSE, -1, "WY_W"}, // PCS_NAD27_Wyoming_West
+  {32059, 32059, CRS_EPSG_SP27, 0, FALSE, -1, "PR"}, // PCS_NAD27_Puerto_Rico
+  {32060, 32060, CRS_EPSG_SP27, 0, FALSE, -1, "St.Croix"}, // PCS_NAD27_St_Croix
+  {32100, 32100, CRS_EPSG_SP83, 0, FALSE, -1, "MT"}, // PCS_NAD83_Montana
+  {32104, 32104, CRS_EPSG_SP83, 0, FALSE, -1, "NE"}, // PCS_NAD83_Nebraska
+  {32107, 32107, CRS_EPSG_SP83, 0, FALSE, -1, "NV_E"}, // PCS_NAD83_Nevada_East
+  {32108, 32108, CRS_EPSG_SP83, 0, FALSE, -1, "NV_C"}, // PCS_NAD83_Nevada_Central
+  {32109, 32109, CRS_EPSG_SP83, 0, FALSE, -1, "NV_W"}, // PCS_NAD83_Nevada_West
+  {32110, 32110, CRS_EPSG_SP83, 0, FALSE, -1, "NH"}, // PCS_NAD83_New_Hampshire
+  {32111, 32111, CRS_EPSG_SP83, 0, FALSE, -1, "NJ"}, // PCS_NAD83_New_Jersey
+  {32112, 32112, CRS_EPSG_SP83, 0, FALSE, -1, "NM_E"}, // PCS_NAD83_New_Mexico_East
+  {32113, 32113, CRS_EPSG_SP83, 0, FALSE, -1, "NM_C"}, // PCS_NAD83_New_Mexico_Cent
+  {32114, 32114, CRS_EPSG_SP83, 0, FALSE, -1, "NM_W"}, // PCS_NAD83_New_Mexico_West
+  {32115, 32115, CRS_EPSG_SP83, 0, FALSE, -1, "NY_E"}, // PCS_NAD83_New_York_East
+  {32116, 32116, CRS_EPSG_SP83, 0, FALSE, -1, "NY_C"}, // PCS_NAD83_New_York_Central
+  {32117, 32117, CRS_EPSG_SP83, 0, FALSE, -1, "NY_W"}, // PCS_NAD83_New_York_West
+  {32118, 32118, CRS_EPSG_SP83, 0, FALSE, -1, "NT_LI"}, // PCS_NAD83_New_York_Long_Is
+  {32119, 32119, CRS_EPSG_SP83, 0, FALSE, -1, "NC"}, // PCS_NAD83_North_Carolina
+  {32120, 32120, CRS_EPSG_SP83, 0, FALSE, -1, "ND_N"}, // PCS_NAD83_North_Dakota_N
+  {32121, 32121, CRS_EPSG_SP83, 0, FALSE, -1, "ND_S"}, // PCS_NAD83_North_Dakota_S
+  {32122, 32122, CRS_EPSG_SP83, 0, FALSE, -1, "OH_N"}, // PCS_NAD83_Ohio_North
+  {32123, 32123, CRS_EPSG_SP83, 0, FALSE, -1, "OH_S"}, // PCS_NAD83_Ohio_South
+  {32124, 32124, CRS_EPSG_SP83, 0, FALSE, -1, "OK_N"}, // PCS_NAD83_Oklahoma_North
+  {32125, 32125, CRS_EPSG_SP83, 0, FALSE, -1, "OK_S"}, // PCS_NAD83_Oklahoma_South
+  {32126, 32126, CRS_EPSG_SP83, 0, FALSE, -1, "OR_N"}, // PCS_NAD83_Oregon_North
+  {32127, 32127, CRS_EPSG_SP83, 0, FALSE, -1, "OR_S"}, // PCS_NAD83_Oregon_South
+  {32128, 32128, CRS_EPSG_SP83, 0, FALSE, -1, "PA_N"}, // PCS_NAD83_Pennsylvania_N
+  {32129, 32129, CRS_EPSG_SP83, 0, FALSE, -1, "PA_S"}, // PCS_NAD83_Pennsylvania_S
+  {32130, 32130, CRS_EPSG_SP83, 0, FALSE, -1, "RI"}, // PCS_NAD83_Rhode_Island
+  {32133, 32133, CRS_EPSG_SP83, 0, FALSE, -1, "SC"}, // PCS_NAD83_South_Carolina
+  {32134, 32134, CRS_EPSG_SP83, 0, FALSE, -1, "SD_N"}, // PCS_NAD83_South_Dakota_N
+  {32135, 32135, CRS_EPSG_SP83, 0, FALSE, -1, "SD_S"}, // PCS_NAD83_South_Dakota_S
+  {32136, 32136, CRS_EPSG_SP83, 0, FALSE, -1, "TN"}, // PCS_NAD83_Tennessee
+  {32137, 32137, CRS_EPSG_SP83, 0, FALSE, -1, "TX_N"}, // PCS_NAD83_Texas_North
+  {32138, 32138, CRS_EPSG_SP83, 0, FALSE, -1, "TX_NC"}, // PCS_NAD83_Texas_North_Cen
+  {32139, 32139, CRS_EPSG_SP83, 0, FALSE, -1, "TX_C"}, // PCS_NAD83_Texas_Central
+  {32140, 32140, CRS_EPSG_SP83, 0, FALSE, -1, "TX_SC"}, // PCS_NAD83_Texas_South_Cen
+  {32141, 32141, CRS_EPSG_SP83, 0, FALSE, -1, "TX_S"}, // PCS_NAD83_Texas_South
+  {32142, 32142, CRS_EPSG_SP83, 0, FALSE, -1, "UT_N"}, // PCS_NAD83_Utah_North
+  {32143, 32143, CRS_EPSG_SP83, 0, FALSE, -1, "UT_C"}, // PCS_NAD83_Utah_Central
+  {32144, 32144, CRS_EPSG_SP83, 0, FALSE, -1, "UT_S"}, // PCS_NAD83_Utah_South
+  {32145, 32145, CRS_EPSG_SP83, 0, FALSE, -1, "VT"}, // PCS_NAD83_Vermont
+  {32146, 32146, CRS_EPSG_SP83, 0, FALSE, -1, "VA_N"}, // PCS_NAD83_Virginia_North
+  {32147, 32147, CRS_EPSG_SP83, 0, FALSE, -1, "VA_S"}, // PCS_NAD83_Virginia_South
+  {32148, 32148, CRS_EPSG_SP83, 0, FALSE, -1, "WA_N"}, // PCS_NAD83_Washington_North
+  {32149, 32149, CRS_EPSG_SP83, 0, FALSE, -1, "WA_S"}, // PCS_NAD83_Washington_South
+  {32150, 32150, CRS_EPSG_SP83, 0, FALSE, -1, "WV_N"}, // PCS_NAD83_West_Virginia_N
+  {32151, 32151, CRS_EPSG_SP83, 0, FALSE, -1, "WV_S"}, // PCS_NAD83_West_Virginia_S
+  {32152, 32152, CRS_EPSG_SP83, 0, FALSE, -1, "WI_N"}, // PCS_NAD83_Wisconsin_North
+  {32153, 32153, CRS_EPSG_SP83, 0, FALSE, -1, "WI_C"}, // PCS_NAD83_Wisconsin_Cen
+  {32154, 32154, CRS_EPSG_SP83, 0, FALSE, -1, "WI_S"}, // PCS_NAD83_Wisconsin_South
+  {32155, 32155, CRS_EPSG_SP83, 0, FALSE, -1, "WY_E"}, // PCS_NAD83_Wyoming_East
+  {32156, 32156, CRS_EPSG_SP83, 0, FALSE, -1, "WY_EC"}, // PCS_NAD83_Wyoming_E_Cen
+  {32157, 32157, CRS_EPSG_SP83, 0, FALSE, -1, "WY_WC"}, // PCS_NAD83_Wyoming_W_Cen
+  {32158, 32158, CRS_EPSG_SP83, 0, FALSE, -1, "WY_W"}, // PCS_NAD83_Wyoming_West
+  {32161, 32161, CRS_EPSG_SP83, 0, FALSE, -1, "PR"}, // PCS_NAD83_Puerto_Rico_Virgin_Is
+  {32201, 32260, CRS_EPSG_UTM, 1, TRUE, CRS_ELLIPSOID_WGS72, 0}, // PCS_WGS72_UTM_zone_1N to 60N
+  {32301, 32360, CRS_EPSG_UTM, 1, FALSE, CRS_ELLIPSOID_WGS72, 0}, // PCS_WGS72_UTM_zone_1S to 60S
+  {32401, 32460, CRS_EPSG_UTM, 1, TRUE, CRS_ELLIPSOID_WGS72, 0}, // PCS_WGS72BE_UTM_zone_1N to 60N
+  {32501, 32560, CRS_EPSG_UTM, 1, FALSE, CRS_ELLIPSOID_WGS72, 0}, // PCS_WGS72BE_UTM_zone_1S to 60S
+  {32601, 32660, CRS_EPSG_UTM, 1, TRUE, CRS_ELLIPSOID_WGS84, 0}, // PCS_WGS84_UTM_zone_1N to 60N
+  {32701, 32760, CRS_EPSG_UTM, 1, FALSE, CRS_ELLIPSOID_WGS84, 0}, // PCS_WGS84_UTM_zone_1S to 60S
+};
+
+static const I32 epsg_zone_number = sizeof(epsg_zone_list) / sizeof(CRSepsgZone);
+
+static const CRSepsgZone* find_epsg_zone(const U16 value)
+{
+  I32 lo = 0;
+  I32 hi = epsg_zone_number - 1;
+  while (lo <= hi)
+  {
+    I32 mid = (lo + hi) / 2;
+    if (value < epsg_zone_list[mid].first)
+    {
+      hi = mid - 1;
+    }
+    else if (value > epsg_zone_list[mid].last)
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      return &(epsg_zone_list[mid]);
+    }
+  }
+  return 0;
+}
+
+BOOL CRScheck::set_projection_from_EPSG_tables(const U16 value, CHAR* description)
 {
   I32 ellipsoid_id = -1;
   BOOL utm_northern = FALSE;
   I32 utm_zone = -1;
   BOOL is_mga = FALSE;
-  CHAR* sp = 0;
+  const CHAR* sp = 0;
   BOOL sp_nad27 = FALSE;
 
-  switch (value)
+  const CRSepsgZone* epsg_zone = find_epsg_zone(value);
+  if (epsg_zone)
   {
-  case 3154: // NAD83(CSRS) / UTM zone 7N
-  case 3155: // NAD83(CSRS) / UTM zone 8N
-  case 3156: // NAD83(CSRS) / UTM zone 9N
-  case 3157: // NAD83(CSRS) / UTM zone 10N
-    utm_northern = TRUE; utm_zone = value - 3154 + 7;
-    ellipsoid_id = CRS_ELLIPSOID_NAD83;
-    break;
-  case 3158: // NAD83(CSRS) / UTM zone 14N
-  case 3159: // NAD83(CSRS) / UTM zone 15N
-  case 3160: // NAD83(CSRS) / UTM zone 16N
-    utm_northern = TRUE; utm_zone = value - 3158 + 14;
-    ellipsoid_id = CRS_ELLIPSOID_NAD83;
-    break;
-  case 20137: // PCS_Adindan_UTM_zone_37N
-  case 20138: // PCS_Adindan_UTM_zone_38N
-    utm_northern = TRUE; utm_zone = value-20100;
-    break;
-  case 20437: // PCS_Ain_el_Abd_UTM_zone_37N
-  case 20438: // PCS_Ain_el_Abd_UTM_zone_38N
-  case 20439: // PCS_Ain_el_Abd_UTM_zone_39N
-    utm_northern = TRUE; utm_zone = value-20400;
-    break;                
-  case 20538: // PCS_Afgooye_UTM_zone_38N
-  case 20539: // PCS_Afgooye_UTM_zone_39N
-    utm_northern = TRUE; utm_zone = value-20500;
-    break;
-  case 20822: // PCS_Aratu_UTM_zone_22S
-  case 20823: // PCS_Aratu_UTM_zone_23S
-  case 20824: // PCS_Aratu_UTM_zone_24S
-    utm_northern = FALSE; utm_zone = value-20800;
-    break;
-  case 21148: // PCS_Batavia_UTM_zone_48S
-  case 21149: // PCS_Batavia_UTM_zone_49S
-  case 21150: // PCS_Batavia_UTM_zone_50S
-    utm_northern = FALSE; utm_zone = value-21100;
-    break;
-  case 21817: // PCS_Bogota_UTM_zone_17N
-  case 21818: // PCS_Bogota_UTM_zone_18N
-    utm_northern = TRUE; utm_zone = value-21800;
-    break;
-  case 22032: // PCS_Camacupa_UTM_32S
-  case 22033: // PCS_Camacupa_UTM_33S
-    utm_northern = FALSE; utm_zone = value-22000;
-    break; 
-  case 22332: // PCS_Carthage_UTM_zone_32N
-    utm_northern = TRUE; utm_zone = 32;
-    break; 
-  case 22523: // PCS_Corrego_Alegre_UTM_23S
-  case 22524: // PCS_Corrego_Alegre_UTM_24S
-    utm_northern = FALSE; utm_zone = value-22500;
-    break;
-  case 22832: // PCS_Douala_UTM_zone_32N
-    utm_northern = TRUE; utm_zone = 32;
-    break;
-  case 23028: // PCS_ED50_UTM_zone_28N
-  case 23029: // PCS_ED50_UTM_zone_29N
-  case 23030: 
-  case 23031: 
-  case 23032: 
-  case 23033: 
-  case 23034: 
-  case 23035: 
-  case 23036: 
-  case 23037: 
-  case 23038: // PCS_ED50_UTM_zone_38N
-    utm_northern = TRUE; utm_zone = value-23000;
-    ellipsoid_id = CRS_ELLIPSOID_Inter;
-    break;
-  case 23239: // PCS_Fahud_UTM_zone_39N
-  case 23240: // PCS_Fahud_UTM_zone_40N
-    utm_northern = TRUE; utm_zone = value-23200;
-    break;
-  case 23433: // PCS_Garoua_UTM_zone_33N
-    utm_northern = TRUE; utm_zone = 33;
-    break;
-  case 23846: // PCS_ID74_UTM_zone_46N
-  case 23847: // PCS_ID74_UTM_zone_47N
-  case 23848:
-  case 23849:
-  case 23850:
-  case 23851:
-  case 23852:
-  case 23853: // PCS_ID74_UTM_zone_53N
-    utm_northern = TRUE; utm_zone = value-23800;
-    ellipsoid_id = CRS_ELLIPSOID_ID74;
-    break;
-  case 23886: // PCS_ID74_UTM_zone_46S
-  case 23887: // PCS_ID74_UTM_zone_47S
-  case 23888:
-  case 23889:
-  case 23890:
-  case 23891:
-  case 23892:
-  case 23893:
-  case 23894: // PCS_ID74_UTM_zone_54S
-    utm_northern = FALSE; utm_zone = value-23840;
-    ellipsoid_id = CRS_ELLIPSOID_ID74;
-    break;
-  case 23947: // PCS_Indian_1954_UTM_47N
-  case 23948: // PCS_Indian_1954_UTM_48N
-    utm_northern = TRUE; utm_zone = value-23900;
-    break;
-  case 24047: // PCS_Indian_1975_UTM_47N
-  case 24048: // PCS_Indian_1975_UTM_48N
-    utm_northern = TRUE; utm_zone = value-24000;
-    break;
-  case 24547: // PCS_Kertau_UTM_zone_47N
-  case 24548: // PCS_Kertau_UTM_zone_48N
-    utm_northern = TRUE; utm_zone = value-24500;
-    break;
-  case 24720: // PCS_La_Canoa_UTM_zone_20N
-  case 24721: // PCS_La_Canoa_UTM_zone_21N
-    utm_northern = TRUE; utm_zone = value-24700;
-    break;
-  case 24818: // PCS_PSAD56_UTM_zone_18N
-  case 24819: // PCS_PSAD56_UTM_zone_19N
-  case 24820: // PCS_PSAD56_UTM_zone_20N
-  case 24821: // PCS_PSAD56_UTM_zone_21N
-    utm_northern = TRUE; utm_zone = value-24800;
-    break;
-  case 24877: // PCS_PSAD56_UTM_zone_17S
-  case 24878: // PCS_PSAD56_UTM_zone_18S
-  case 24879: // PCS_PSAD56_UTM_zone_19S
-  case 24880: // PCS_PSAD56_UTM_zone_20S
-    utm_northern = FALSE; utm_zone = value-24860;
-    break;
-  case 25231: // PCS_Lome_UTM_zone_31N
-    utm_northern = TRUE; utm_zone = 31;
-    break;
-  case 25828: // PCS_ETRS89_UTM_zone_28N
-  case 25829: // PCS_ETRS89_UTM_zone_29N
-  case 25830: // PCS_ETRS89_UTM_zone_30N
-  case 25831: // PCS_ETRS89_UTM_zone_31N
-  case 25832: // PCS_ETRS89_UTM_zone_32N
-  case 25833: // PCS_ETRS89_UTM_zone_33N
-  case 25834: // PCS_ETRS89_UTM_zone_34N
-  case 25835: // PCS_ETRS89_UTM_zone_35N
-  case 25836: // PCS_ETRS89_UTM_zone_36N
-  case 25837: // PCS_ETRS89_UTM_zone_37N
-  case 25838: // PCS_ETRS89_UTM_zone_38N
-    utm_northern = TRUE; utm_zone = value-25800;
-    ellipsoid_id = CRS_ELLIPSOID_NAD83;
-    break;
-  case 25932: // PCS_Malongo_1987_UTM_32S
-    utm_northern = FALSE; utm_zone = 32;
-    break;
-  case 26237: // PCS_Massawa_UTM_zone_37N
-    utm_northern = TRUE; utm_zone = 37;
-    break;
-  case 26331: // PCS_Minna_UTM_zone_31N
-  case 26332: // PCS_Minna_UTM_zone_32N
-    utm_northern = TRUE; utm_zone = value-26300;
-    break;
-  case 26432: // PCS_Mhast_UTM_zone_32S
-    utm_northern = FALSE; utm_zone = 32;
-    break;
-  case 26632: // PCS_M_poraloko_UTM_32N
-    utm_northern = TRUE; utm_zone = 32;
-    break;
-  case 26692: // PCS_Minna_UTM_zone_32S
-    utm_northern = FALSE; utm_zone = 32;
-    break;
-  case 26703: // PCS_NAD27_UTM_zone_3N
-  case 26704: // PCS_NAD27_UTM_zone_4N
-  case 26705: // PCS_NAD27_UTM_zone_5N
-  case 26706: // PCS_NAD27_UTM_zone_6N
-  case 26707: // PCS_NAD27_UTM_zone_7N
-  case 26708: // PCS_NAD27_UTM_zone_7N
-  case 26709: // PCS_NAD27_UTM_zone_9N
-  case 26710: // PCS_NAD27_UTM_zone_10N
-  case 26711: // PCS_NAD27_UTM_zone_11N
-  case 26712: // PCS_NAD27_UTM_zone_12N
-  case 26713: // PCS_NAD27_UTM_zone_13N
-  case 26714: // PCS_NAD27_UTM_zone_14N
-  case 26715: // PCS_NAD27_UTM_zone_15N
-  case 26716: // PCS_NAD27_UTM_zone_16N
-  case 26717: // PCS_NAD27_UTM_zone_17N
-  case 26718: // PCS_NAD27_UTM_zone_18N
-  case 26719: // PCS_NAD27_UTM_zone_19N
-  case 26720: // PCS_NAD27_UTM_zone_20N
-  case 26721: // PCS_NAD27_UTM_zone_21N
-  case 26722: // PCS_NAD27_UTM_zone_22N
-    utm_northern = TRUE; utm_zone = value-26700;
-    ellipsoid_id = CRS_ELLIPSOID_NAD27;
-    break;
-  case 26729: // PCS_NAD27_Alabama_East
-    sp_nad27 = TRUE; sp = "AL_E";
-    break;
-  case 26730: // PCS_NAD27_Alabama_West
-    sp_nad27 = TRUE; sp = "AL_W";
-    break;
-  case 26731: // PCS_NAD27_Alaska_zone_1
-    sp_nad27 = TRUE; sp = "AK_1";
-    break;
-  case 26732: // PCS_NAD27_Alaska_zone_2
-    sp_nad27 = TRUE; sp = "AK_2";
-    break;
-  case 26733: // PCS_NAD27_Alaska_zone_3
-    sp_nad27 = TRUE; sp = "AK_3";
-    break;
-  case 26734: // PCS_NAD27_Alaska_zone_4
-    sp_nad27 = TRUE; sp = "AK_4";
-    break;
-  case 26735: // PCS_NAD27_Alaska_zone_5
-    sp_nad27 = TRUE; sp = "AK_5";
-    break;
-  case 26736: // PCS_NAD27_Alaska_zone_6
-    sp_nad27 = TRUE; sp = "AK_6";
-    break;
-  case 26737: // PCS_NAD27_Alaska_zone_7
-    sp_nad27 = TRUE; sp = "AK_7";
-    break;
-  case 26738: // PCS_NAD27_Alaska_zone_8
-    sp_nad27 = TRUE; sp = "AK_8";
-    break;
-  case 26739: // PCS_NAD27_Alaska_zone_9
-    sp_nad27 = TRUE; sp = "AK_9";
-    break;
-  case 26740: // PCS_NAD27_Alaska_zone_10
-    sp_nad27 = TRUE; sp = "AK_10";
-    break;
-  case 26741: // PCS_NAD27_California_I
-    sp_nad27 = TRUE; sp = "CA_I";
-    break;
-  case 26742: // PCS_NAD27_California_II
-    sp_nad27 = TRUE; sp = "CA_II";
-    break;
-  case 26743: // PCS_NAD27_California_III
-    sp_nad27 = TRUE; sp = "CA_III";
-    break;
-  case 26744: // PCS_NAD27_California_IV
-    sp_nad27 = TRUE; sp = "CA_IV";
-    break;
-  case 26745: // PCS_NAD27_California_V
-    sp_nad27 = TRUE; sp = "CA_V";
-    break;
-  case 26746: // PCS_NAD27_California_VI
-    sp_nad27 = TRUE; sp = "CA_VI";
-    break;
-  case 26747: // PCS_NAD27_California_VII
-    sp_nad27 = TRUE; sp = "CA_VII";
-    break;
-  case 26748: // PCS_NAD27_Arizona_East
-    sp_nad27 = TRUE; sp = "AZ_E";
-    break;
-  case 26749: // PCS_NAD27_Arizona_Central
-    sp_nad27 = TRUE; sp = "AZ_C";
-    break;
-  case 26750: // PCS_NAD27_Arizona_West
-    sp_nad27 = TRUE; sp = "AZ_W";
-    break;
-  case 26751: // PCS_NAD27_Arkansas_North
-    sp_nad27 = TRUE; sp = "AR_N";
-    break;
-  case 26752: // PCS_NAD27_Arkansas_South
-    sp_nad27 = TRUE; sp = "AR_S";
-    break;
-  case 26753: // PCS_NAD27_Colorado_North
-    sp_nad27 = TRUE; sp = "CO_N";
-    break;
-  case 26754: // PCS_NAD27_Colorado_Central
-    sp_nad27 = TRUE; sp = "CO_C";
-    break;
-  case 26755: // PCS_NAD27_Colorado_South
-    sp_nad27 = TRUE; sp = "CO_S";
-    break;
-  case 26756: // PCS_NAD27_Connecticut
-    sp_nad27 = TRUE; sp = "CT";
-    break;
-  case 26757: // PCS_NAD27_Delaware
-    sp_nad27 = TRUE; sp = "DE";
-    break;
-  case 26758: // PCS_NAD27_Florida_East
-    sp_nad27 = TRUE; sp = "FL_E";
-    break;
-  case 26759: // PCS_NAD27_Florida_West
-    sp_nad27 = TRUE; sp = "FL_W";
-    break;
-  case 26760: // PCS_NAD27_Florida_North
-    sp_nad27 = TRUE; sp = "FL_N";
-    break;
-  case 26761: // PCS_NAD27_Hawaii_zone_1
-    sp_nad27 = TRUE; sp = "HI_1";
-    break;
-  case 26762: // PCS_NAD27_Hawaii_zone_2
-    sp_nad27 = TRUE; sp = "HI_2";
-    break;
-  case 26763: // PCS_NAD27_Hawaii_zone_3
-    sp_nad27 = TRUE; sp = "HI_3";
-    break;
-  case 26764: // PCS_NAD27_Hawaii_zone_4
-    sp_nad27 = TRUE; sp = "HI_4";
-    break;
-  case 26765: // PCS_NAD27_Hawaii_zone_5
-    sp_nad27 = TRUE; sp = "HI_5";
-    break;
-  case 26766: // PCS_NAD27_Georgia_East
-    sp_nad27 = TRUE; sp = "GA_E";
-    break;
-  case 26767: // PCS_NAD27_Georgia_West
-    sp_nad27 = TRUE; sp = "GA_W";
-    break;
-  case 26768: // PCS_NAD27_Idaho_East
-    sp_nad27 = TRUE; sp = "ID_E";
-    break;
-  case 26769: // PCS_NAD27_Idaho_Central
-    sp_nad27 = TRUE; sp = "ID_C";
-    break;
-  case 26770: // PCS_NAD27_Idaho_West
-    sp_nad27 = TRUE; sp = "ID_W";
-    break;
-  case 26771: // PCS_NAD27_Illinois_East
-    sp_nad27 = TRUE; sp = "IL_E";
-    break;
-  case 26772: // PCS_NAD27_Illinois_West
-    sp_nad27 = TRUE; sp = "IL_W";
-    break;
-  case 26773: // PCS_NAD27_Indiana_East
-    sp_nad27 = TRUE; sp = "IN_E";
-    break;
-  case 26774: // PCS_NAD27_Indiana_West
-    sp_nad27 = TRUE; sp = "IN_W";
-    break;
-  case 26775: // PCS_NAD27_Iowa_North
-    sp_nad27 = TRUE; sp = "IA_N";
-    break;
-  case 26776: // PCS_NAD27_Iowa_South
-    sp_nad27 = TRUE; sp = "IA_S";
-    break;
-  case 26777: // PCS_NAD27_Kansas_North
-    sp_nad27 = TRUE; sp = "KS_N";
-    break;
-  case 26778: // PCS_NAD27_Kansas_South
-    sp_nad27 = TRUE; sp = "KS_S";
-    break;
-  case 26779: // PCS_NAD27_Kentucky_North
-    sp_nad27 = TRUE; sp = "KY_N";
-    break;
-  case 26780: // PCS_NAD27_Kentucky_South
-    sp_nad27 = TRUE; sp = "KY_S";
-    break;
-  case 26781: // PCS_NAD27_Louisiana_North
-    sp_nad27 = TRUE; sp = "LA_N";
-    break;
-  case 26782: // PCS_NAD27_Louisiana_South
-    sp_nad27 = TRUE; sp = "LA_S";
-    break;
-  case 26783: // PCS_NAD27_Maine_East
-    sp_nad27 = TRUE; sp = "ME_E";
-    break;
-  case 26784: // PCS_NAD27_Maine_West
-    sp_nad27 = TRUE; sp = "ME_W";
-    break;
-  case 26785: // PCS_NAD27_Maryland
-    sp_nad27 = TRUE; sp = "MD";
-    break;
-  case 26786: // PCS_NAD27_Massachusetts
-    sp_nad27 = TRUE; sp = "M_M";
-    break;
-  case 26787: // PCS_NAD27_Massachusetts_Is
-    sp_nad27 = TRUE; sp = "M_I";
-    break;
-  case 26788: // PCS_NAD27_Michigan_North
-    sp_nad27 = TRUE; sp = "MI_N";
-    break;
-  case 26789: // PCS_NAD27_Michigan_Central
-    sp_nad27 = TRUE; sp = "MI_C";
-    break;
-  case 26790: // PCS_NAD27_Michigan_South
-    sp_nad27 = TRUE; sp = "MI_S";
-    break;
-  case 26791: // PCS_NAD27_Minnesota_North
-    sp_nad27 = TRUE; sp = "MN_N";
-    break;
-  case 26792: // PCS_NAD27_Minnesota_Cent
-    sp_nad27 = TRUE; sp = "MN_C";
-    break;
-  case 26793: // PCS_NAD27_Minnesota_South
-    sp_nad27 = TRUE; sp = "MN_S";
-    break;
-  case 26794: // PCS_NAD27_Mississippi_East
-    sp_nad27 = TRUE; sp = "MS_E";
-    break;
-  case 26795: // PCS_NAD27_Mississippi_West
-    sp_nad27 = TRUE; sp = "MS_W";
-    break;
-  case 26796: // PCS_NAD27_Missouri_East
-    sp_nad27 = TRUE; sp = "MO_E";
-    break;
-  case 26797: // PCS_NAD27_Missouri_Central
-    sp_nad27 = TRUE; sp = "MO_C";
-    break;
-  case 26798: // PCS_NAD27_Missouri_West
-    sp_nad27 = TRUE; sp = "MO_W";
-    break;
-  case 26903: // PCS_NAD83_UTM_zone_3N
-  case 26904: // PCS_NAD83_UTM_zone_4N
-  case 26905: // PCS_NAD83_UTM_zone_5N
-  case 26906: // PCS_NAD83_UTM_zone_6N
-  case 26907: // PCS_NAD83_UTM_zone_7N
-  case 26908: // PCS_NAD83_UTM_zone_7N
-  case 26909: // PCS_NAD83_UTM_zone_9N
-  case 26910: // PCS_NAD83_UTM_zone_10N
-  case 26911: // PCS_NAD83_UTM_zone_11N
-  case 26912: // PCS_NAD83_UTM_zone_12N
-  case 26913: // PCS_NAD83_UTM_zone_13N
-  case 26914: // PCS_NAD83_UTM_zone_14N
-  case 26915: // PCS_NAD83_UTM_zone_15N
-  case 26916: // PCS_NAD83_UTM_zone_16N
-  case 26917: // PCS_NAD83_UTM_zone_17N
-  case 26918: // PCS_NAD83_UTM_zone_18N
-  case 26919: // PCS_NAD83_UTM_zone_19N
-  case 26920: // PCS_NAD83_UTM_zone_20N
-  case 26921: // PCS_NAD83_UTM_zone_21N
-  case 26922: // PCS_NAD83_UTM_zone_22N
-  case 26923: // PCS_NAD83_UTM_zone_23N
-    utm_northern = TRUE; utm_zone = value-26900;
-    ellipsoid_id = CRS_ELLIPSOID_NAD83;
-    break;
-  case 26929: // PCS_NAD83_Alabama_East
-    sp_nad27 = FALSE; sp = "AL_E";
-    break;
-  case 26930: // PCS_NAD83_Alabama_West
-    sp_nad27 = FALSE; sp = "AL_W";
-    break;
-  case 26931: // PCS_NAD83_Alaska_zone_1
-    sp_nad27 = FALSE; sp = "AK_1";
-    break;
-  case 26932: // PCS_NAD83_Alaska_zone_2
-    sp_nad27 = FALSE; sp = "AK_2";
-    break;
-  case 26933: // PCS_NAD83_Alaska_zone_3
-    sp_nad27 = FALSE; sp = "AK_3";
-    break;
-  case 26934: // PCS_NAD83_Alaska_zone_4
-    sp_nad27 = FALSE; sp = "AK_4";
-    break;
-  case 26935: // PCS_NAD83_Alaska_zone_5
-    sp_nad27 = FALSE; sp = "AK_5";
-    break;
-  case 26936: // PCS_NAD83_Alaska_zone_6
-    sp_nad27 = FALSE; sp = "AK_6";
-    break;
-  case 26937: // PCS_NAD83_Alaska_zone_7
-    sp_nad27 = FALSE; sp = "AK_7";
-    break;
-  case 26938: // PCS_NAD83_Alaska_zone_8
-    sp_nad27 = FALSE; sp = "AK_8";
-    break;
-  case 26939: // PCS_NAD83_Alaska_zone_9
-    sp_nad27 = FALSE; sp = "AK_9";
-    break;
-  case 26940: // PCS_NAD83_Alaska_zone_10
-    sp_nad27 = FALSE; sp = "AK_10";
-    break;
-  case 26941: // PCS_NAD83_California_I
-    sp_nad27 = FALSE; sp = "CA_I";
-    break;
-  case 26942: // PCS_NAD83_California_II
-    sp_nad27 = FALSE; sp = "CA_II";
-    break;
-  case 26943: // PCS_NAD83_California_III
-    sp_nad27 = FALSE; sp = "CA_III";
-    break;
-  case 26944: // PCS_NAD83_California_IV
-    sp_nad27 = FALSE; sp = "CA_IV";
-    break;
-  case 26945: // PCS_NAD83_California_V
-    sp_nad27 = FALSE; sp = "CA_V";
-    break;
-  case 26946: // PCS_NAD83_California_VI
-    sp_nad27 = FALSE; sp = "CA_VI";
-    break;
-  case 26947: // PCS_NAD83_California_VII
-    sp_nad27 = FALSE; sp = "CA_VII";
-    break;
-  case 26948: // PCS_NAD83_Arizona_East
-    sp_nad27 = FALSE; sp = "AZ_E";
-    break;
-  case 26949: // PCS_NAD83_Arizona_Central
-    sp_nad27 = FALSE; sp = "AZ_C";
-    break;
-  case 26950: // PCS_NAD83_Arizona_West
-    sp_nad27 = FALSE; sp = "AZ_W";
-    break;
-  case 26951: // PCS_NAD83_Arkansas_North
-    sp_nad27 = FALSE; sp = "AR_N";
-    break;
-  case 26952: // PCS_NAD83_Arkansas_South
-    sp_nad27 = FALSE; sp = "AR_S";
-    break;
-  case 26953: // PCS_NAD83_Colorado_North
-    sp_nad27 = FALSE; sp = "CO_N";
-    break;
-  case 26954: // PCS_NAD83_Colorado_Central
-    sp_nad27 = FALSE; sp = "CO_C";
-    break;
-  case 26955: // PCS_NAD83_Colorado_South
-    sp_nad27 = FALSE; sp = "CO_S";
-    break;
-  case 26956: // PCS_NAD83_Connecticut
-    sp_nad27 = FALSE; sp = "CT";
-    break;
-  case 26957: // PCS_NAD83_Delaware
-    sp_nad27 = FALSE; sp = "DE";
-    break;
-  case 26958: // PCS_NAD83_Florida_East
-    sp_nad27 = FALSE; sp = "FL_E";
-    break;
-  case 26959: // PCS_NAD83_Florida_West
-    sp_nad27 = FALSE; sp = "FL_W";
-    break;
-  case 26960: // PCS_NAD83_Florida_North
-    sp_nad27 = FALSE; sp = "FL_N";
-    break;
-  case 26961: // PCS_NAD83_Hawaii_zone_1
-    sp_nad27 = FALSE; sp = "HI_1";
-    break;
-  case 26962: // PCS_NAD83_Hawaii_zone_2
-    sp_nad27 = FALSE; sp = "HI_2";
-    break;
-  case 26963: // PCS_NAD83_Hawaii_zone_3
-    sp_nad27 = FALSE; sp = "HI_3";
-    break;
-  case 26964: // PCS_NAD83_Hawaii_zone_4
-    sp_nad27 = FALSE; sp = "HI_4";
-    break;
-  case 26965: // PCS_NAD83_Hawaii_zone_5
-    sp_nad27 = FALSE; sp = "HI_5";
-    break;
-  case 26966: // PCS_NAD83_Georgia_East
-    sp_nad27 = FALSE; sp = "GA_E";
-    break;
-  case 26967: // PCS_NAD83_Georgia_West
-    sp_nad27 = FALSE; sp = "GA_W";
-    break;
-  case 26968: // PCS_NAD83_Idaho_East
-    sp_nad27 = FALSE; sp = "ID_E";
-    break;
-  case 26969: // PCS_NAD83_Idaho_Central
-    sp_nad27 = FALSE; sp = "ID_C";
-    break;
-  case 26970: // PCS_NAD83_Idaho_West
-    sp_nad27 = FALSE; sp = "ID_W";
-    break;
-  case 26971: // PCS_NAD83_Illinois_East
-    sp_nad27 = FALSE; sp = "IL_E";
-    break;
-  case 26972: // PCS_NAD83_Illinois_West
-    sp_nad27 = FALSE; sp = "IL_W";
-    break;
-  case 26973: // PCS_NAD83_Indiana_East
-    sp_nad27 = FALSE; sp = "IN_E";
-    break;
-  case 26974: // PCS_NAD83_Indiana_West
-    sp_nad27 = FALSE; sp = "IN_W";
-    break;
-  case 26975: // PCS_NAD83_Iowa_North
-    sp_nad27 = FALSE; sp = "IA_N";
-    break;
-  case 26976: // PCS_NAD83_Iowa_South
-    sp_nad27 = FALSE; sp = "IA_S";
-    break;
-  case 26977: // PCS_NAD83_Kansas_North
-    sp_nad27 = FALSE; sp = "KS_N";
-    break;
-  case 26978: // PCS_NAD83_Kansas_South
-    sp_nad27 = FALSE; sp = "KS_S";
-    break;
-  case 26979: // PCS_NAD83_Kentucky_North
-    sp_nad27 = FALSE; sp = "KY_N";
-    break;
-  case 26980: // PCS_NAD83_Kentucky_South
-    sp_nad27 = FALSE; sp = "KY_S";
-    break;
-  case 26981: // PCS_NAD83_Louisiana_North
-    sp_nad27 = FALSE; sp = "LA_N";
-    break;
-  case 26982: // PCS_NAD83_Louisiana_South
-    sp_nad27 = FALSE; sp = "LA_S";
-    break;
-  case 26983: // PCS_NAD83_Maine_East
-    sp_nad27 = FALSE; sp = "ME_E";
-    break;
-  case 26984: // PCS_NAD83_Maine_West
-    sp_nad27 = FALSE; sp = "ME_W";
-    break;
-  case 26985: // PCS_NAD83_Maryland
-    sp_nad27 = FALSE; sp = "MD";
-    break;
-  case 26986: // PCS_NAD83_Massachusetts
-    sp_nad27 = FALSE; sp = "M_M";
-    break;
-  case 26987: // PCS_NAD83_Massachusetts_Is
-    sp_nad27 = FALSE; sp = "M_I";
-    break;
-  case 26988: // PCS_NAD83_Michigan_North
-    sp_nad27 = FALSE; sp = "MI_N";
-    break;
-  case 26989: // PCS_NAD83_Michigan_Central
-    sp_nad27 = FALSE; sp = "MI_C";
-    break;
-  case 26990: // PCS_NAD83_Michigan_South
-    sp_nad27 = FALSE; sp = "MI_S";
-    break;
-  case 26991: // PCS_NAD83_Minnesota_North
-    sp_nad27 = FALSE; sp = "MN_N";
-    break;
-  case 26992: // PCS_NAD83_Minnesota_Cent
-    sp_nad27 = FALSE; sp = "MN_C";
-    break;
-  case 26993: // PCS_NAD83_Minnesota_South
-    sp_nad27 = FALSE; sp = "MN_S";
-    break;
-  case 26994: // PCS_NAD83_Mississippi_East
-    sp_nad27 = FALSE; sp = "MS_E";
-    break;
-  case 26995: // PCS_NAD83_Mississippi_West
-    sp_nad27 = FALSE; sp = "MS_W";
-    break;
-  case 26996: // PCS_NAD83_Missouri_East
-    sp_nad27 = FALSE; sp = "MO_E";
-    break;
-  case 26997: // PCS_NAD83_Missouri_Central
-    sp_nad27 = FALSE; sp = "MO_C";
-    break;
-  case 26998: // PCS_NAD83_Missouri_West
-    sp_nad27 = FALSE; sp = "MO_W";
-    break;
-  case 27700:
+    if ((epsg_zone->kind == CRS_EPSG_UTM) || (epsg_zone->kind == CRS_EPSG_MGA))
+    {
+      utm_northern = epsg_zone->northern;
+      utm_zone = epsg_zone->zone + (value - epsg_zone->first);
+      is_mga = (epsg_zone->kind == CRS_EPSG_MGA);
+    }
+    else
+    {
+      sp_nad27 = (epsg_zone->kind == CRS_EPSG_SP27);
+      sp = epsg_zone->sp;
+    }
+    ellipsoid_id = epsg_zone->ellipsoid_id;
+  }
+
+  if (ellipsoid_id == -1)
+  {
+    if (utm_zone != -1) ellipsoid_id = CRS_ELLIPSOID_WGS84;
+    else if (sp != 0) ellipsoid_id = (sp_nad27 ? CRS_ELLIPSOID_NAD27 : CRS_ELLIPSOID_NAD83);
+  }
+
+  if (ellipsoid_id != -1)
+  {
+    set_ellipsoid(ellipsoid_id, TRUE);
+  }
+
+  if (utm_zone != -1)
+  {
+    if (is_mga)
+    {
+      if (set_mga_projection(utm_zone, utm_northern, TRUE, description))
+      {
+        return TRUE;
+      }
+    }
+    else
+    {
+      if (set_utm_projection(utm_zone, utm_northern, TRUE, description))
+      {
+        return TRUE;
+      }
+    }
+  }
+
+  if (sp)
+  {
+    // the zone listed for the code itself tells whether it is LCC or TM
+
+    U32 list;
+    I32 index = state_plane_index.find(value, &list);
+    if ((index != -1) && (strcmp(sp, state_plane_zone(list, index)) == 0))
+    {
+      if (sp_nad27 && (list == CRS_STATE_PLANE_LCC_NAD27))
+      {
+        return set_state_plane_nad27_lcc(sp, TRUE, description);
+      }
+      else if (sp_nad27 && (list == CRS_STATE_PLANE_TM_NAD27))
+      {
+        return set_state_plane_nad27_tm(sp, TRUE, description);
+      }
+      else if (!sp_nad27 && (list == CRS_STATE_PLANE_LCC_NAD83))
+      {
+        return set_state_plane_nad83_lcc(sp, TRUE, description);
+      }
+      else if (!sp_nad27 && (list == CRS_STATE_PLANE_TM_NAD83))
+      {
+        return set_state_plane_nad83_tm(sp, TRUE, description);
+      }
+    }
+
+    // otherwise try both projections for the zone name
+
+    if (sp_nad27)
+    {
+      if (set_state_plane_nad27_lcc(sp, TRUE, description))
+      {
+        return TRUE;
+      }
+      if (set_state_plane_nad27_tm(sp, TRUE, description))
+      {
+        return TRUE;
+      }
+    }
+    else
+    {
+      if (set_state_plane_nad83_lcc(sp, TRUE, description))
+      {
+        return TRUE;
+      }
+      if (set_state_plane_nad83_tm(sp, TRUE, description))
+      {
+        return TRUE;
+      }
+    }
+  }
+
+  if (value == EPSG_IRENET95_Irish_Transverse_Mercator)
+  {
+    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
+    set_transverse_mercator_projection(600000.0, 750000.0, 53.5, -8.0, 0.99982, TRUE, 0); // "IRENET95 / Irish Transverse Mercator"
+    set_coordinates_in_meter(TRUE);
+    if (description) sprintf(description, "IRENET95 / Irish Transverse Mercator");
+    return TRUE;
+  }
+  else if (value == EPSG_ETRS89_Poland_CS92)
+  {
+    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
+    set_transverse_mercator_projection(500000.0, -5300000.0, 0.0, 19.0, 0.9993, TRUE, 0); // "ETRS89 / Poland CS92"
+    set_coordinates_in_meter(TRUE);
+    if (description) sprintf(description, "ETRS89 / Poland CS92");
+    return TRUE;
+  }
+  else if (value == EPSG_NZGD2000)
+  {
+    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
+    set_transverse_mercator_projection(1600000.0, 10000000.0, 0.0, 173.0, 0.9996, TRUE, 0); // "NZGD2000 / New Zealand Transverse Mercator 2000"
+    set_coordinates_in_meter(TRUE);
+    if (description) sprintf(description, "NZGD2000");
+    return TRUE;
+  }
+  else if (value == EPSG_NAD83_Maryland_ftUS)
+  {
+    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
+    set_lambert_conformal_conic_projection(400000.0, 0.0, 37.66666666666666, -77, 37.66666666666666, 38.3, TRUE, 0); // "NAD83 / Maryland (ftUS)"
+    set_coordinates_in_survey_feet(TRUE);
+    if (description) sprintf(description, "NAD83 / Maryland (ftUS)");
+    return TRUE;
+  }
+  else if (value == EPSG_NAD83_HARN_UTM2_South_American_Samoa)
+  {
+    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
+    set_transverse_mercator_projection(500000.0, 10000000.0, 0.0, -171.0, 0.9996, TRUE, 0); // "NAD83(HARN) / UTM zone 2S (American Samoa)"
+    set_coordinates_in_meter(TRUE);
+    if (description) sprintf(description, "UTM zone 2S (American Samoa)");
+    return TRUE;
+  }
+  else if (value == EPSG_NAD83_HARN_Virginia_North_ftUS)
+  {
+    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
+    set_lambert_conformal_conic_projection(3500000.0, 2000000.0, 37.66666666666666, -78.5, 39.2, 38.03333333333333, TRUE, 0); // "NAD83(HARN) / Virginia North (ftUS)"
+    set_coordinates_in_survey_feet(TRUE);
+    if (description) sprintf(description, "NAD83(HARN) / Virginia North (ftUS)");
+    return TRUE;
+  }
+  else if (value == EPSG_NAD83_HARN_Virginia_South_ftUS)
+  {
+    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
+    set_lambert_conformal_conic_projection(3500000.0, 1000000.0, 36.33333333333334, -78.5, 37.96666666666667, 36.76666666666667, TRUE, 0); // "NAD83(HARN) / Virginia South (ftUS)"
+    set_coordinates_in_survey_feet(TRUE);
+    if (description) sprintf(description, "NAD83(HARN) / Virginia South (ftUS)");
+    return TRUE;
+  }
+  else if (value == EPSG_Reseau_Geodesique_Francais_Guyane_1995)
+  {
+    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
+    set_transverse_mercator_projection(500000.0, 0.0, 0.0, -51.0, 0.9996, TRUE, 0); // "Reseau Geodesique Francais Guyane 1995"
+    set_coordinates_in_meter(TRUE);
+    if (description) sprintf(description, "Reseau Geodesique Francais Guyane 1995");
+    return TRUE;
+  }
+  else if (value == EPSG_NAD83_Oregon_Lambert)
+  {
+    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
+    set_lambert_conformal_conic_projection(400000.0, 0.0, 41.75, -120.5, 43.0, 45.5, TRUE, 0); // "NAD83 / Oregon Lambert"
+    set_coordinates_in_meter(TRUE);
+    if (description) sprintf(description, "NAD83 / Oregon Lambert");
+    return TRUE;
+  }
+  else if (value == EPSG_NAD83_Oregon_Lambert_ft)
+  {
+    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
+    set_lambert_conformal_conic_projection(400000.0, 0.0, 41.75, -120.5, 43.0, 45.5, TRUE, 0); // "NAD83 / Oregon Lambert (ft)"
+    set_coordinates_in_feet(TRUE);
+    if (description) sprintf(description, "NAD83 / Oregon Lambert (ft)");
+    return TRUE;
+  }
+  else if (value == EPSG_SWEREF99_TM)
+  {
+    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
+    set_transverse_mercator_projection(500000.0, 0.0, 0.0, 15.0, 0.9996, TRUE, 0); // "SWEREF99 TM"
+    set_coordinates_in_meter(TRUE);
+    if (description) sprintf(description, "SWEREF99 TM");
+    return TRUE;
+  }
+  else if (value == EPSG_ETRS89_ETRS_LCC)
+  {
+    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
+    set_lambert_conformal_conic_projection(4000000.0, 2800000.0, 52.0, 10.0, 35.0, 65.0, TRUE, 0); // "ETRS89 / ETRS-LCC"
+    set_coordinates_in_meter(TRUE);
+    if (description) sprintf(description, "ETRS89 / ETRS-LCC");
+    return TRUE;
+  }
+  else if (value == EPSG_ETRS89_ETRS_TM34)
+  {
+    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
+    set_transverse_mercator_projection(500000.0, 0.0, 0.0, 21.0, 0.9996, TRUE, 0); // "ETRS89 / ETRS-TM34"
+    set_coordinates_in_meter(TRUE);
+    if (description) sprintf(description, "ETRS89 / ETRS-TM34");
+    return TRUE;
+  }
+  else if (value == EPSG_ETRS89_ETRS_TM35)
+  {
+    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
+    set_transverse_mercator_projection(500000.0, 0.0, 0.0, 27.0, 0.9996, TRUE, 0); // "ETRS89 / ETRS-TM35"
+    set_coordinates_in_meter(TRUE);
+    if (description) sprintf(description, "ETRS89 / ETRS-TM35");
+    return TRUE;
+  }
+  else if (value == EPSG_ETRS89_ETRS_TM36)
+  {
+    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
+    set_transverse_mercator_projection(500000.0, 0.0, 0.0, 33.0, 0.9996, TRUE, 0); // "ETRS89 / ETRS-TM36"
+    set_coordinates_in_meter(TRUE);
+    if (description) sprintf(description, "ETRS89 / ETRS-TM36");
+    return TRUE;
+  }
+  else if (value == EPSG_ETRS89_ETRS_TM35FIN)
+  {
+    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
+    set_transverse_mercator_projection(500000.0, 0.0, 0.0, 27.0, 0.9996, TRUE, 0); // "ETRS89 / ETRS-TM35FIN"
+    set_coordinates_in_meter(TRUE);
+    if (description) sprintf(description, "ETRS89 / ETRS-TM35FIN");
+    return TRUE;
+  }
+  else if (value == EPSG_Fiji_1956_UTM60_South)
+  {
+    set_ellipsoid(CRS_ELLIPSOID_Inter, TRUE);
+    set_utm_projection(60, FALSE, TRUE, 0); // "Fiji 1956 / UTM zone 60S"
+    set_coordinates_in_meter(TRUE);
+    if (description) sprintf(description, "Fiji 1956 / UTM zone 60S");
+  }
+  else if (value == EPSG_Fiji_1956_UTM1_South)
+  {
+    set_ellipsoid(CRS_ELLIPSOID_Inter, TRUE);
+    set_utm_projection(1, FALSE, TRUE, 0); // "Fiji 1956 / UTM zone 1S"
+    set_coordinates_in_meter(TRUE);
+    if (description) sprintf(description, "Fiji 1956 / UTM zone 1S");
+  }
+  else if (value == EPSG_Fiji_Map_Grid_1986)
+  {
+    set_ellipsoid(CRS_ELLIPSOID_WGS72, TRUE);
+    set_transverse_mercator_projection(2000000.0, 4000000.0, -17.0, 178.75, 0.99985, TRUE, 0); // "Fiji 1986 / Fiji Map Grid"
+    set_coordinates_in_meter(TRUE);
+    if (description) sprintf(description, "Fiji 1986 / Fiji Map Grid");
+    return TRUE;
+  }
+  else if (value == EPSG_NAD83_NSRS2007_Maryland_ftUS)
+  {
+    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
+    set_lambert_conformal_conic_projection(400000.0, 0.0, 37.66666666666666, -77, 39.45, 38.3, TRUE, 0); // "NAD83(NSRS2007) / Maryland (ftUS)"
+    set_coordinates_in_survey_feet(TRUE);
+    if (description) sprintf(description, "NAD83(NSRS2007) / Maryland (ftUS)");
+    return TRUE;
+  }
+  else if (value == EPSG_Slovene_National_Grid_1996)
+  {
+    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
+    set_transverse_mercator_projection(500000.0, -5000000.0, 0.0, 15.0, 0.9999, TRUE, 0); // "Slovenia 1996 / Slovene National Grid"
+    set_coordinates_in_meter(TRUE);
+    if (description) sprintf(description, "Slovenia 1996 / Slovene National Grid");
+    return TRUE;
+  }
+  else if (value == EPSG_MGI_1901_Slovene_National_Grid)
+  {
+    set_ellipsoid(3, TRUE); // Bessel 1841
+    set_transverse_mercator_projection(500000.0, -5000000.0, 0.0, 15.0, 0.9999, TRUE, 0); // "MGI 1901 / Slovene National Grid"
+    set_coordinates_in_meter(TRUE);
+    if (description) sprintf(description, "MGI 1901 / Slovene National Grid");
+    return TRUE;    
+  }
+  else if ((EPSG_RGF93_CC42 <= value) && (value <= EPSG_RGF93_CC50))
+  {
+    int v = value - EPSG_RGF93_CC42;
+    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
+    set_lambert_conformal_conic_projection(1700000.0, 1200000.0+v*1000000, 42.0+v, 3.0, 41.25+v, 42.75+v, TRUE, 0);
+    set_coordinates_in_meter(TRUE);
+    if (description) sprintf(description, "RGF93 / CC%d Reseau_Geodesique_Francais_1993", value-3900);
+    return TRUE;
+  }
+  else if ((EPSG_ETRS89_DKTM1 <= value) && (value <= EPSG_ETRS89_DKTM4))
+  {
+    int v = ((value - EPSG_ETRS89_DKTM1)%4) + 1;
+    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
+    set_transverse_mercator_projection(200000.0*v, -5000000.0, 0.0, 9.0 + (v == 1 ? 0.0 : (v == 2 ? 1.0 : (v == 3 ? 2.75 : 6.0))), 0.99998, TRUE, 0);
+    set_coordinates_in_meter(TRUE);
+    if (description) sprintf(description, "ETRS89 / DKTM%d", v);
+    return TRUE;
+  }
+  else if (value == EPSG_ETRS89_UTM32_north_zE_N)
+  {
+    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
+    set_transverse_mercator_projection(32500000.0, 0.0, 0.0, 9.0, 0.9996, TRUE, 0); // "ETRS89 / UTM zone 32N (zE-N)"
+    set_coordinates_in_meter(TRUE);
+    if (description) sprintf(description, "ETRS89 / UTM zone 32N (zE-N)");
+    return TRUE;
+  }
+  else if ((EPSG_ETRS89_NTM_zone_5 <= value) && (value <= EPSG_ETRS89_NTM_zone_30))
+  {
+    int v = value - 5100;
+    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
+    set_transverse_mercator_projection(100000.0, 1000000.0, 58.0, 0.3+v, 1.0, TRUE, 0);
+    set_coordinates_in_meter(TRUE);
+    if (description) sprintf(description, "ETRS89 / NTM zone %d", v);
+    return TRUE;
+  }
+  else if (value == EPSG_ETRS89_UTM33_north_zE_N)
+  {
+    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
+    set_transverse_mercator_projection(33500000.0, 0.0, 0.0, 15.0, 0.9996, TRUE, 0); // "ETRS89 / UTM zone 33N (zE-N)"
+    set_coordinates_in_meter(TRUE);
+    if (description) sprintf(description, "ETRS89 / UTM zone 33N (zE-N)");
+    return TRUE;
+  }
+  else if (value == EPSG_OSGB_1936)
+  {
+    set_ellipsoid(1, TRUE); // Airy 1830
+    set_transverse_mercator_projection(400000.0, -100000.0, 49.0, -2.0, 0.9996012717, TRUE, 0); // "OSGB 1936 / British National Grid"
+    set_coordinates_in_meter(TRUE);
+    if (description) sprintf(description, "OSGB 1936 / British National Grid");
+    return TRUE;
+  } 
+  else if (value == EPSG_Belgian_Lambert_1972)
+  {
+    set_ellipsoid(CRS_ELLIPSOID_Inter, TRUE);
+    set_lambert_conformal_conic_projection(150000.013, 5400088.438, 90, 4.367486666666666, 51.16666723333333, 49.8333339, TRUE, 0); // "Belge 1972 / Belgian Lambert 72"
+    set_coordinates_in_meter(TRUE);
+    if (description) sprintf(description, "Belge 1972 / Belgian Lambert 72");
+    return TRUE;
+  }
+  else if (value)
+  {
+    // check against list
+    const CHAR* epsg_description = get_epsg_table_description(value);
+    if (epsg_description)
+    {
+      if (description) sprintf(description, "%s", epsg_description);
+      return TRUE;
+    }
+    if (description) sprintf(description, "unknown EPSG code %d. please email this particular LAS/LAZ file (or at least a lasinfo report of it) to 'lasvalidator@rapidlasso.com' to have this projection added to the CRS check.", (I32)value);
+    return FALSE;
+  }
+  fprintf(stderr, "CRScheck::set_projection_from_ProjectedCSTypeGeoKey: %d not implemented\n", value);
+  return FALSE;
+}
 
+// a record of the CRS database replays what the built-in tables do for its code
+
+BOOL CRScheck::set_projection_from_database(const U16 value, CHAR* description)
+{
+  const CRSdatabaseProjection* record = CRSdatabase::find_projection(value);
+  if (record == 0)
+  {
+    return FALSE;
+  }
+
+  switch (record->type)
+  {
+  case CRS_PROJECTION_UTM:
+    if ((record->parameters[0] < 0.0) || (record->parameters[0] > 60.0))
+    {
+      return FALSE;
+    }
     break;
-  case 28348: // PCS_GDA94_MGA_zone_48
-  case 28349:
-  case 28350:
-  case 28351:
-  case 28352:
-  case 28353:
-  case 28354: // PCS_GDA94_MGA_zone_54
-  case 28355: // PCS_GDA94_MGA_zone_55
-  case 28356: // PCS_GDA94_MGA_zone_56
-  case 28357: // PCS_GDA94_MGA_zone_57
-  case 28358: // PCS_GDA94_MGA_zone_58
-    utm_northern = FALSE; utm_zone = value-28300; is_mga = TRUE;
-    ellipsoid_id = CRS_ELLIPSOID_GDA94;
-    break;
-  case 29118: // PCS_SAD69_UTM_zone_18N
-  case 29119: // PCS_SAD69_UTM_zone_19N
-  case 29120: // PCS_SAD69_UTM_zone_20N
-  case 29121: // PCS_SAD69_UTM_zone_21N
-  case 29122: // PCS_SAD69_UTM_zone_22N
-    utm_northern = TRUE; utm_zone = value-29100;
-    ellipsoid_id = CRS_ELLIPSOID_SAD69;
-    break;
-  case 29177: // PCS_SAD69_UTM_zone_17S
-  case 29178: // PCS_SAD69_UTM_zone_18S
-  case 29179: // PCS_SAD69_UTM_zone_19S
-  case 29180: // PCS_SAD69_UTM_zone_20S
-  case 29181: // PCS_SAD69_UTM_zone_21S
-  case 29182: // PCS_SAD69_UTM_zone_22S
-  case 29183: // PCS_SAD69_UTM_zone_23S
-  case 29184: // PCS_SAD69_UTM_zone_24S
-  case 29185: // PCS_SAD69_UTM_zone_25S
-    utm_northern = FALSE; utm_zone = value-29160;
-    ellipsoid_id = CRS_ELLIPSOID_SAD69;
-    break;
-  case 29220: // PCS_Sapper_Hill_UTM_20S
-  case 29221: // PCS_Sapper_Hill_UTM_21S
-    utm_northern = FALSE; utm_zone = value-29200;
-    break;
-  case 29333: // PCS_Schwarzeck_UTM_33S
-    utm_northern = FALSE; utm_zone = 33;
-    break;
-  case 29635: // PCS_Sudan_UTM_zone_35N
-  case 29636: // PCS_Sudan_UTM_zone_35N
-    utm_northern = TRUE; utm_zone = value-29600;
-    break;
-  case 29738: // PCS_Tananarive_UTM_38S
-  case 29739: // PCS_Tananarive_UTM_39S
-    utm_northern = FALSE; utm_zone = value-29700;
-    break;
-  case 29849: // PCS_Timbalai_1948_UTM_49N
-  case 29850: // PCS_Timbalai_1948_UTM_50N
-    utm_northern = TRUE; utm_zone = value-29800;
-    break;
-  case 30339: // PCS_TC_1948_UTM_zone_39N
-  case 30340: // PCS_TC_1948_UTM_zone_40N
-    utm_northern = TRUE; utm_zone = value-30300;
-    break;
-  case 30729: // PCS_Nord_Sahara_UTM_29N
-  case 30730: // PCS_Nord_Sahara_UTM_30N
-  case 30731: // PCS_Nord_Sahara_UTM_31N
-  case 30732: // PCS_Nord_Sahara_UTM_32N
-    utm_northern = TRUE; utm_zone = value-30700;
-    break;
-  case 31028: // PCS_Yoff_UTM_zone_28N
-    utm_northern = TRUE; utm_zone = 28;
-    break;
-  case 31121: // PCS_Zanderij_UTM_zone_21N
-    utm_northern = TRUE; utm_zone = 21;
-    break;
-  case 32001: // PCS_NAD27_Montana_North
-    sp_nad27 = TRUE; sp = "MT_N";
-    break;
-  case 32002: // PCS_NAD27_Montana_Central
-    sp_nad27 = TRUE; sp = "MT_C";
-    break;
-  case 32003: // PCS_NAD27_Montana_South
-    sp_nad27 = TRUE; sp = "MT_S";
-    break;
-  case 32005: // PCS_NAD27_Nebraska_North
-    sp_nad27 = TRUE; sp = "NE_N";
-    break;
-  case 32006: // PCS_NAD27_Nebraska_South
-    sp_nad27 = TRUE; sp = "NE_S";
-    break;
-  case 32007: // PCS_NAD27_Nevada_East
-    sp_nad27 = TRUE; sp = "NV_E";
-    break;
-  case 32008: // PCS_NAD27_Nevada_Central
-    sp_nad27 = TRUE; sp = "NV_C";
-    break;
-  case 32009: // PCS_NAD27_Nevada_West
-    sp_nad27 = TRUE; sp = "NV_W";
-    break;
-  case 32010: // PCS_NAD27_New_Hampshire
-    sp_nad27 = TRUE; sp = "NH";
-    break;
-  case 32011: // PCS_NAD27_New_Jersey
-    sp_nad27 = TRUE; sp = "NJ";
-    break;
-  case 32012: // PCS_NAD27_New_Mexico_East
-    sp_nad27 = TRUE; sp = "NM_E";
-    break;
-  case 32013: // PCS_NAD27_New_Mexico_Cent
-    sp_nad27 = TRUE; sp = "NM_C";
-    break;
-  case 32014: // PCS_NAD27_New_Mexico_West
-    sp_nad27 = TRUE; sp = "NM_W";
-    break;
-  case 32015: // PCS_NAD27_New_York_East
-    sp_nad27 = TRUE; sp = "NY_E";
-    break;
-  case 32016: // PCS_NAD27_New_York_Central
-    sp_nad27 = TRUE; sp = "NY_C";
-    break;
-  case 32017: // PCS_NAD27_New_York_West
-    sp_nad27 = TRUE; sp = "NY_W";
-    break;
-  case 32018: // PCS_NAD27_New_York_Long_Is
-    sp_nad27 = TRUE; sp = "NT_LI";
-    break;
-  case 32019: // PCS_NAD27_North_Carolina
-    sp_nad27 = TRUE; sp = "NC";
-    break;
-  case 32020: // PCS_NAD27_North_Dakota_N
-    sp_nad27 = TRUE; sp = "ND_N";
-    break;
-  case 32021: // PCS_NAD27_North_Dakota_S
-    sp_nad27 = TRUE; sp = "ND_S";
-    break;
-  case 32022: // PCS_NAD27_Ohio_North
-    sp_nad27 = TRUE; sp = "OH_N";
-    break;
-  case 32023: // PCS_NAD27_Ohio_South
-    sp_nad27 = TRUE; sp = "OH_S";
-    break;
-  case 32024: // PCS_NAD27_Oklahoma_North
-    sp_nad27 = TRUE; sp = "OK_N";
-    break;
-  case 32025: // PCS_NAD27_Oklahoma_South
-    sp_nad27 = TRUE; sp = "OK_S";
-    break;
-  case 32026: // PCS_NAD27_Oregon_North
-    sp_nad27 = TRUE; sp = "OR_N";
-    break;
-  case 32027: // PCS_NAD27_Oregon_South
-    sp_nad27 = TRUE; sp = "OR_S";
-    break;
-  case 32028: // PCS_NAD27_Pennsylvania_N
-    sp_nad27 = TRUE; sp = "PA_N";
-    break;
-  case 32029: // PCS_NAD27_Pennsylvania_S
-    sp_nad27 = TRUE; sp = "PA_S";
-    break;
-  case 32030: // PCS_NAD27_Rhode_Island
-    sp_nad27 = TRUE; sp = "RI";
-    break;
-  case 32031: // PCS_NAD27_South_Carolina_N
-    sp_nad27 = TRUE; sp = "SC_N";
-    break;
-  case 32033: // PCS_NAD27_South_Carolina_S
-    sp_nad27 = TRUE; sp = "SC_S";
-    break;
-  case 32034: // PCS_NAD27_South_Dakota_N
-    sp_nad27 = TRUE; sp = "SD_N";
-    break;
-  case 32035: // PCS_NAD27_South_Dakota_S
-    sp_nad27 = TRUE; sp = "SD_S";
-    break;
-  case 32036: // PCS_NAD27_Tennessee
-    sp_nad27 = TRUE; sp = "TN";
-    break;
-  case 32037: // PCS_NAD27_Texas_North
-    sp_nad27 = TRUE; sp = "TX_N";
-    break;
-  case 32038: // PCS_NAD27_Texas_North_Cen
-    sp_nad27 = TRUE; sp = "TX_NC";
-    break;
-  case 32039: // PCS_NAD27_Texas_Central
-    sp_nad27 = TRUE; sp = "TX_C";
-    break;
-  case 32040: // PCS_NAD27_Texas_South_Cen
-    sp_nad27 = TRUE; sp = "TX_SC";
-    break;
-  case 32041: // PCS_NAD27_Texas_South
-    sp_nad27 = TRUE; sp = "TX_S";
-    break;
-  case 32042: // PCS_NAD27_Utah_North
-    sp_nad27 = TRUE; sp = "UT_N";
-    break;
-  case 32043: // PCS_NAD27_Utah_Central
-    sp_nad27 = TRUE; sp = "UT_C";
-    break;
-  case 32044: // PCS_NAD27_Utah_South
-    sp_nad27 = TRUE; sp = "UT_S";
-    break;
-  case 32045: // PCS_NAD27_Vermont
-    sp_nad27 = TRUE; sp = "VT";
-    break;
-  case 32046: // PCS_NAD27_Virginia_North
-    sp_nad27 = TRUE; sp = "VA_N";
-    break;
-  case 32047: // PCS_NAD27_Virginia_South
-    sp_nad27 = TRUE; sp = "VA_S";
-    break;
-  case 32048: // PCS_NAD27_Washington_North
-    sp_nad27 = TRUE; sp = "WA_N";
-    break;
-  case 32049: // PCS_NAD27_Washington_South
-    sp_nad27 = TRUE; sp = "WA_S";
-    break;
-  case 32050: // PCS_NAD27_West_Virginia_N
-    sp_nad27 = TRUE; sp = "WV_N";
-    break;
-  case 32051: // PCS_NAD27_West_Virginia_S
-    sp_nad27 = TRUE; sp = "WV_S";
-    break;
-  case 32052: // PCS_NAD27_Wisconsin_North
-    sp_nad27 = TRUE; sp = "WI_N";
-    break;
-  case 32053: // PCS_NAD27_Wisconsin_Cen
-    sp_nad27 = TRUE; sp = "WI_C";
-    break;
-  case 32054: // PCS_NAD27_Wisconsin_South
-    sp_nad27 = TRUE; sp = "WI_S";
-    break;
-  case 32055: // PCS_NAD27_Wyoming_East
-    sp_nad27 = TRUE; sp = "WY_E";
-    break;
-  case 32056: // PCS_NAD27_Wyoming_E_Cen
-    sp_nad27 = TRUE; sp = "WY_EC";
-    break;
-  case 32057: // PCS_NAD27_Wyoming_W_Cen
-    sp_nad27 = TRUE; sp = "WY_WC";
-    break;
-  case 32058: // PCS_NAD27_Wyoming_West
-    sp_nad27 = TRUE; sp = "WY_W";
-    break;
-  case 32059: // PCS_NAD27_Puerto_Rico
-    sp_nad27 = TRUE; sp = "PR";
-    break;
-  case 32060: // PCS_NAD27_St_Croix
-    sp_nad27 = TRUE; sp = "St.Croix";
-    break;
-  case 32100: // PCS_NAD83_Montana
-    sp_nad27 = FALSE; sp = "MT";
-    break;
-  case 32104: // PCS_NAD83_Nebraska
-    sp_nad27 = FALSE; sp = "NE";
-    break;
-  case 32107: // PCS_NAD83_Nevada_East
-    sp_nad27 = FALSE; sp = "NV_E";
-    break;
-  case 32108: // PCS_NAD83_Nevada_Central
-    sp_nad27 = FALSE; sp = "NV_C";
-    break;
-  case 32109: // PCS_NAD83_Nevada_West
-    sp_nad27 = FALSE; sp = "NV_W";
-    break;
-  case 32110: // PCS_NAD83_New_Hampshire
-    sp_nad27 = FALSE; sp = "NH";
-    break;
-  case 32111: // PCS_NAD83_New_Jersey
-    sp_nad27 = FALSE; sp = "NJ";
-    break;
-  case 32112: // PCS_NAD83_New_Mexico_East
-    sp_nad27 = FALSE; sp = "NM_E";
-    break;
-  case 32113: // PCS_NAD83_New_Mexico_Cent
-    sp_nad27 = FALSE; sp = "NM_C";
-    break;
-  case 32114: // PCS_NAD83_New_Mexico_West
-    sp_nad27 = FALSE; sp = "NM_W";
-    break;
-  case 32115: // PCS_NAD83_New_York_East
-    sp_nad27 = FALSE; sp = "NY_E";
-    break;
-  case 32116: // PCS_NAD83_New_York_Central
-    sp_nad27 = FALSE; sp = "NY_C";
-    break;
-  case 32117: // PCS_NAD83_New_York_West
-    sp_nad27 = FALSE; sp = "NY_W";
-    break;
-  case 32118: // PCS_NAD83_New_York_Long_Is
-    sp_nad27 = FALSE; sp = "NT_LI";
-    break;
-  case 32119: // PCS_NAD83_North_Carolina
-    sp_nad27 = FALSE; sp = "NC";
-    break;
-  case 32120: // PCS_NAD83_North_Dakota_N
-    sp_nad27 = FALSE; sp = "ND_N";
-    break;
-  case 32121: // PCS_NAD83_North_Dakota_S
-    sp_nad27 = FALSE; sp = "ND_S";
-    break;
-  case 32122: // PCS_NAD83_Ohio_North
-    sp_nad27 = FALSE; sp = "OH_N";
-    break;
-  case 32123: // PCS_NAD83_Ohio_South
-    sp_nad27 = FALSE; sp = "OH_S";
-    break;
-  case 32124: // PCS_NAD83_Oklahoma_North
-    sp_nad27 = FALSE; sp = "OK_N";
-    break;
-  case 32125: // PCS_NAD83_Oklahoma_South
-    sp_nad27 = FALSE; sp = "OK_S";
-    break;
-  case 32126: // PCS_NAD83_Oregon_North
-    sp_nad27 = FALSE; sp = "OR_N";
-    break;
-  case 32127: // PCS_NAD83_Oregon_South
-    sp_nad27 = FALSE; sp = "OR_S";
-    break;
-  case 32128: // PCS_NAD83_Pennsylvania_N
-    sp_nad27 = FALSE; sp = "PA_N";
-    break;
-  case 32129: // PCS_NAD83_Pennsylvania_S
-    sp_nad27 = FALSE; sp = "PA_S";
-    break;
-  case 32130: // PCS_NAD83_Rhode_Island
-    sp_nad27 = FALSE; sp = "RI";
-    break;
-  case 32133: // PCS_NAD83_South_Carolina
-    sp_nad27 = FALSE; sp = "SC";
-    break;
-  case 32134: // PCS_NAD83_South_Dakota_N
-    sp_nad27 = FALSE; sp = "SD_N";
-    break;
-  case 32135: // PCS_NAD83_South_Dakota_S
-    sp_nad27 = FALSE; sp = "SD_S";
-    break;
-  case 32136: // PCS_NAD83_Tennessee
-    sp_nad27 = FALSE; sp = "TN";
-    break;
-  case 32137: // PCS_NAD83_Texas_North
-    sp_nad27 = FALSE; sp = "TX_N";
-    break;
-  case 32138: // PCS_NAD83_Texas_North_Cen
-    sp_nad27 = FALSE; sp = "TX_NC";
-    break;
-  case 32139: // PCS_NAD83_Texas_Central
-    sp_nad27 = FALSE; sp = "TX_C";
-    break;
-  case 32140: // PCS_NAD83_Texas_South_Cen
-    sp_nad27 = FALSE; sp = "TX_SC";
-    break;
-  case 32141: // PCS_NAD83_Texas_South
-    sp_nad27 = FALSE; sp = "TX_S";
-    break;
-  case 32142: // PCS_NAD83_Utah_North
-    sp_nad27 = FALSE; sp = "UT_N";
-    break;
-  case 32143: // PCS_NAD83_Utah_Central
-    sp_nad27 = FALSE; sp = "UT_C";
-    break;
-  case 32144: // PCS_NAD83_Utah_South
-    sp_nad27 = FALSE; sp = "UT_S";
-    break;
-  case 32145: // PCS_NAD83_Vermont
-    sp_nad27 = FALSE; sp = "VT";
-    break;
-  case 32146: // PCS_NAD83_Virginia_North
-    sp_nad27 = FALSE; sp = "VA_N";
-    break;
-  case 32147: // PCS_NAD83_Virginia_South
-    sp_nad27 = FALSE; sp = "VA_S";
-    break;
-  case 32148: // PCS_NAD83_Washington_North
-    sp_nad27 = FALSE; sp = "WA_N";
-    break;
-  case 32149: // PCS_NAD83_Washington_South
-    sp_nad27 = FALSE; sp = "WA_S";
-    break;
-  case 32150: // PCS_NAD83_West_Virginia_N
-    sp_nad27 = FALSE; sp = "WV_N";
-    break;
-  case 32151: // PCS_NAD83_West_Virginia_S
-    sp_nad27 = FALSE; sp = "WV_S";
-    break;
-  case 32152: // PCS_NAD83_Wisconsin_North
-    sp_nad27 = FALSE; sp = "WI_N";
-    break;
-  case 32153: // PCS_NAD83_Wisconsin_Cen
-    sp_nad27 = FALSE; sp = "WI_C";
-    break;
-  case 32154: // PCS_NAD83_Wisconsin_South
-    sp_nad27 = FALSE; sp = "WI_S";
-    break;
-  case 32155: // PCS_NAD83_Wyoming_East
-    sp_nad27 = FALSE; sp = "WY_E";
+  case CRS_PROJECTION_LCC:
+  case CRS_PROJECTION_TM:
+  case CRS_PROJECTION_LONG_LAT:
+  case CRS_PROJECTION_LAT_LONG:
+  case CRS_PROJECTION_ECEF:
+  case CRS_PROJECTION_NONE:
+  case CRSDATABASE_NO_PROJECTION:
     break;
-  case 32156: // PCS_NAD83_Wyoming_E_Cen
-    sp_nad27 = FALSE; sp = "WY_EC";
+  default:
+    return FALSE;
+  }
+
+  if (record->ellipsoid)
+  {
+    set_ellipsoid(record->ellipsoid, TRUE);
+  }
+
+  switch (record->type)
+  {
+  case CRS_PROJECTION_UTM:
+    set_utm_projection((I32)record->parameters[0], (record->parameters[1] != 0.0), TRUE);
+    ((CRSprojectionParametersUTM*)projections[0])->utm_zone_letter = (CHAR)record->parameters[2];
     break;
-  case 32157: // PCS_NAD83_Wyoming_W_Cen
-    sp_nad27 = FALSE; sp = "WY_WC";
+  case CRS_PROJECTION_LCC:
+    set_lambert_conformal_conic_projection(record->parameters[0], record->parameters[1], record->parameters[2], record->parameters[3], record->parameters[4], record->parameters[5], TRUE);
     break;
-  case 32158: // PCS_NAD83_Wyoming_West
-    sp_nad27 = FALSE; sp = "WY_W";
+  case CRS_PROJECTION_TM:
+    set_transverse_mercator_projection(record->parameters[0], record->parameters[1], record->parameters[2], record->parameters[3], record->parameters[4], TRUE);
     break;
-  case 32161: // PCS_NAD83_Puerto_Rico_Virgin_Is
-    sp_nad27 = FALSE; sp = "PR";
+  case CRS_PROJECTION_LONG_LAT:
+    set_longlat_projection(TRUE);
     break;
-  case 32201: // PCS_WGS72_UTM_zone_1N 
-  case 32202: // PCS_WGS72_UTM_zone_2N 
-  case 32203: // PCS_WGS72_UTM_zone_3N 
-  case 32204: // PCS_WGS72_UTM_zone_4N 
-  case 32205: // PCS_WGS72_UTM_zone_5N 
-  case 32206: // PCS_WGS72_UTM_zone_6N 
-  case 32207: // PCS_WGS72_UTM_zone_7N 
-  case 32208:
-  case 32209:
-  case 32210:
-  case 32211:
-  case 32212:
-  case 32213:
-  case 32214:
-  case 32215:
-  case 32216:
-  case 32217:
-  case 32218:
-  case 32219:
-  case 32220:
-  case 32221:
-  case 32222:
-  case 32223:
-  case 32224:
-  case 32225:
-  case 32226:
-  case 32227:
-  case 32228:
-  case 32229:
-  case 32230:
-  case 32231:
-  case 32232:
-  case 32233:
-  case 32234:
-  case 32235:
-  case 32236:
-  case 32237:
-  case 32238:
-  case 32239:
-  case 32240:
-  case 32241:
-  case 32242:
-  case 32243:
-  case 32244:
-  case 32245:
-  case 32246:
-  case 32247:
-  case 32248:
-  case 32249:
-  case 32250:
-  case 32251:
-  case 32252:
-  case 32253:
-  case 32254:
-  case 32255:
-  case 32256:
-  case 32257:
-  case 32258:
-  case 32259: // PCS_WGS72_UTM_zone_59N 
-  case 32260: // PCS_WGS72_UTM_zone_60N 
-    utm_northern = TRUE; utm_zone = value-32200;
-    ellipsoid_id = CRS_ELLIPSOID_WGS72;
+  case CRS_PROJECTION_LAT_LONG:
+    set_latlong_projection(TRUE);
     break;
-  case 32301: // PCS_WGS72_UTM_zone_1S
-  case 32302: // PCS_WGS72_UTM_zone_2S
-  case 32303: // PCS_WGS72_UTM_zone_3S
-  case 32304: // PCS_WGS72_UTM_zone_4S
-  case 32305: // PCS_WGS72_UTM_zone_5S
-  case 32306: // PCS_WGS72_UTM_zone_6S
-  case 32307: // PCS_WGS72_UTM_zone_7S
-  case 32308:
-  case 32309:
-  case 32310:
-  case 32311:
-  case 32312:
-  case 32313:
-  case 32314:
-  case 32315:
-  case 32316:
-  case 32317:
-  case 32318:
-  case 32319:
-  case 32320:
-  case 32321:
-  case 32322:
-  case 32323:
-  case 32324:
-  case 32325:
-  case 32326:
-  case 32327:
-  case 32328:
-  case 32329:
-  case 32330:
-  case 32331:
-  case 32332:
-  case 32333:
-  case 32334:
-  case 32335:
-  case 32336:
-  case 32337:
-  case 32338:
-  case 32339:
-  case 32340:
-  case 32341:
-  case 32342:
-  case 32343:
-  case 32344:
-  case 32345:
-  case 32346:
-  case 32347:
-  case 32348:
-  case 32349:
-  case 32350:
-  case 32351:
-  case 32352:
-  case 32353:
-  case 32354:
-  case 32355:
-  case 32356:
-  case 32357:
-  case 32358:
-  case 32359: // PCS_WGS72_UTM_zone_59S
-  case 32360: // PCS_WGS72_UTM_zone_60S
-    utm_northern = FALSE; utm_zone = value-32300;
-    ellipsoid_id = CRS_ELLIPSOID_WGS72;
+  case CRS_PROJECTION_ECEF:
+    set_ecef_projection(TRUE);
     break;
-  case 32401: // PCS_WGS72BE_UTM_zone_1N
-  case 32402: // PCS_WGS72BE_UTM_zone_2N
-  case 32403: // PCS_WGS72BE_UTM_zone_3N
-  case 32404: // PCS_WGS72BE_UTM_zone_4N
-  case 32405: // PCS_WGS72BE_UTM_zone_5N
-  case 32406: // PCS_WGS72BE_UTM_zone_6N
-  case 32407: // PCS_WGS72BE_UTM_zone_7N
-  case 32408:
-  case 32409:
-  case 32410:
-  case 32411:
-  case 32412:
-  case 32413:
-  case 32414:
-  case 32415:
-  case 32416:
-  case 32417:
-  case 32418:
-  case 32419:
-  case 32420:
-  case 32421:
-  case 32422:
-  case 32423:
-  case 32424:
-  case 32425:
-  case 32426:
-  case 32427:
-  case 32428:
-  case 32429:
-  case 32430:
-  case 32431:
-  case 32432:
-  case 32433:
-  case 32434:
-  case 32435:
-  case 32436:
-  case 32437:
-  case 32438:
-  case 32439:
-  case 32440:
-  case 32441:
-  case 32442:
-  case 32443:
-  case 32444:
-  case 32445:
-  case 32446:
-  case 32447:
-  case 32448:
-  case 32449:
-  case 32450:
-  case 32451:
-  case 32452:
-  case 32453:
-  case 32454:
-  case 32455:
-  case 32456:
-  case 32457:
-  case 32458:
-  case 32459: // PCS_WGS72BE_UTM_zone_59N
-  case 32460: // PCS_WGS72BE_UTM_zone_60N
-    utm_northern = TRUE; utm_zone = value-32400;
-    ellipsoid_id = CRS_ELLIPSOID_WGS72;
+  case CRS_PROJECTION_NONE:
+    set_no_projection(TRUE);
     break;
-  case 32501: // PCS_WGS72BE_UTM_zone_1S
-  case 32502: // PCS_WGS72BE_UTM_zone_2S
-  case 32503: // PCS_WGS72BE_UTM_zone_3S
-  case 32504: // PCS_WGS72BE_UTM_zone_4S
-  case 32505: // PCS_WGS72BE_UTM_zone_5S
-  case 32506: // PCS_WGS72BE_UTM_zone_6S
-  case 32507: // PCS_WGS72BE_UTM_zone_7S
-  case 32508:
-  case 32509:
-  case 32510:
-  case 32511:
-  case 32512:
-  case 32513:
-  case 32514:
-  case 32515:
-  case 32516:
-  case 32517:
-  case 32518:
-  case 32519:
-  case 32520:
-  case 32521:
-  case 32522:
-  case 32523:
-  case 32524:
-  case 32525:
-  case 32526:
-  case 32527:
-  case 32528:
-  case 32529:
-  case 32530:
-  case 32531:
-  case 32532:
-  case 32533:
-  case 32534:
-  case 32535:
-  case 32536:
-  case 32537:
-  case 32538:
-  case 32539:
-  case 32540:
-  case 32541:
-  case 32542:
-  case 32543:
-  case 32544:
-  case 32545:
-  case 32546:
-  case 32547:
-  case 32548:
-  case 32549:
-  case 32550:
-  case 32551:
-  case 32552:
-  case 32553:
-  case 32554:
-  case 32555:
-  case 32556:
-  case 32557:
-  case 32558:
-  case 32559: // PCS_WGS72BE_UTM_zone_59S
-  case 32560: // PCS_WGS72BE_UTM_zone_60S
-    utm_northern = FALSE; utm_zone = value-32500;
-    ellipsoid_id = CRS_ELLIPSOID_WGS72;
+  }
+
+  if (record->type != CRSDATABASE_NO_PROJECTION)
+  {
+    const CHAR* name = CRSdatabase::get_string(record->name);
+    if (name)
+    {
+      strncpy(projections[0]->name, name, 255);
+    }
+  }
+
+  switch (record->coordinate_units)
+  {
+  case 1:
+    set_coordinates_in_meter(TRUE);
     break;
-  case 32601: // PCS_WGS84_UTM_zone_1N
-  case 32602: // PCS_WGS84_UTM_zone_2N
-  case 32603: // PCS_WGS84_UTM_zone_3N
-  case 32604: // PCS_WGS84_UTM_zone_4N
-  case 32605: // PCS_WGS84_UTM_zone_5N
-  case 32606: // PCS_WGS84_UTM_zone_6N
-  case 32607: // PCS_WGS84_UTM_zone_7N
-  case 32608:
-  case 32609:
-  case 32610:
-  case 32611:
-  case 32612:
-  case 32613:
-  case 32614:
-  case 32615:
-  case 32616:
-  case 32617:
-  case 32618:
-  case 32619:
-  case 32620:
-  case 32621:
-  case 32622:
-  case 32623:
-  case 32624:
-  case 32625:
-  case 32626:
-  case 32627:
-  case 32628:
-  case 32629:
-  case 32630:
-  case 32631:
-  case 32632:
-  case 32633:
-  case 32634:
-  case 32635:
-  case 32636:
-  case 32637:
-  case 32638:
-  case 32639:
-  case 32640:
-  case 32641:
-  case 32642:
-  case 32643:
-  case 32644:
-  case 32645:
-  case 32646:
-  case 32647:
-  case 32648:
-  case 32649:
-  case 32650:
-  case 32651:
-  case 32652:
-  case 32653:
-  case 32654:
-  case 32655:
-  case 32656:
-  case 32657:
-  case 32658:
-  case 32659: // PCS_WGS84_UTM_zone_59N
-  case 32660: // PCS_WGS84_UTM_zone_60N
-    utm_northern = TRUE; utm_zone = value-32600;
-    ellipsoid_id = CRS_ELLIPSOID_WGS84;
+  case 2:
+    set_coordinates_in_feet(TRUE);
     break;
-  case 32701: // PCS_WGS84_UTM_zone_1S
-  case 32702: // PCS_WGS84_UTM_zone_2S
-  case 32703: // PCS_WGS84_UTM_zone_3S
-  case 32704: // PCS_WGS84_UTM_zone_4S
-  case 32705: // PCS_WGS84_UTM_zone_5S
-  case 32706: // PCS_WGS84_UTM_zone_6S
-  case 32707: // PCS_WGS84_UTM_zone_7S
-  case 32708:
-  case 32709:
-  case 32710:
-  case 32711:
-  case 32712:
-  case 32713:
-  case 32714:
-  case 32715:
-  case 32716:
-  case 32717:
-  case 32718:
-  case 32719:
-  case 32720:
-  case 32721:
-  case 32722:
-  case 32723:
-  case 32724:
-  case 32725:
-  case 32726:
-  case 32727:
-  case 32728:
-  case 32729:
-  case 32730:
-  case 32731:
-  case 32732:
-  case 32733:
-  case 32734:
-  case 32735:
-  case 32736:
-  case 32737:
-  case 32738:
-  case 32739:
-  case 32740:
-  case 32741:
-  case 32742:
-  case 32743:
-  case 32744:
-  case 32745:
-  case 32746:
-  case 32747:
-  case 32748:
-  case 32749:
-  case 32750:
-  case 32751:
-  case 32752:
-  case 32753:
-  case 32754:
-  case 32755:
-  case 32756:
-  case 32757:
-  case 32758:
-  case 32759: // PCS_WGS84_UTM_zone_59S
-  case 32760: // PCS_WGS84_UTM_zone_60S
-    utm_northern = FALSE; utm_zone = value-32700;
-    ellipsoid_id = CRS_ELLIPSOID_WGS84;
+  case 3:
+    set_coordinates_in_survey_feet(TRUE);
     break;
   }
 
-  if (ellipsoid_id == -1)
+  if (description && (record->description != CRSDATABASE_NO_STRING))
   {
-    if (utm_zone != -1) ellipsoid_id = CRS_ELLIPSOID_WGS84;
-    else if (sp != 0) ellipsoid_id = (sp_nad27 ? CRS_ELLIPSOID_NAD27 : CRS_ELLIPSOID_NAD83);
+    const CHAR* string = CRSdatabase::get_string(record->description);
+    if (string)
+    {
+      sprintf(description, "%s", string);
+    }
   }
+  return TRUE;
+}
 
-  if (ellipsoid_id != -1)
+BOOL CRScheck::set_projection_from_ProjectedCSTypeGeoKey(const U16 value, CHAR* description)
+{
+  if (set_projection_from_database(value, description))
   {
-    set_ellipsoid(ellipsoid_id, TRUE);
+    return TRUE;
   }
+  return set_projection_from_EPSG_tables(value, description);
+}
 
-  if (utm_zone != -1)
+// appends a string to the pool of the CRS database unless it is already there
+
+static U32 crs_database_add_string(CHAR** strings, U32* size, U32* alloc, U32** offsets, U32* number, U32* offsets_alloc, const CHAR* string)
+{
+  U32 i;
+  for (i = 0; i < *number; i++)
   {
-    if (is_mga)
+    if (strcmp(*strings + (*offsets)[i], string) == 0)
     {
-      if (set_mga_projection(utm_zone, utm_northern, TRUE, description))
+      return (*offsets)[i];
+    }
+  }
+  U32 length = (U32)strlen(string) + 1;
+  if ((*size + length) > *alloc)
+  {
+    *alloc = 2*(*size + length);
+    *strings = (CHAR*)realloc(*strings, *alloc);
+  }
+  if (*number == *offsets_alloc)
+  {
+    *offsets_alloc = 2*(*offsets_alloc) + 256;
+    *offsets = (U32*)realloc(*offsets, sizeof(U32)*(*offsets_alloc));
+  }
+  U32 offset = *size;
+  memcpy(*strings + offset, string, length);
+  *size += length;
+  (*offsets)[(*number)++] = offset;
+  return offset;
+}
+
+BOOL CRScheck::write_database(const CHAR* file_name)
+{
+  static const CHAR* unchanged = "\001";
+
+  U32 size_of_strings = 0;
+  U32 strings_alloc = 0;
+  CHAR* strings = 0;
+  U32 number_of_strings = 0;
+  U32 offsets_alloc = 0;
+  U32* offsets = 0;
+
+  // resolve every code with the built-in tables and record what was set for it
+
+  U32 number_of_projections = 0;
+  CRSdatabaseProjection* projections = (CRSdatabaseProjection*)malloc(sizeof(CRSdatabaseProjection)*65536);
+  CHAR description[1024];
+  CRScheck crscheck;
+  U32 code;
+  for (code = 1; code < 65536; code++)
+  {
+    crscheck.reset();
+    strcpy(description, unchanged);
+    if (!crscheck.set_projection_from_EPSG_tables((U16)code, description))
+    {
+      continue;
+    }
+    CRSdatabaseProjection* record = &(projections[number_of_projections++]);
+    memset(record, 0, sizeof(CRSdatabaseProjection));
+    record->code = (U16)code;
+    record->ellipsoid = (I16)(crscheck.ellipsoids[0] ? crscheck.ellipsoids[0]->id : 0);
+    record->coordinate_units = (U8)crscheck.coordinate_units[0];
+    record->type = CRSDATABASE_NO_PROJECTION;
+    record->name = CRSDATABASE_NO_STRING;
+    const CRSprojectionParameters* projection = crscheck.projections[0];
+    if (projection)
+    {
+      record->type = (U8)projection->type;
+      record->name = crs_database_add_string(&strings, &size_of_strings, &strings_alloc, &offsets, &number_of_strings, &offsets_alloc, projection->name);
+      if (projection->type == CRS_PROJECTION_UTM)
       {
-        return TRUE;
+        const CRSprojectionParametersUTM* utm = (const CRSprojectionParametersUTM*)projection;
+        record->parameters[0] = utm->utm_zone_number;
+        record->parameters[1] = (utm->utm_northern_hemisphere ? 1.0 : 0.0);
+        record->parameters[2] = utm->utm_zone_letter;
+      }
+      else if (projection->type == CRS_PROJECTION_LCC)
+      {
+        const CRSprojectionParametersLCC* lcc = (const CRSprojectionParametersLCC*)projection;
+        record->parameters[0] = lcc->lcc_false_easting_meter;
+        record->parameters[1] = lcc->lcc_false_northing_meter;
+        record->parameters[2] = lcc->lcc_lat_origin_degree;
+        record->parameters[3] = lcc->lcc_long_meridian_degree;
+        record->parameters[4] = lcc->lcc_first_std_parallel_degree;
+        record->parameters[5] = lcc->lcc_second_std_parallel_degree;
+      }
+      else if (projection->type == CRS_PROJECTION_TM)
+      {
+        const CRSprojectionParametersTM* tm = (const CRSprojectionParametersTM*)projection;
+        record->parameters[0] = tm->tm_false_easting_meter;
+        record->parameters[1] = tm->tm_false_northing_meter;
+        record->parameters[2] = tm->tm_lat_origin_degree;
+        record->parameters[3] = tm->tm_long_meridian_degree;
+        record->parameters[4] = tm->tm_scale_factor;
       }
     }
+    if (strcmp(description, unchanged) == 0)
+    {
+      record->description = CRSDATABASE_NO_STRING;
+    }
     else
     {
-      if (set_utm_projection(utm_zone, utm_northern, TRUE, description))
-      {
-        return TRUE;
-      }
+      record->description = crs_database_add_string(&strings, &size_of_strings, &strings_alloc, &offsets, &number_of_strings, &offsets_alloc, description);
     }
   }
 
-  if (sp)
+  // the names of the EPSG codes are already sorted
+
+  CRSdatabaseName* names = (CRSdatabaseName*)malloc(sizeof(CRSdatabaseName)*epsg_named_number);
+  I32 i;
+  for (i = 0; i < epsg_named_number; i++)
   {
-    if (sp_nad27)
+    names[i].code = (U16)epsg_codes[i];
+    names[i].reserved = 0;
+    names[i].name = crs_database_add_string(&strings, &size_of_strings, &strings_alloc, &offsets, &number_of_strings, &offsets_alloc, epsg_descriptions[i]);
+  }
+
+  BOOL success = CRSdatabase::write(file_name, projections, number_of_projections, names, (U32)epsg_named_number, strings, size_of_strings);
+  if (success)
+  {
+    fprintf(stderr, "wrote %u projected CRS and %d names with %u bytes of strings to '%s'\n", number_of_projections, epsg_named_number, size_of_strings, file_name);
+  }
+
+  free(names);
+  free(projections);
+  free(offsets);
+  free(strings);
+  return success;
+}
+
+BOOL CRScheck::check_geokeys(LASheader* lasheader, CHAR* description)
+{
+  BOOL has_projection = FALSE;
+  BOOL user_defined_ellipsoid = FALSE;
+  I32 user_defined_projection = 0;
+  I32 offsetProjStdParallel1GeoKey = -1;
+  I32 offsetProjStdParallel2GeoKey = -1;
+  I32 offsetProjNatOriginLatGeoKey = -1;
+  I32 offsetProjFalseEastingGeoKey = -1;
+  I32 offsetProjFalseNorthingGeoKey = -1;
+  I32 offsetProjCenterLongGeoKey = -1;
+  I32 offsetProjScaleAtNatOriginGeoKey = -1;
+  I32 ellipsoid = -1;
+
+  U32 num_geokey_entries = lasheader->geokeys->number_of_keys;
+  LASgeokey_entry* geokey_entries = lasheader->geokey_entries;
+  F64* geokey_double_params = lasheader->geokey_double_params;
+
+  for (U32 i = 0; i < num_geokey_entries; i++)
+  {
+    switch (geokey_entries[i].key_id)
     {
-      if (set_state_plane_nad27_lcc(sp, TRUE, description))
+    case 1024: // GTModelTypeGeoKey
+      if (geokey_entries[i].value_offset == 2) // ModelTypeGeographic
       {
-        return TRUE;
+        has_projection = set_longlat_projection(TRUE, description);
+      }
+      else if (geokey_entries[i].value_offset == 3) // ModelTypeGeocentric
+      {
+        has_projection = set_ecef_projection(TRUE, description);
+      }
+      else if (geokey_entries[i].value_offset == 0) // ModelTypeUndefined
+      {
+        has_projection = set_no_projection(TRUE, description);
+      }
+      break;
+    case 2048: // GeographicTypeGeoKey
+      if ((horizontal_epsg[0] == 0) && (geokey_entries[i].value_offset != 32767))
+      {
+        horizontal_epsg[0] = geokey_entries[i].value_offset;
+      }
+      switch (geokey_entries[i].value_offset)
+      {
+      case 32767: // user-defined GCS
+        user_defined_ellipsoid = TRUE;
+        break;
+      case 4001: // GCSE_Airy1830
+        ellipsoid = 1;
+        break;
+      case 4002: // GCSE_AiryModified1849 
+        ellipsoid = 16;
+        break;
+      case 4003: // GCSE_AustralianNationalSpheroid
+        ellipsoid = 2;
+        break;
+      case 4004: // GCSE_Bessel1841
+      case 4005: // GCSE_Bessel1841Modified
+        ellipsoid = 3;
+        break;
+      case 4006: // GCSE_BesselNamibia
+        ellipsoid = 4;
+        break;
+      case 4008: // GCSE_Clarke1866
+      case 4009: // GCSE_Clarke1866Michigan
+        ellipsoid = CRS_ELLIPSOID_NAD27;
+        break;
+      case 4010: // GCSE_Clarke1880_Benoit
+      case 4011: // GCSE_Clarke1880_IGN
+      case 4012: // GCSE_Clarke1880_RGS
+      case 4013: // GCSE_Clarke1880_Arc
+      case 4014: // GCSE_Clarke1880_SGA1922
+      case 4034: // GCSE_Clarke1880
+        ellipsoid = 6;
+        break;
+      case 4015: // GCSE_Everest1830_1937Adjustment
+      case 4016: // GCSE_Everest1830_1967Definition
+      case 4017: // GCSE_Everest1830_1975Definition
+        ellipsoid = 7;
+        break;
+      case 4018: // GCSE_Everest1830Modified
+        ellipsoid = 17;
+        break;
+      case 4019: // GCSE_GRS1980
+        ellipsoid = CRS_ELLIPSOID_NAD83;
+        break;
+      case 4020: // GCSE_Helmert1906
+        ellipsoid = 12;
+        break;
+      case 4022: // GCSE_International1924
+      case 4023: // GCSE_International1967
+        ellipsoid = 14;
+        break;
+      case 4024: // GCSE_Krassowsky1940
+        ellipsoid = 15;
+        break;
+      case 4030: // GCSE_WGS84
+        ellipsoid = CRS_ELLIPSOID_WGS84;
+        break;
+      case 4267: // GCS_NAD27
+        ellipsoid = CRS_ELLIPSOID_NAD27;
+        break;
+      case 4269: // GCS_NAD83
+        ellipsoid = CRS_ELLIPSOID_NAD83;
+        break;
+      case 4283: // GCS_GDA94
+        ellipsoid = CRS_ELLIPSOID_GDA94;
+        break;
+      case 4322: // GCS_WGS_72
+        ellipsoid = CRS_ELLIPSOID_WGS72;
+        break;
+      case 4326: // GCS_WGS_84
+        ellipsoid = CRS_ELLIPSOID_WGS84;
+        break;
+      default:
+        fprintf(stderr, "GeographicTypeGeoKey: look-up for %d not implemented\n", geokey_entries[i].value_offset);
+      }
+      break;
+    case 2050: // GeogGeodeticDatumGeoKey 
+      switch (geokey_entries[i].value_offset)
+      {
+      case 32767: // user-defined GCS
+        user_defined_ellipsoid = TRUE;
+        break;
+      case 6202: // Datum_Australian_Geodetic_Datum_1966
+      case 6203: // Datum_Australian_Geodetic_Datum_1984
+        ellipsoid = 2;
+        break;
+      case 6267: // Datum_North_American_Datum_1927
+        ellipsoid = CRS_ELLIPSOID_NAD27;
+        break;
+      case 6269: // Datum_North_American_Datum_1983
+        ellipsoid = CRS_ELLIPSOID_NAD83;
+        break;
+      case 6283: // Datum_Geocentric_Datum_of_Australia_1994
+        ellipsoid = CRS_ELLIPSOID_GDA94;
+        break;
+      case 6322: // Datum_WGS72
+        ellipsoid = CRS_ELLIPSOID_WGS72;
+        break;
+      case 6326: // Datum_WGS84
+        ellipsoid = CRS_ELLIPSOID_WGS84;
+        break;
+      case 6001: // DatumE_Airy1830
+        ellipsoid = 1;
+        break;
+      case 6002: // DatumE_AiryModified1849
+        ellipsoid = 16;
+        break;
+      case 6003: // DatumE_AustralianNationalSpheroid
+        ellipsoid = 2;
+        break;
+      case 6004: // DatumE_Bessel1841
+      case 6005: // DatumE_BesselModified
+        ellipsoid = 3;
+        break;
+      case 6006: // DatumE_BesselNamibia
+        ellipsoid = 4;
+        break;
+      case 6008: // DatumE_Clarke1866
+      case 6009: // DatumE_Clarke1866Michigan
+        ellipsoid = CRS_ELLIPSOID_NAD27;
+        break;
+      case 6010: // DatumE_Clarke1880_Benoit
+      case 6011: // DatumE_Clarke1880_IGN
+      case 6012: // DatumE_Clarke1880_RGS
+      case 6013: // DatumE_Clarke1880_Arc
+      case 6014: // DatumE_Clarke1880_SGA1922
+      case 6034: // DatumE_Clarke1880
+        ellipsoid = 6;
+        break;
+      case 6015: // DatumE_Everest1830_1937Adjustment
+      case 6016: // DatumE_Everest1830_1967Definition
+      case 6017: // DatumE_Everest1830_1975Definition
+        ellipsoid = 7;
+        break;
+      case 6018: // DatumE_Everest1830Modified
+        ellipsoid = 17;
+        break;
+      case 6019: // DatumE_GRS1980
+        ellipsoid = CRS_ELLIPSOID_NAD83;
+        break;
+      case 6020: // DatumE_Helmert1906
+        ellipsoid = 12;
+        break;
+      case 6022: // DatumE_International1924
+      case 6023: // DatumE_International1967
+        ellipsoid = 14;
+        break;
+      case 6024: // DatumE_Krassowsky1940
+        ellipsoid = 15;
+        break;
+      case 6030: // DatumE_WGS84
+        ellipsoid = CRS_ELLIPSOID_WGS84;
+        break;
+      default:
+        fprintf(stderr, "GeogGeodeticDatumGeoKey: look-up for %d not implemented\n", geokey_entries[i].value_offset);
       }
-      if (set_state_plane_nad27_tm(sp, TRUE, description))
+      break;
+    case 2052: // GeogLinearUnitsGeoKey 
+      switch (geokey_entries[i].value_offset)
       {
-        return TRUE;
+      case 9001: // Linear_Meter
+        break;
+      case 9002: // Linear_Foot
+        break;
+      case 9003: // Linear_Foot_US_Survey
+        break;
+      default:
+        fprintf(stderr, "GeogLinearUnitsGeoKey: look-up for %d not implemented\n", geokey_entries[i].value_offset);
       }
-    }
-    else
-    {
-      if (set_state_plane_nad83_lcc(sp, TRUE, description))
+      break;
+    case 2056: // GeogEllipsoidGeoKey
+      switch (geokey_entries[i].value_offset)
       {
-        return TRUE;
+      case 7001: // Ellipse_Airy_1830
+        ellipsoid = 1;
+        break;
+      case 7002: // Ellipse_Airy_Modified_1849
+        ellipsoid = 16;
+        break;
+      case 7003: // Ellipse_Australian_National_Spheroid
+        ellipsoid = 2;
+        break;
+      case 7004: // Ellipse_Bessel_1841
+      case 7005: // Ellipse_Bessel_Modified
+        ellipsoid = 3;
+        break;
+      case 7006: // Ellipse_Bessel_Namibia
+        ellipsoid = 4;
+        break;
+      case 7008: // Ellipse_Clarke_1866
+      case 7009: // Ellipse_Clarke_1866_Michigan
+        ellipsoid = CRS_ELLIPSOID_NAD27;
+        break;
+      case 7010: // Ellipse_Clarke1880_Benoit
+      case 7011: // Ellipse_Clarke1880_IGN
+      case 7012: // Ellipse_Clarke1880_RGS
+      case 7013: // Ellipse_Clarke1880_Arc
+      case 7014: // Ellipse_Clarke1880_SGA1922
+      case 7034: // Ellipse_Clarke1880
+        ellipsoid = 6;
+        break;
+      case 7015: // Ellipse_Everest1830_1937Adjustment
+      case 7016: // Ellipse_Everest1830_1967Definition
+      case 7017: // Ellipse_Everest1830_1975Definition
+        ellipsoid = 7;
+        break;
+      case 7018: // Ellipse_Everest1830Modified
+        ellipsoid = 17;
+        break;
+      case 7019: // Ellipse_GRS_1980
+        ellipsoid = CRS_ELLIPSOID_NAD83;
+        break;
+      case 7020: // Ellipse_Helmert1906
+        ellipsoid = 12;
+        break;
+      case 7022: // Ellipse_International1924
+      case 7023: // Ellipse_International1967
+        ellipsoid = 14;
+        break;
+      case 7024: // Ellipse_Krassowsky1940
+        ellipsoid = 15;
+        break;
+      case 7030: // Ellipse_WGS_84
+        ellipsoid = CRS_ELLIPSOID_WGS84;
+        break;
+      default:
+        fprintf(stderr, "GeogEllipsoidGeoKey: look-up for %d not implemented\n", geokey_entries[i].value_offset);
       }
-      if (set_state_plane_nad83_tm(sp, TRUE, description))
+      break;
+    case 3072: // ProjectedCSTypeGeoKey
+      if (geokey_entries[i].value_offset != 32767)
       {
-        return TRUE;
+        horizontal_epsg[0] = geokey_entries[i].value_offset;
+        has_projection = set_projection_from_ProjectedCSTypeGeoKey(geokey_entries[i].value_offset, description);
       }
-    }
-  }
-
-  if (value == EPSG_IRENET95_Irish_Transverse_Mercator)
-  {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(600000.0, 750000.0, 53.5, -8.0, 0.99982, TRUE, 0); // "IRENET95 / Irish Transverse Mercator"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "IRENET95 / Irish Transverse Mercator");
-    return TRUE;
-  }
-  else if (value == EPSG_ETRS89_Poland_CS92)
-  {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(500000.0, -5300000.0, 0.0, 19.0, 0.9993, TRUE, 0); // "ETRS89 / Poland CS92"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "ETRS89 / Poland CS92");
-    return TRUE;
-  }
-  else if (value == EPSG_NZGD2000)
-  {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(1600000.0, 10000000.0, 0.0, 173.0, 0.9996, TRUE, 0); // "NZGD2000 / New Zealand Transverse Mercator 2000"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "NZGD2000");
-    return TRUE;
-  }
-  else if (value == EPSG_NAD83_Maryland_ftUS)
-  {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_lambert_conformal_conic_projection(400000.0, 0.0, 37.66666666666666, -77, 37.66666666666666, 38.3, TRUE, 0); // "NAD83 / Maryland (ftUS)"
-    set_coordinates_in_survey_feet(TRUE);
-    if (description) sprintf(description, "NAD83 / Maryland (ftUS)");
-    return TRUE;
-  }
-  else if (value == EPSG_NAD83_HARN_UTM2_South_American_Samoa)
-  {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(500000.0, 10000000.0, 0.0, -171.0, 0.9996, TRUE, 0); // "NAD83(HARN) / UTM zone 2S (American Samoa)"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "UTM zone 2S (American Samoa)");
-    return TRUE;
-  }
-  else if (value == EPSG_NAD83_HARN_Virginia_North_ftUS)
-  {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_lambert_conformal_conic_projection(3500000.0, 2000000.0, 37.66666666666666, -78.5, 39.2, 38.03333333333333, TRUE, 0); // "NAD83(HARN) / Virginia North (ftUS)"
-    set_coordinates_in_survey_feet(TRUE);
-    if (description) sprintf(description, "NAD83(HARN) / Virginia North (ftUS)");
-    return TRUE;
-  }
-  else if (value == EPSG_NAD83_HARN_Virginia_South_ftUS)
-  {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_lambert_conformal_conic_projection(3500000.0, 1000000.0, 36.33333333333334, -78.5, 37.96666666666667, 36.76666666666667, TRUE, 0); // "NAD83(HARN) / Virginia South (ftUS)"
-    set_coordinates_in_survey_feet(TRUE);
-    if (description) sprintf(description, "NAD83(HARN) / Virginia South (ftUS)");
-    return TRUE;
-  }
-  else if (value == EPSG_Reseau_Geodesique_Francais_Guyane_1995)
-  {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(500000.0, 0.0, 0.0, -51.0, 0.9996, TRUE, 0); // "Reseau Geodesique Francais Guyane 1995"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "Reseau Geodesique Francais Guyane 1995");
-    return TRUE;
-  }
-  else if (value == EPSG_NAD83_Oregon_Lambert)
-  {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_lambert_conformal_conic_projection(400000.0, 0.0, 41.75, -120.5, 43.0, 45.5, TRUE, 0); // "NAD83 / Oregon Lambert"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "NAD83 / Oregon Lambert");
-    return TRUE;
-  }
-  else if (value == EPSG_NAD83_Oregon_Lambert_ft)
-  {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_lambert_conformal_conic_projection(400000.0, 0.0, 41.75, -120.5, 43.0, 45.5, TRUE, 0); // "NAD83 / Oregon Lambert (ft)"
-    set_coordinates_in_feet(TRUE);
-    if (description) sprintf(description, "NAD83 / Oregon Lambert (ft)");
-    return TRUE;
-  }
-  else if (value == EPSG_SWEREF99_TM)
-  {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(500000.0, 0.0, 0.0, 15.0, 0.9996, TRUE, 0); // "SWEREF99 TM"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "SWEREF99 TM");
-    return TRUE;
-  }
-  else if (value == EPSG_ETRS89_ETRS_LCC)
-  {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_lambert_conformal_conic_projection(4000000.0, 2800000.0, 52.0, 10.0, 35.0, 65.0, TRUE, 0); // "ETRS89 / ETRS-LCC"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "ETRS89 / ETRS-LCC");
-    return TRUE;
-  }
-  else if (value == EPSG_ETRS89_ETRS_TM34)
-  {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(500000.0, 0.0, 0.0, 21.0, 0.9996, TRUE, 0); // "ETRS89 / ETRS-TM34"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "ETRS89 / ETRS-TM34");
-    return TRUE;
-  }
-  else if (value == EPSG_ETRS89_ETRS_TM35)
-  {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(500000.0, 0.0, 0.0, 27.0, 0.9996, TRUE, 0); // "ETRS89 / ETRS-TM35"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "ETRS89 / ETRS-TM35");
-    return TRUE;
-  }
-  else if (value == EPSG_ETRS89_ETRS_TM36)
-  {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(500000.0, 0.0, 0.0, 33.0, 0.9996, TRUE, 0); // "ETRS89 / ETRS-TM36"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "ETRS89 / ETRS-TM36");
-    return TRUE;
-  }
-  else if (value == EPSG_ETRS89_ETRS_TM35FIN)
-  {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(500000.0, 0.0, 0.0, 27.0, 0.9996, TRUE, 0); // "ETRS89 / ETRS-TM35FIN"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "ETRS89 / ETRS-TM35FIN");
-    return TRUE;
-  }
-  else if (value == EPSG_Fiji_1956_UTM60_South)
-  {
-    set_ellipsoid(CRS_ELLIPSOID_Inter, TRUE);
-    set_utm_projection(60, FALSE, TRUE, 0); // "Fiji 1956 / UTM zone 60S"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "Fiji 1956 / UTM zone 60S");
-  }
-  else if (value == EPSG_Fiji_1956_UTM1_South)
-  {
-    set_ellipsoid(CRS_ELLIPSOID_Inter, TRUE);
-    set_utm_projection(1, FALSE, TRUE, 0); // "Fiji 1956 / UTM zone 1S"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "Fiji 1956 / UTM zone 1S");
-  }
-  else if (value == EPSG_Fiji_Map_Grid_1986)
-  {
-    set_ellipsoid(CRS_ELLIPSOID_WGS72, TRUE);
-    set_transverse_mercator_projection(2000000.0, 4000000.0, -17.0, 178.75, 0.99985, TRUE, 0); // "Fiji 1986 / Fiji Map Grid"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "Fiji 1986 / Fiji Map Grid");
-    return TRUE;
-  }
-  else if (value == EPSG_NAD83_NSRS2007_Maryland_ftUS)
-  {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_lambert_conformal_conic_projection(400000.0, 0.0, 37.66666666666666, -77, 39.45, 38.3, TRUE, 0); // "NAD83(NSRS2007) / Maryland (ftUS)"
-    set_coordinates_in_survey_feet(TRUE);
-    if (description) sprintf(description, "NAD83(NSRS2007) / Maryland (ftUS)");
-    return TRUE;
+      break;
+    case 3075: // ProjCoordTransGeoKey
+      user_defined_projection = 0;
+      switch (geokey_entries[i].value_offset)
+      {
+      case 1: // CT_TransverseMercator
+        user_defined_projection = 1;
+        break;
+      case 8: // CT_LambertConfConic_2SP
+        user_defined_projection = 8;
+        break;
+      case 2: // CT_TransvMercator_Modified_Alaska
+        fprintf(stderr, "ProjCoordTransGeoKey: CT_TransvMercator_Modified_Alaska not implemented\n");
+        break;
+      case 3: // CT_ObliqueMercator
+        fprintf(stderr, "ProjCoordTransGeoKey: CT_ObliqueMercator not implemented\n");
+        break;
+      case 4: // CT_ObliqueMercator_Laborde
+        fprintf(stderr, "ProjCoordTransGeoKey: CT_ObliqueMercator_Laborde not implemented\n");
+        break;
+      case 5: // CT_ObliqueMercator_Rosenmund
+        fprintf(stderr, "ProjCoordTransGeoKey: CT_ObliqueMercator_Rosenmund not implemented\n");
+        break;
+      case 6: // CT_ObliqueMercator_Spherical
+        fprintf(stderr, "ProjCoordTransGeoKey: CT_ObliqueMercator_Spherical not implemented\n");
+        break;
+      case 7: // CT_Mercator
+        fprintf(stderr, "ProjCoordTransGeoKey: CT_Mercator not implemented\n");
+        break;
+      case 9: // CT_LambertConfConic_Helmert
+        fprintf(stderr, "ProjCoordTransGeoKey: CT_LambertConfConic_Helmert not implemented\n");
+        break;
+      case 10: // CT_LambertAzimEqualArea
+        fprintf(stderr, "ProjCoordTransGeoKey: CT_LambertAzimEqualArea not implemented\n");
+        break;
+      case 11: // CT_AlbersEqualArea
+        fprintf(stderr, "ProjCoordTransGeoKey: CT_AlbersEqualArea not implemented\n");
+        break;
+      case 12: // CT_AzimuthalEquidistant
+        fprintf(stderr, "ProjCoordTransGeoKey: CT_AzimuthalEquidistant not implemented\n");
+        break;
+      case 13: // CT_EquidistantConic
+        fprintf(stderr, "ProjCoordTransGeoKey: CT_EquidistantConic not implemented\n");
+        break;
+      case 14: // CT_Stereographic
+        fprintf(stderr, "ProjCoordTransGeoKey: CT_Stereographic not implemented\n");
+        break;
+      case 15: // CT_PolarStereographic
+        fprintf(stderr, "ProjCoordTransGeoKey: CT_PolarStereographic not implemented\n");
+        break;
+      case 16: // CT_ObliqueStereographic
+        fprintf(stderr, "ProjCoordTransGeoKey: CT_ObliqueStereographic not implemented\n");
+        break;
+      case 17: // CT_Equirectangular
+        fprintf(stderr, "ProjCoordTransGeoKey: CT_Equirectangular not implemented\n");
+        break;
+      case 18: // CT_CassiniSoldner
+        fprintf(stderr, "ProjCoordTransGeoKey: CT_CassiniSoldner not implemented\n");
+        break;
+      case 19: // CT_Gnomonic
+        fprintf(stderr, "ProjCoordTransGeoKey: CT_Gnomonic not implemented\n");
+        break;
+      case 20: // CT_MillerCylindrical
+        fprintf(stderr, "ProjCoordTransGeoKey: CT_MillerCylindrical not implemented\n");
+        break;
+      case 21: // CT_Orthographic
+        fprintf(stderr, "ProjCoordTransGeoKey: CT_Orthographic not implemented\n");
+        break;
+      case 22: // CT_Polyconic
+        fprintf(stderr, "ProjCoordTransGeoKey: CT_Polyconic not implemented\n");
+        break;
+      case 23: // CT_Robinson
+        fprintf(stderr, "ProjCoordTransGeoKey: CT_Robinson not implemented\n");
+        break;
+      case 24: // CT_Sinusoidal
+        fprintf(stderr, "ProjCoordTransGeoKey: CT_Sinusoidal not implemented\n");
+        break;
+      case 25: // CT_VanDerGrinten
+        fprintf(stderr, "ProjCoordTransGeoKey: CT_VanDerGrinten not implemented\n");
+        break;
+      case 26: // CT_NewZealandMapGrid
+        fprintf(stderr, "ProjCoordTransGeoKey: CT_NewZealandMapGrid not implemented\n");
+        break;
+      case 27: // CT_TransvMercator_SouthOriented
+        fprintf(stderr, "ProjCoordTransGeoKey: CT_TransvMercator_SouthOriented not implemented\n");
+        break;
+      default:
+        fprintf(stderr, "ProjCoordTransGeoKey: look-up for %d not implemented\n", geokey_entries[i].value_offset);
+      }
+      break;
+    case 3076: // ProjLinearUnitsGeoKey
+      set_coordinates_from_ProjLinearUnitsGeoKey(geokey_entries[i].value_offset);
+      break;
+    case 3078: // ProjStdParallel1GeoKey
+      offsetProjStdParallel1GeoKey = geokey_entries[i].value_offset;
+      break;
+    case 3079: // ProjStdParallel2GeoKey
+      offsetProjStdParallel2GeoKey = geokey_entries[i].value_offset;
+      break;        
+    case 3081: // ProjNatOriginLatGeoKey
+      offsetProjNatOriginLatGeoKey = geokey_entries[i].value_offset;
+      break;
+    case 3082: // ProjFalseEastingGeoKey
+      offsetProjFalseEastingGeoKey = geokey_entries[i].value_offset;
+      break;
+    case 3083: // ProjFalseNorthingGeoKey
+      offsetProjFalseNorthingGeoKey = geokey_entries[i].value_offset;
+      break;
+    case 3088: // ProjCenterLongGeoKey
+      offsetProjCenterLongGeoKey = geokey_entries[i].value_offset;
+      break;
+    case 3092: // ProjScaleAtNatOriginGeoKey
+      offsetProjScaleAtNatOriginGeoKey = geokey_entries[i].value_offset;
+      break;
+    case 4096: // VerticalCSTypeGeoKey 
+      set_vertical_from_VerticalCSTypeGeoKey(geokey_entries[i].value_offset);
+      break;
+    case 4099: // VerticalUnitsGeoKey
+      set_elevation_from_VerticalUnitsGeoKey(geokey_entries[i].value_offset);
+      break;
+    }
   }
-  else if (value == EPSG_Slovene_National_Grid_1996)
+
+  if (ellipsoid != -1)
   {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(500000.0, -5000000.0, 0.0, 15.0, 0.9999, TRUE, 0); // "Slovenia 1996 / Slovene National Grid"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "Slovenia 1996 / Slovene National Grid");
-    return TRUE;
+    set_ellipsoid(ellipsoid, TRUE);
   }
-  else if (value == EPSG_MGI_1901_Slovene_National_Grid)
+
+  if (!has_projection)
   {
-    set_ellipsoid(3, TRUE); // Bessel 1841
-    set_transverse_mercator_projection(500000.0, -5000000.0, 0.0, 15.0, 0.9999, TRUE, 0); // "MGI 1901 / Slovene National Grid"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "MGI 1901 / Slovene National Grid");
-    return TRUE;    
+    if (user_defined_projection == 1)
+    {
+      if ((offsetProjFalseEastingGeoKey >= 0) &&
+          (offsetProjFalseNorthingGeoKey >= 0) &&
+          (offsetProjNatOriginLatGeoKey >= 0) &&
+          (offsetProjCenterLongGeoKey >= 0) &&
+          (offsetProjScaleAtNatOriginGeoKey >= 0))
+      {
+        F64 falseEasting = geokey_double_params[offsetProjFalseEastingGeoKey] * get_coordinates2meter(TRUE);
+        F64 falseNorthing = geokey_double_params[offsetProjFalseNorthingGeoKey] * get_coordinates2meter(TRUE);
+        F64 latOriginDeg = geokey_double_params[offsetProjNatOriginLatGeoKey];
+        F64 longMeridianDeg = geokey_double_params[offsetProjCenterLongGeoKey];
+        F64 scaleFactor = geokey_double_params[offsetProjScaleAtNatOriginGeoKey];
+        set_transverse_mercator_projection(falseEasting, falseNorthing, latOriginDeg, longMeridianDeg, scaleFactor, TRUE, description);
+        if (description)
+        {
+          sprintf(description, "generic transverse mercator");
+        }
+        has_projection = TRUE;
+      }
+    }
+    else if (user_defined_projection == 8)
+    {
+      if ((offsetProjFalseEastingGeoKey >= 0) &&
+          (offsetProjFalseNorthingGeoKey >= 0) &&
+          (offsetProjNatOriginLatGeoKey >= 0) &&
+          (offsetProjCenterLongGeoKey >= 0) &&
+          (offsetProjStdParallel1GeoKey >= 0) &&
+          (offsetProjStdParallel2GeoKey >= 0))
+      {
+        F64 falseEasting = geokey_double_params[offsetProjFalseEastingGeoKey] * get_coordinates2meter(TRUE);
+        F64 falseNorthing = geokey_double_params[offsetProjFalseNorthingGeoKey] * get_coordinates2meter(TRUE);
+        F64 latOriginDeg = geokey_double_params[offsetProjNatOriginLatGeoKey];
+        F64 longOriginDeg = geokey_double_params[offsetProjCenterLongGeoKey];
+        F64 firstStdParallelDeg = geokey_double_params[offsetProjStdParallel1GeoKey];
+        F64 secondStdParallelDeg = geokey_double_params[offsetProjStdParallel2GeoKey];
+        set_lambert_conformal_conic_projection(falseEasting, falseNorthing, latOriginDeg, longOriginDeg, firstStdParallelDeg, secondStdParallelDeg, TRUE, description);
+        if (description)
+        {
+          sprintf(description, "generic lambert conformal conic");
+        }
+        has_projection = TRUE;
+      }
+    }
   }
-  else if ((EPSG_RGF93_CC42 <= value) && (value <= EPSG_RGF93_CC50))
+  return has_projection;
+}
+
+// inverse projections from easting and northing to longitude and latitude. the
+// constants that only depend on the projection and the ellipsoid are computed
+// once per call and the kernels then run over arrays of coordinates with the
+// same straight-line arithmetic for every coordinate.
+
+static void compute_tm_constants(CRSprojectionParametersTM* tm, const CRSprojectionEllipsoid* ellipsoid)
+{
+  // meridional arc after the U.S. Army (TM 5-241-8) in powers of the third flattening
+
+  F64 a = ellipsoid->equatorial_radius;
+  F64 b = ellipsoid->polar_radius;
+  F64 n = (a - b) / (a + b);
+  F64 n2 = n*n;
+  F64 n3 = n2*n;
+  F64 n4 = n3*n;
+  F64 n5 = n4*n;
+  tm->tm_ap = a * (1.0 - n + (5.0/4.0)*(n2 - n3) + (81.0/64.0)*(n4 - n5));
+  tm->tm_bp = (3.0/2.0) * a * (n - n2 + (7.0/8.0)*(n3 - n4) + (55.0/64.0)*n5);
+  tm->tm_cp = (15.0/16.0) * a * (n2 - n3 + (3.0/4.0)*(n4 - n5));
+  tm->tm_dp = (35.0/48.0) * a * (n3 - n4 + (11.0/16.0)*n5);
+  tm->tm_ep = (315.0/512.0) * a * (n4 - n5);
+}
+
+static void inverse_tm(const CRSprojectionParametersTM* tm, const CRSprojectionEllipsoid* ellipsoid, const F64 coordinates2meter, const F64* x, const F64* y, F64* longitude, F64* latitude, const U32 number)
+{
+  F64 a = ellipsoid->equatorial_radius;
+  F64 e2 = ellipsoid->eccentricity_squared;
+  F64 ep2 = ellipsoid->eccentricity_prime_squared;
+  F64 e1 = ellipsoid->eccentricity_e1;
+  F64 k0 = tm->tm_scale_factor;
+  F64 lat0 = tm->tm_lat_origin_radian;
+  F64 M0 = tm->tm_ap*lat0 - tm->tm_bp*sin(2.0*lat0) + tm->tm_cp*sin(4.0*lat0) - tm->tm_dp*sin(6.0*lat0) + tm->tm_ep*sin(8.0*lat0);
+  F64 mu_scale = 1.0 / (a * (1.0 - e2/4.0 - 3.0*e2*e2/64.0 - 5.0*e2*e2*e2/256.0));
+  F64 j1 = 3.0*e1/2.0 - 27.0*e1*e1*e1/32.0;
+  F64 j2 = 21.0*e1*e1/16.0 - 55.0*e1*e1*e1*e1/32.0;
+  F64 j3 = 151.0*e1*e1*e1/96.0;
+  F64 j4 = 1097.0*e1*e1*e1*e1/512.0;
+
+  for (U32 i = 0; i < number; i++)
   {
-    int v = value - EPSG_RGF93_CC42;
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_lambert_conformal_conic_projection(1700000.0, 1200000.0+v*1000000, 42.0+v, 3.0, 41.25+v, 42.75+v, TRUE, 0);
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "RGF93 / CC%d Reseau_Geodesique_Francais_1993", value-3900);
-    return TRUE;
+    F64 easting = x[i]*coordinates2meter - tm->tm_false_easting_meter;
+    F64 northing = y[i]*coordinates2meter - tm->tm_false_northing_meter;
+
+    // footpoint latitude
+
+    F64 mu = (M0 + northing/k0) * mu_scale;
+    F64 phi1 = mu + j1*sin(2.0*mu) + j2*sin(4.0*mu) + j3*sin(6.0*mu) + j4*sin(8.0*mu);
+
+    F64 sin_phi1 = sin(phi1);
+    F64 cos_phi1 = cos(phi1);
+    F64 tan_phi1 = sin_phi1/cos_phi1;
+    F64 w = 1.0 - e2*sin_phi1*sin_phi1;
+    F64 N1 = a/sqrt(w);
+    F64 R1 = a*(1.0 - e2)/(w*sqrt(w));
+    F64 T1 = tan_phi1*tan_phi1;
+    F64 C1 = ep2*cos_phi1*cos_phi1;
+    F64 D = easting/(N1*k0);
+    F64 D2 = D*D;
+
+    latitude[i] = rad2deg*(phi1 - (N1*tan_phi1/R1)*(D2/2.0 - (5.0 + 3.0*T1 + 10.0*C1 - 4.0*C1*C1 - 9.0*ep2)*D2*D2/24.0 + (61.0 + 90.0*T1 + 298.0*C1 + 45.0*T1*T1 - 252.0*ep2 - 3.0*C1*C1)*D2*D2*D2/720.0));
+    longitude[i] = tm->tm_long_meridian_degree + rad2deg*(D - (1.0 + 2.0*T1 + C1)*D2*D/6.0 + (5.0 - 2.0*C1 + 28.0*T1 - 3.0*C1*C1 + 8.0*ep2 + 24.0*T1*T1)*D2*D2*D/120.0)/cos_phi1;
   }
-  else if ((EPSG_ETRS89_DKTM1 <= value) && (value <= EPSG_ETRS89_DKTM4))
+}
+
+static F64 lcc_t(const F64 phi, const F64 e)
+{
+  F64 e_sin_phi = e*sin(phi);
+  return tan(PI_OVER_4 - phi/2.0) / pow((1.0 - e_sin_phi)/(1.0 + e_sin_phi), e/2.0);
+}
+
+static F64 lcc_m(const F64 phi, const F64 e2)
+{
+  F64 sin_phi = sin(phi);
+  return cos(phi)/sqrt(1.0 - e2*sin_phi*sin_phi);
+}
+
+static void compute_lcc_constants(CRSprojectionParametersLCC* lcc, const CRSprojectionEllipsoid* ellipsoid)
+{
+  F64 e = ellipsoid->eccentricity;
+  F64 e2 = ellipsoid->eccentricity_squared;
+  F64 m1 = lcc_m(lcc->lcc_first_std_parallel_radian, e2);
+  F64 m2 = lcc_m(lcc->lcc_second_std_parallel_radian, e2);
+  F64 t0 = lcc_t(lcc->lcc_lat_origin_radian, e);
+  F64 t1 = lcc_t(lcc->lcc_first_std_parallel_radian, e);
+  F64 t2 = lcc_t(lcc->lcc_second_std_parallel_radian, e);
+  if (fabs(lcc->lcc_first_std_parallel_radian - lcc->lcc_second_std_parallel_radian) > 1e-10)
   {
-    int v = ((value - EPSG_ETRS89_DKTM1)%4) + 1;
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(200000.0*v, -5000000.0, 0.0, 9.0 + (v == 1 ? 0.0 : (v == 2 ? 1.0 : (v == 3 ? 2.75 : 6.0))), 0.99998, TRUE, 0);
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "ETRS89 / DKTM%d", v);
-    return TRUE;
+    lcc->lcc_n = (log(m1) - log(m2)) / (log(t1) - log(t2));
   }
-  else if (value == EPSG_ETRS89_UTM32_north_zE_N)
+  else
   {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(32500000.0, 0.0, 0.0, 9.0, 0.9996, TRUE, 0); // "ETRS89 / UTM zone 32N (zE-N)"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "ETRS89 / UTM zone 32N (zE-N)");
-    return TRUE;
+    lcc->lcc_n = sin(lcc->lcc_first_std_parallel_radian);
   }
-  else if ((EPSG_ETRS89_NTM_zone_5 <= value) && (value <= EPSG_ETRS89_NTM_zone_30))
+  lcc->lcc_aF = ellipsoid->equatorial_radius * m1 / (lcc->lcc_n * pow(t1, lcc->lcc_n));
+  lcc->lcc_rho0 = lcc->lcc_aF * pow(t0, lcc->lcc_n);
+}
+
+static void inverse_lcc(const CRSprojectionParametersLCC* lcc, const CRSprojectionEllipsoid* ellipsoid, const F64 coordinates2meter, const F64* x, const F64* y, F64* longitude, F64* latitude, const U32 number)
+{
+  F64 e = ellipsoid->eccentricity;
+  F64 n = lcc->lcc_n;
+  F64 sign = (n < 0.0 ? -1.0 : 1.0);
+  F64 inverse_n = 1.0/n;
+  F64 inverse_aF = 1.0/lcc->lcc_aF;
+
+  for (U32 i = 0; i < number; i++)
   {
-    int v = value - 5100;
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(100000.0, 1000000.0, 58.0, 0.3+v, 1.0, TRUE, 0);
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "ETRS89 / NTM zone %d", v);
-    return TRUE;
+    F64 dx = sign*(x[i]*coordinates2meter - lcc->lcc_false_easting_meter);
+    F64 dy = sign*(lcc->lcc_rho0 - (y[i]*coordinates2meter - lcc->lcc_false_northing_meter));
+    F64 rho = sign*sqrt(dx*dx + dy*dy);
+    F64 theta = atan2(dx, dy);
+    F64 t = pow(rho*inverse_aF, inverse_n);
+
+    // a fixed number of iterations converges to far below a millimeter
+
+    F64 phi = PI_OVER_2 - 2.0*atan(t);
+    for (I32 j = 0; j < 6; j++)
+    {
+      F64 e_sin_phi = e*sin(phi);
+      phi = PI_OVER_2 - 2.0*atan(t*pow((1.0 - e_sin_phi)/(1.0 + e_sin_phi), e/2.0));
+    }
+
+    latitude[i] = rad2deg*phi;
+    longitude[i] = lcc->lcc_long_meridian_degree + rad2deg*theta*inverse_n;
   }
-  else if (value == EPSG_ETRS89_UTM33_north_zE_N)
+}
+
+// the area of use of projected EPSG codes whose extent is much smaller than what
+// their projection allows, as west, south, east, and north in degrees from the EPSG
+// registry. the codes must stay sorted for the binary search in get_area_of_use().
+
+class CRSareaOfUse
+{
+public:
+  U16 code;
+  F64 west;
+  F64 south;
+  F64 east;
+  F64 north;
+};
+
+static const CRSareaOfUse area_of_use_list[] =
+{
+  {  2157, -10.56, 51.39,  -5.34, 55.43 }, // IRENET95 / Irish Transverse Mercator
+  {  2180,  14.14, 49.00,  24.15, 55.93 }, // ETRS89 / Poland CS92
+  {  2193, 166.37, -47.33, 178.63, -34.10 }, // NZGD2000 / New Zealand Transverse Mercator 2000
+  {  2248, -79.49, 37.89, -74.97, 39.73 }, // NAD83 / Maryland (ftUS)
+  {  2285, -124.79, 47.08, -117.02, 49.05 }, // NAD83 / Washington North (ftUS)
+  {  2926, -124.79, 47.08, -117.02, 49.05 }, // NAD83(HARN) / Washington North (ftUS)
+  {  2991, -124.60, 41.98, -116.47, 46.26 }, // NAD83 / Oregon Lambert
+  {  2992, -124.60, 41.98, -116.47, 46.26 }, // NAD83 / Oregon Lambert (ft)
+  {  3006,  10.03, 54.96,  24.17, 69.07 }, // SWEREF99 TM
+  {  3034, -35.58, 24.60,  44.83, 84.73 }, // ETRS89 / ETRS-LCC
+  {  3067,  19.08, 58.84,  31.59, 70.09 }, // ETRS89 / ETRS-TM35FIN
+  {  3582, -79.49, 37.89, -74.97, 39.73 }, // NAD83(NSRS2007) / Maryland (ftUS)
+  {  3794,  13.38, 45.42,  16.61, 46.88 }, // Slovenia 1996 / Slovene National Grid
+  {  3912,  13.38, 45.42,  16.61, 46.88 }, // MGI 1901 / Slovene National Grid
+  { 26985, -79.49, 37.89, -74.97, 39.73 }, // NAD83 / Maryland
+  { 27700,  -9.01, 49.75,   2.01, 61.01 }, // OSGB 1936 / British National Grid
+  { 31370,   2.50, 49.50,   6.40, 51.51 }, // Belge 1972 / Belgian Lambert 72
+  { 32148, -124.79, 47.08, -117.02, 49.05 }, // NAD83 / Washington North
+};
+
+static const I32 area_of_use_number = sizeof(area_of_use_list) / sizeof(CRSareaOfUse);
+
+// the area of use is that of the EPSG code with half a degree to spare when it is
+// in the list above. otherwise it is derived from the projection itself: a UTM zone
+// with one zone on either side, a transverse mercator strip whose half width grows
+// with the scale error that its central scale factor allows, and a lambert conformal
+// conic up to 45 degrees from its central meridian and a few degrees beyond its
+// parallels and its origin. a transverse mercator strip cannot be tested with a box
+// so its half width is returned in strip_width and is zero for all others.
+
+static BOOL get_area_of_use(const CRSprojectionParameters* projection, const U32 epsg, F64* min_longitude, F64* max_longitude, F64* min_latitude, F64* max_latitude, F64* strip_width)
+{
+  *strip_width = 0.0;
+
+  I32 lo = 0;
+  I32 hi = area_of_use_number - 1;
+  while (lo <= hi)
   {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(33500000.0, 0.0, 0.0, 15.0, 0.9996, TRUE, 0); // "ETRS89 / UTM zone 33N (zE-N)"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "ETRS89 / UTM zone 33N (zE-N)");
-    return TRUE;
+    I32 mid = (lo + hi) / 2;
+    if (epsg < area_of_use_list[mid].code)
+    {
+      hi = mid - 1;
+    }
+    else if (epsg > area_of_use_list[mid].code)
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      *min_longitude = area_of_use_list[mid].west - 0.5;
+      *max_longitude = area_of_use_list[mid].east + 0.5;
+      *min_latitude = area_of_use_list[mid].south - 0.5;
+      *max_latitude = area_of_use_list[mid].north + 0.5;
+      return TRUE;
+    }
   }
-  else if (value == EPSG_OSGB_1936)
+
+  switch (projection->type)
   {
-    set_ellipsoid(1, TRUE); // Airy 1830
-    set_transverse_mercator_projection(400000.0, -100000.0, 49.0, -2.0, 0.9996012717, TRUE, 0); // "OSGB 1936 / British National Grid"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "OSGB 1936 / British National Grid");
+  case CRS_PROJECTION_UTM:
+    {
+      const CRSprojectionParametersUTM* utm = (const CRSprojectionParametersUTM*)projection;
+      *min_longitude = utm->utm_long_origin - 9.0;
+      *max_longitude = utm->utm_long_origin + 9.0;
+      *min_latitude = (utm->utm_northern_hemisphere ? -10.0 : -80.5);
+      *max_latitude = (utm->utm_northern_hemisphere ? 84.5 : 10.0);
+    }
     return TRUE;
-  } 
-  else if (value == EPSG_Belgian_Lambert_1972)
-  {
-    set_ellipsoid(CRS_ELLIPSOID_Inter, TRUE);
-    set_lambert_conformal_conic_projection(150000.013, 5400088.438, 90, 4.367486666666666, 51.16666723333333, 49.8333339, TRUE, 0); // "Belge 1972 / Belgian Lambert 72"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "Belge 1972 / Belgian Lambert 72");
+  case CRS_PROJECTION_TM:
+    {
+      // the scale grows to 1/k0 about 2*sqrt(1-k0) radians from the central meridian.
+      // three times that but never less than 6 degrees covers the national grids.
+
+      const CRSprojectionParametersTM* tm = (const CRSprojectionParametersTM*)projection;
+      F64 scale_error = (tm->tm_scale_factor < 1.0 ? 1.0 - tm->tm_scale_factor : 0.0);
+      *strip_width = 6.0*rad2deg*sqrt(scale_error);
+      if (*strip_width < 6.0) *strip_width = 6.0;
+      if (*strip_width > 15.0) *strip_width = 15.0;
+      *min_longitude = tm->tm_long_meridian_degree - 90.0;
+      *max_longitude = tm->tm_long_meridian_degree + 90.0;
+      *min_latitude = -90.0;
+      *max_latitude = 90.0;
+    }
     return TRUE;
-  }
-  else if (value)
-  {
-    // check against list
-    short code = 0;
-    while (epsg_codes[code])
+  case CRS_PROJECTION_LCC:
     {
-      if (epsg_codes[code] == value)
-      {
-        if (description) sprintf(description, epsg_descriptions[code]);
-        return TRUE;
-      }
-      code++;
+      const CRSprojectionParametersLCC* lcc = (const CRSprojectionParametersLCC*)projection;
+      F64 south = lcc->lcc_lat_origin_degree;
+      F64 north = lcc->lcc_lat_origin_degree;
+      if (lcc->lcc_first_std_parallel_degree < south) south = lcc->lcc_first_std_parallel_degree;
+      if (lcc->lcc_first_std_parallel_degree > north) north = lcc->lcc_first_std_parallel_degree;
+      if (lcc->lcc_second_std_parallel_degree < south) south = lcc->lcc_second_std_parallel_degree;
+      if (lcc->lcc_second_std_parallel_degree > north) north = lcc->lcc_second_std_parallel_degree;
+      F64 margin = 4.0 + (north - south)/2.0;
+      *min_longitude = lcc->lcc_long_meridian_degree - 45.0;
+      *max_longitude = lcc->lcc_long_meridian_degree + 45.0;
+      *min_latitude = (south - margin > -80.0 ? south - margin : -90.0);
+      *max_latitude = (north + margin < 80.0 ? north + margin : 90.0);
     }
-    if (description) sprintf(description, "unknown EPSG code %d. please email this particular LAS/LAZ file (or at least a lasinfo report of it) to 'lasvalidator@rapidlasso.com' to have this projection added to the CRS check.", (I32)value);
-    return FALSE;
+    return TRUE;
+  case CRS_PROJECTION_LONG_LAT:
+  case CRS_PROJECTION_LAT_LONG:
+    *min_longitude = -180.0;
+    *max_longitude = 360.0;
+    *min_latitude = -90.0;
+    *max_latitude = 90.0;
+    return TRUE;
   }
-  fprintf(stderr, "CRScheck::set_projection_from_ProjectedCSTypeGeoKey: %d not implemented\n", value);
   return FALSE;
 }
 
-BOOL CRScheck::check_geokeys(LASheader* lasheader, CHAR* description)
+// inside the box and for a transverse mercator also inside the strip along its central meridian
+
+static BOOL is_in_area_of_use(const CRSprojectionParameters* projection, const F64 longitude, const F64 latitude, const F64 min_longitude, const F64 max_longitude, const F64 min_latitude, const F64 max_latitude, const F64 strip_width)
 {
-  BOOL has_projection = FALSE;
-  BOOL user_defined_ellipsoid = FALSE;
-  I32 user_defined_projection = 0;
-  I32 offsetProjStdParallel1GeoKey = -1;
-  I32 offsetProjStdParallel2GeoKey = -1;
-  I32 offsetProjNatOriginLatGeoKey = -1;
-  I32 offsetProjFalseEastingGeoKey = -1;
-  I32 offsetProjFalseNorthingGeoKey = -1;
-  I32 offsetProjCenterLongGeoKey = -1;
-  I32 offsetProjScaleAtNatOriginGeoKey = -1;
-  I32 ellipsoid = -1;
+  if (!((min_longitude <= longitude) && (longitude <= max_longitude) && (min_latitude <= latitude) && (latitude <= max_latitude)))
+  {
+    return FALSE;
+  }
+  if (strip_width > 0.0)
+  {
+    F64 distance = fabs(longitude - ((const CRSprojectionParametersTM*)projection)->tm_long_meridian_degree)*cos(deg2rad*latitude);
+    return (distance <= strip_width);
+  }
+  return TRUE;
+}
 
-  U32 num_geokey_entries = lasheader->geokeys->number_of_keys;
-  LASgeokey_entry* geokey_entries = lasheader->geokey_entries;
-  F64* geokey_double_params = lasheader->geokey_double_params;
+F64 CRScheck::get_coordinates2meter(const BOOL from_geokeys) const
+{
+  switch (coordinate_units[from_geokeys ? 0 : 1])
+  {
+  case 2:
+    return feet2meter;
+  case 3:
+    return surveyfeet2meter;
+  }
+  return 1.0;
+}
 
-  for (U32 i = 0; i < num_geokey_entries; i++)
+BOOL CRScheck::inverse_project(const F64* x, const F64* y, F64* longitude, F64* latitude, const U32 number, const BOOL from_geokeys)
+{
+  CRSprojectionParameters* projection = projections[from_geokeys ? 0 : 1];
+  if (projection == 0)
   {
-    switch (geokey_entries[i].key_id)
+    return FALSE;
+  }
+
+  // without an ellipsoid the projection is assumed to be on WGS 84
+
+  CRSprojectionEllipsoid wgs84;
+  const CRSprojectionEllipsoid* ellipsoid = ellipsoids[from_geokeys ? 0 : 1];
+  if (ellipsoid == 0)
+  {
+    fill_ellipsoid(&wgs84, CRS_ELLIPSOID_WGS84);
+    ellipsoid = &wgs84;
+  }
+
+  F64 coordinates2meter = get_coordinates2meter(from_geokeys);
+  U32 i;
+
+  switch (projection->type)
+  {
+  case CRS_PROJECTION_UTM:
     {
-    case 1024: // GTModelTypeGeoKey
-      if (geokey_entries[i].value_offset == 2) // ModelTypeGeographic
-      {
-        has_projection = set_longlat_projection(TRUE, description);
-      }
-      else if (geokey_entries[i].value_offset == 3) // ModelTypeGeocentric
-      {
-        has_projection = set_ecef_projection(TRUE, description);
-      }
-      else if (geokey_entries[i].value_offset == 0) // ModelTypeUndefined
-      {
-        has_projection = set_no_projection(TRUE, description);
-      }
-      break;
-    case 2048: // GeographicTypeGeoKey
-      switch (geokey_entries[i].value_offset)
-      {
-      case 32767: // user-defined GCS
-        user_defined_ellipsoid = TRUE;
-        break;
-      case 4001: // GCSE_Airy1830
-        ellipsoid = 1;
-        break;
-      case 4002: // GCSE_AiryModified1849 
-        ellipsoid = 16;
-        break;
-      case 4003: // GCSE_AustralianNationalSpheroid
-        ellipsoid = 2;
-        break;
-      case 4004: // GCSE_Bessel1841
-      case 4005: // GCSE_Bessel1841Modified
-        ellipsoid = 3;
-        break;
-      case 4006: // GCSE_BesselNamibia
-        ellipsoid = 4;
-        break;
-      case 4008: // GCSE_Clarke1866
-      case 4009: // GCSE_Clarke1866Michigan
-        ellipsoid = CRS_ELLIPSOID_NAD27;
-        break;
-      case 4010: // GCSE_Clarke1880_Benoit
-      case 4011: // GCSE_Clarke1880_IGN
-      case 4012: // GCSE_Clarke1880_RGS
-      case 4013: // GCSE_Clarke1880_Arc
-      case 4014: // GCSE_Clarke1880_SGA1922
-      case 4034: // GCSE_Clarke1880
-        ellipsoid = 6;
-        break;
-      case 4015: // GCSE_Everest1830_1937Adjustment
-      case 4016: // GCSE_Everest1830_1967Definition
-      case 4017: // GCSE_Everest1830_1975Definition
-        ellipsoid = 7;
-        break;
-      case 4018: // GCSE_Everest1830Modified
-        ellipsoid = 17;
-        break;
-      case 4019: // GCSE_GRS1980
-        ellipsoid = CRS_ELLIPSOID_NAD83;
-        break;
-      case 4020: // GCSE_Helmert1906
-        ellipsoid = 12;
-        break;
-      case 4022: // GCSE_International1924
-      case 4023: // GCSE_International1967
-        ellipsoid = 14;
-        break;
-      case 4024: // GCSE_Krassowsky1940
-        ellipsoid = 15;
-        break;
-      case 4030: // GCSE_WGS84
-        ellipsoid = CRS_ELLIPSOID_WGS84;
-        break;
-      case 4267: // GCS_NAD27
-        ellipsoid = CRS_ELLIPSOID_NAD27;
-        break;
-      case 4269: // GCS_NAD83
-        ellipsoid = CRS_ELLIPSOID_NAD83;
-        break;
-      case 4283: // GCS_GDA94
-        ellipsoid = CRS_ELLIPSOID_GDA94;
-        break;
-      case 4322: // GCS_WGS_72
-        ellipsoid = CRS_ELLIPSOID_WGS72;
-        break;
-      case 4326: // GCS_WGS_84
-        ellipsoid = CRS_ELLIPSOID_WGS84;
-        break;
-      default:
-        fprintf(stderr, "GeographicTypeGeoKey: look-up for %d not implemented\n", geokey_entries[i].value_offset);
-      }
-      break;
-    case 2050: // GeogGeodeticDatumGeoKey 
-      switch (geokey_entries[i].value_offset)
-      {
-      case 32767: // user-defined GCS
-        user_defined_ellipsoid = TRUE;
-        break;
-      case 6202: // Datum_Australian_Geodetic_Datum_1966
-      case 6203: // Datum_Australian_Geodetic_Datum_1984
-        ellipsoid = 2;
-        break;
-      case 6267: // Datum_North_American_Datum_1927
-        ellipsoid = CRS_ELLIPSOID_NAD27;
-        break;
-      case 6269: // Datum_North_American_Datum_1983
-        ellipsoid = CRS_ELLIPSOID_NAD83;
-        break;
-      case 6283: // Datum_Geocentric_Datum_of_Australia_1994
-        ellipsoid = CRS_ELLIPSOID_GDA94;
-        break;
-      case 6322: // Datum_WGS72
-        ellipsoid = CRS_ELLIPSOID_WGS72;
-        break;
-      case 6326: // Datum_WGS84
-        ellipsoid = CRS_ELLIPSOID_WGS84;
-        break;
-      case 6001: // DatumE_Airy1830
-        ellipsoid = 1;
-        break;
-      case 6002: // DatumE_AiryModified1849
-        ellipsoid = 16;
-        break;
-      case 6003: // DatumE_AustralianNationalSpheroid
-        ellipsoid = 2;
-        break;
-      case 6004: // DatumE_Bessel1841
-      case 6005: // DatumE_BesselModified
-        ellipsoid = 3;
-        break;
-      case 6006: // DatumE_BesselNamibia
-        ellipsoid = 4;
-        break;
-      case 6008: // DatumE_Clarke1866
-      case 6009: // DatumE_Clarke1866Michigan
-        ellipsoid = CRS_ELLIPSOID_NAD27;
-        break;
-      case 6010: // DatumE_Clarke1880_Benoit
-      case 6011: // DatumE_Clarke1880_IGN
-      case 6012: // DatumE_Clarke1880_RGS
-      case 6013: // DatumE_Clarke1880_Arc
-      case 6014: // DatumE_Clarke1880_SGA1922
-      case 6034: // DatumE_Clarke1880
-        ellipsoid = 6;
-        break;
-      case 6015: // DatumE_Everest1830_1937Adjustment
-      case 6016: // DatumE_Everest1830_1967Definition
-      case 6017: // DatumE_Everest1830_1975Definition
-        ellipsoid = 7;
-        break;
-      case 6018: // DatumE_Everest1830Modified
-        ellipsoid = 17;
-        break;
-      case 6019: // DatumE_GRS1980
-        ellipsoid = CRS_ELLIPSOID_NAD83;
-        break;
-      case 6020: // DatumE_Helmert1906
-        ellipsoid = 12;
-        break;
-      case 6022: // DatumE_International1924
-      case 6023: // DatumE_International1967
-        ellipsoid = 14;
-        break;
-      case 6024: // DatumE_Krassowsky1940
-        ellipsoid = 15;
-        break;
-      case 6030: // DatumE_WGS84
-        ellipsoid = CRS_ELLIPSOID_WGS84;
-        break;
-      default:
-        fprintf(stderr, "GeogGeodeticDatumGeoKey: look-up for %d not implemented\n", geokey_entries[i].value_offset);
-      }
-      break;
-    case 2052: // GeogLinearUnitsGeoKey 
-      switch (geokey_entries[i].value_offset)
+      const CRSprojectionParametersUTM* utm = (const CRSprojectionParametersUTM*)projection;
+      CRSprojectionParametersTM tm;
+      tm.tm_false_easting_meter = 500000.0;
+      tm.tm_false_northing_meter = (utm->utm_northern_hemisphere ? 0.0 : 10000000.0);
+      tm.tm_lat_origin_degree = 0.0;
+      tm.tm_long_meridian_degree = utm->utm_long_origin;
+      tm.tm_scale_factor = 0.9996;
+      tm.tm_lat_origin_radian = 0.0;
+      tm.tm_long_meridian_radian = deg2rad*tm.tm_long_meridian_degree;
+      compute_tm_constants(&tm, ellipsoid);
+      inverse_tm(&tm, ellipsoid, coordinates2meter, x, y, longitude, latitude, number);
+    }
+    return TRUE;
+  case CRS_PROJECTION_TM:
+    compute_tm_constants((CRSprojectionParametersTM*)projection, ellipsoid);
+    inverse_tm((const CRSprojectionParametersTM*)projection, ellipsoid, coordinates2meter, x, y, longitude, latitude, number);
+    return TRUE;
+  case CRS_PROJECTION_LCC:
+    compute_lcc_constants((CRSprojectionParametersLCC*)projection, ellipsoid);
+    inverse_lcc((const CRSprojectionParametersLCC*)projection, ellipsoid, coordinates2meter, x, y, longitude, latitude, number);
+    return TRUE;
+  case CRS_PROJECTION_LONG_LAT:
+    for (i = 0; i < number; i++)
+    {
+      longitude[i] = x[i];
+      latitude[i] = y[i];
+    }
+    return TRUE;
+  case CRS_PROJECTION_LAT_LONG:
+    for (i = 0; i < number; i++)
+    {
+      longitude[i] = y[i];
+      latitude[i] = x[i];
+    }
+    return TRUE;
+  }
+  return FALSE;
+}
+
+#define CRS_AREA_OF_USE_CHUNK 256
+
+static void describe_position(CHAR* string, const F64 longitude, const F64 latitude)
+{
+  if ((fabs(latitude) <= 90.0) && (fabs(longitude) <= 540.0))
+  {
+    sprintf(string, "with longitude %.4f and latitude %.4f", longitude, latitude);
+  }
+  else
+  {
+    sprintf(string, "with no valid inverse projection");
+  }
+}
+
+void CRScheck::check_area_of_use(LASheader* lasheader, const I32* X, const I32* Y, const U32 number)
+{
+  CHAR note[1024];
+  CHAR string1[64];
+  CHAR string2[64];
+  CHAR position[128];
+  CHAR crs[256];
+  F64 min_longitude, max_longitude, min_latitude, max_latitude, strip_width;
+  U32 i;
+
+  // the bounding box of a file without points is meaningless and already fails elsewhere
+
+  if ((number == 0) && (lasheader->number_of_point_records == 0) && (lasheader->legacy_number_of_point_records == 0))
+  {
+    return;
+  }
+
+  BOOL from_geokeys = (projections[0] != 0);
+  const CRSprojectionParameters* projection = projections[from_geokeys ? 0 : 1];
+  U32 epsg = horizontal_epsg[from_geokeys ? 0 : 1];
+  if ((projection == 0) || !get_area_of_use(projection, epsg, &min_longitude, &max_longitude, &min_latitude, &max_latitude, &strip_width))
+  {
+    return;
+  }
+
+  // the notes name the EPSG code so that a wrong one can be found
+
+  if (epsg)
+  {
+    const CHAR* description = get_epsg_description((U16)epsg);
+    sprintf(crs, "EPSG code %u (%.200s)", epsg, (description ? description : projection->name));
+  }
+  else
+  {
+    sprintf(crs, "%.200s", projection->name);
+  }
+
+  // the four corners of the bounding box followed by the same corners with x and y swapped
+
+  F64 corner_x[8] = { lasheader->min_x, lasheader->max_x, lasheader->max_x, lasheader->min_x, lasheader->min_y, lasheader->min_y, lasheader->max_y, lasheader->max_y };
+  F64 corner_y[8] = { lasheader->min_y, lasheader->min_y, lasheader->max_y, lasheader->max_y, lasheader->min_x, lasheader->max_x, lasheader->max_x, lasheader->min_x };
+  F64 x[CRS_AREA_OF_USE_CHUNK];
+  F64 y[CRS_AREA_OF_USE_CHUNK];
+  F64 longitude[CRS_AREA_OF_USE_CHUNK];
+  F64 latitude[CRS_AREA_OF_USE_CHUNK];
+
+  if (!inverse_project(corner_x, corner_y, longitude, latitude, 8, from_geokeys))
+  {
+    return;
+  }
+
+  I32 outside = -1;
+  BOOL swapped_inside = TRUE;
+  for (i = 0; i < 8; i++)
+  {
+    BOOL inside = is_in_area_of_use(projection, longitude[i], latitude[i], min_longitude, max_longitude, min_latitude, max_latitude, strip_width);
+    if (i < 4)
+    {
+      if (!inside && (outside == -1)) outside = i;
+    }
+    else if (!inside)
+    {
+      swapped_inside = FALSE;
+    }
+  }
+
+  if (outside != -1)
+  {
+    lidardouble2string(string1, corner_x[outside], lasheader->x_scale_factor);
+    lidardouble2string(string2, corner_y[outside], lasheader->y_scale_factor);
+    describe_position(position, longitude[outside], latitude[outside]);
+    if (swapped_inside)
+    {
+      sprintf(note, "bounding box corner (%s, %s) is outside of %s %s but would be inside with x and y swapped", string1, string2, crs, position);
+    }
+    else
+    {
+      sprintf(note, "bounding box corner (%s, %s) is outside of %s %s. wrong EPSG code or coordinate units?", string1, string2, crs, position);
+    }
+    lasheader->add_fail("CRS", note);
+    return;
+  }
+
+  // the sampled points matter when the bounding box is fine but the points are not.
+  // they are scaled and projected in chunks so that nothing needs to be allocated.
+
+  U32 number_outside = 0;
+  F64 example[4] = { 0.0, 0.0, 0.0, 0.0 };
+  for (U32 start = 0; start < number; start += CRS_AREA_OF_USE_CHUNK)
+  {
+    U32 count = ((number - start) < CRS_AREA_OF_USE_CHUNK ? (number - start) : CRS_AREA_OF_USE_CHUNK);
+    for (i = 0; i < count; i++)
+    {
+      x[i] = lasheader->get_x(X[start + i]);
+      y[i] = lasheader->get_y(Y[start + i]);
+    }
+    inverse_project(x, y, longitude, latitude, count, from_geokeys);
+    for (i = 0; i < count; i++)
+    {
+      if (!is_in_area_of_use(projection, longitude[i], latitude[i], min_longitude, max_longitude, min_latitude, max_latitude, strip_width))
       {
-      case 9001: // Linear_Meter
-        break;
-      case 9002: // Linear_Foot
-        break;
-      case 9003: // Linear_Foot_US_Survey
-        break;
-      default:
-        fprintf(stderr, "GeogLinearUnitsGeoKey: look-up for %d not implemented\n", geokey_entries[i].value_offset);
+        if (number_outside == 0)
+        {
+          example[0] = x[i];
+          example[1] = y[i];
+          example[2] = longitude[i];
+          example[3] = latitude[i];
+        }
+        number_outside++;
       }
-      break;
-    case 2056: // GeogEllipsoidGeoKey
-      switch (geokey_entries[i].value_offset)
+    }
+  }
+
+  if (number_outside)
+  {
+    lidardouble2string(string1, example[0], lasheader->x_scale_factor);
+    lidardouble2string(string2, example[1], lasheader->y_scale_factor);
+    describe_position(position, example[2], example[3]);
+    sprintf(note, "%u of %u sampled points are outside of %s such as (%s, %s) %s", number_outside, number, crs, string1, string2, position);
+    lasheader->add_fail("CRS", note);
+  }
+}
+
+// a process-wide cache of the verdicts of the CRS check. the key is built from
+// everything the check reads from the header: the geokey entries with the
+// double parameters they reference, the OGC WKT string, and the no_CRS_fail
+// flag. an entry keeps the description, the warnings and fails that were added
+// to the header, and a copy of the resolved units, ellipsoids, and projections
+// so that files with identical CRS VLRs are only checked once. the cache is
+// guarded by a lock because several workers may check files at the same time.
+
+#define CRS_CACHE_BUCKETS 1024
+#define CRS_CACHE_MAX_ENTRIES 4096
+
+class CRScacheEntry
+{
+public:
+  U64 hash;
+  U32 key_size;
+  U8* key;
+  CHAR* description;
+  I32 fail_num;
+  CHAR** fails;
+  I32 warning_num;
+  CHAR** warnings;
+  CRScheck crscheck;
+  CRScacheEntry* next;
+};
+
+static CRScacheEntry* crs_cache_buckets[CRS_CACHE_BUCKETS];
+static U32 crs_cache_entries = 0;
+
+#ifdef _WIN32
+static SRWLOCK crs_cache_lock = SRWLOCK_INIT;
+static void crs_cache_acquire() { AcquireSRWLockExclusive(&crs_cache_lock); }
+static void crs_cache_release() { ReleaseSRWLockExclusive(&crs_cache_lock); }
+#else
+static pthread_mutex_t crs_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+static void crs_cache_acquire() { pthread_mutex_lock(&crs_cache_lock); }
+static void crs_cache_release() { pthread_mutex_unlock(&crs_cache_lock); }
+#endif
+
+static U64 crs_cache_hash(const U8* key, const U32 key_size)
+{
+  U64 h = 14695981039346656037ull;
+  for (U32 i = 0; i < key_size; i++)
+  {
+    h ^= key[i];
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+// the key is built in a buffer on the stack and only goes to the heap when it
+// is too long for the buffer or when it is stored in the cache
+
+#define CRS_CACHE_KEY_BUFFER 2048
+
+class CRScacheKey
+{
+public:
+  U8* data;
+  U32 size;
+  U32 alloc;
+  U8 buffer[CRS_CACHE_KEY_BUFFER];
+  void append(const void* bytes, const U32 number)
+  {
+    if ((size + number) > alloc)
+    {
+      alloc = 2*(size + number);
+      if (data == buffer)
       {
-      case 7001: // Ellipse_Airy_1830
-        ellipsoid = 1;
-        break;
-      case 7002: // Ellipse_Airy_Modified_1849
-        ellipsoid = 16;
-        break;
-      case 7003: // Ellipse_Australian_National_Spheroid
-        ellipsoid = 2;
-        break;
-      case 7004: // Ellipse_Bessel_1841
-      case 7005: // Ellipse_Bessel_Modified
-        ellipsoid = 3;
-        break;
-      case 7006: // Ellipse_Bessel_Namibia
-        ellipsoid = 4;
-        break;
-      case 7008: // Ellipse_Clarke_1866
-      case 7009: // Ellipse_Clarke_1866_Michigan
-        ellipsoid = CRS_ELLIPSOID_NAD27;
-        break;
-      case 7010: // Ellipse_Clarke1880_Benoit
-      case 7011: // Ellipse_Clarke1880_IGN
-      case 7012: // Ellipse_Clarke1880_RGS
-      case 7013: // Ellipse_Clarke1880_Arc
-      case 7014: // Ellipse_Clarke1880_SGA1922
-      case 7034: // Ellipse_Clarke1880
-        ellipsoid = 6;
-        break;
-      case 7015: // Ellipse_Everest1830_1937Adjustment
-      case 7016: // Ellipse_Everest1830_1967Definition
-      case 7017: // Ellipse_Everest1830_1975Definition
-        ellipsoid = 7;
-        break;
-      case 7018: // Ellipse_Everest1830Modified
-        ellipsoid = 17;
-        break;
-      case 7019: // Ellipse_GRS_1980
-        ellipsoid = CRS_ELLIPSOID_NAD83;
-        break;
-      case 7020: // Ellipse_Helmert1906
-        ellipsoid = 12;
-        break;
-      case 7022: // Ellipse_International1924
-      case 7023: // Ellipse_International1967
-        ellipsoid = 14;
-        break;
-      case 7024: // Ellipse_Krassowsky1940
-        ellipsoid = 15;
-        break;
-      case 7030: // Ellipse_WGS_84
-        ellipsoid = CRS_ELLIPSOID_WGS84;
-        break;
-      default:
-        fprintf(stderr, "GeogEllipsoidGeoKey: look-up for %d not implemented\n", geokey_entries[i].value_offset);
+        data = (U8*)malloc(alloc);
+        memcpy(data, buffer, size);
       }
-      break;
-    case 3072: // ProjectedCSTypeGeoKey
-      if (geokey_entries[i].value_offset != 32767)
-        has_projection = set_projection_from_ProjectedCSTypeGeoKey(geokey_entries[i].value_offset, description);
-      break;
-    case 3075: // ProjCoordTransGeoKey
-      user_defined_projection = 0;
-      switch (geokey_entries[i].value_offset)
+      else
       {
-      case 1: // CT_TransverseMercator
-        user_defined_projection = 1;
-        break;
-      case 8: // CT_LambertConfConic_2SP
-        user_defined_projection = 8;
-        break;
-      case 2: // CT_TransvMercator_Modified_Alaska
-        fprintf(stderr, "ProjCoordTransGeoKey: CT_TransvMercator_Modified_Alaska not implemented\n");
-        break;
-      case 3: // CT_ObliqueMercator
-        fprintf(stderr, "ProjCoordTransGeoKey: CT_ObliqueMercator not implemented\n");
-        break;
-      case 4: // CT_ObliqueMercator_Laborde
-        fprintf(stderr, "ProjCoordTransGeoKey: CT_ObliqueMercator_Laborde not implemented\n");
-        break;
-      case 5: // CT_ObliqueMercator_Rosenmund
-        fprintf(stderr, "ProjCoordTransGeoKey: CT_ObliqueMercator_Rosenmund not implemented\n");
-        break;
-      case 6: // CT_ObliqueMercator_Spherical
-        fprintf(stderr, "ProjCoordTransGeoKey: CT_ObliqueMercator_Spherical not implemented\n");
-        break;
-      case 7: // CT_Mercator
-        fprintf(stderr, "ProjCoordTransGeoKey: CT_Mercator not implemented\n");
-        break;
-      case 9: // CT_LambertConfConic_Helmert
-        fprintf(stderr, "ProjCoordTransGeoKey: CT_LambertConfConic_Helmert not implemented\n");
-        break;
-      case 10: // CT_LambertAzimEqualArea
-        fprintf(stderr, "ProjCoordTransGeoKey: CT_LambertAzimEqualArea not implemented\n");
-        break;
-      case 11: // CT_AlbersEqualArea
-        fprintf(stderr, "ProjCoordTransGeoKey: CT_AlbersEqualArea not implemented\n");
-        break;
-      case 12: // CT_AzimuthalEquidistant
-        fprintf(stderr, "ProjCoordTransGeoKey: CT_AzimuthalEquidistant not implemented\n");
-        break;
-      case 13: // CT_EquidistantConic
-        fprintf(stderr, "ProjCoordTransGeoKey: CT_EquidistantConic not implemented\n");
-        break;
-      case 14: // CT_Stereographic
-        fprintf(stderr, "ProjCoordTransGeoKey: CT_Stereographic not implemented\n");
-        break;
-      case 15: // CT_PolarStereographic
-        fprintf(stderr, "ProjCoordTransGeoKey: CT_PolarStereographic not implemented\n");
-        break;
-      case 16: // CT_ObliqueStereographic
-        fprintf(stderr, "ProjCoordTransGeoKey: CT_ObliqueStereographic not implemented\n");
-        break;
-      case 17: // CT_Equirectangular
-        fprintf(stderr, "ProjCoordTransGeoKey: CT_Equirectangular not implemented\n");
-        break;
-      case 18: // CT_CassiniSoldner
-        fprintf(stderr, "ProjCoordTransGeoKey: CT_CassiniSoldner not implemented\n");
-        break;
-      case 19: // CT_Gnomonic
-        fprintf(stderr, "ProjCoordTransGeoKey: CT_Gnomonic not implemented\n");
-        break;
-      case 20: // CT_MillerCylindrical
-        fprintf(stderr, "ProjCoordTransGeoKey: CT_MillerCylindrical not implemented\n");
-        break;
-      case 21: // CT_Orthographic
-        fprintf(stderr, "ProjCoordTransGeoKey: CT_Orthographic not implemented\n");
-        break;
-      case 22: // CT_Polyconic
-        fprintf(stderr, "ProjCoordTransGeoKey: CT_Polyconic not implemented\n");
-        break;
-      case 23: // CT_Robinson
-        fprintf(stderr, "ProjCoordTransGeoKey: CT_Robinson not implemented\n");
-        break;
-      case 24: // CT_Sinusoidal
-        fprintf(stderr, "ProjCoordTransGeoKey: CT_Sinusoidal not implemented\n");
-        break;
-      case 25: // CT_VanDerGrinten
-        fprintf(stderr, "ProjCoordTransGeoKey: CT_VanDerGrinten not implemented\n");
-        break;
-      case 26: // CT_NewZealandMapGrid
-        fprintf(stderr, "ProjCoordTransGeoKey: CT_NewZealandMapGrid not implemented\n");
-        break;
-      case 27: // CT_TransvMercator_SouthOriented
-        fprintf(stderr, "ProjCoordTransGeoKey: CT_TransvMercator_SouthOriented not implemented\n");
-        break;
-      default:
-        fprintf(stderr, "ProjCoordTransGeoKey: look-up for %d not implemented\n", geokey_entries[i].value_offset);
+        data = (U8*)realloc(data, alloc);
+      }
+    }
+    memcpy(data + size, bytes, number);
+    size += number;
+  };
+  U8* detach()
+  {
+    U8* detached = data;
+    if (data == buffer)
+    {
+      detached = (U8*)malloc(size);
+      memcpy(detached, buffer, size);
+    }
+    data = buffer;
+    size = 0;
+    alloc = CRS_CACHE_KEY_BUFFER;
+    return detached;
+  };
+  CRScacheKey() { data = buffer; size = 0; alloc = CRS_CACHE_KEY_BUFFER; };
+  ~CRScacheKey() { if (data != buffer) free(data); };
+};
+
+// the OGC WKT need not be terminated within its VLR so its length is taken from the VLR
+
+static U32 get_wkt_length(const LASheader* lasheader)
+{
+  U32 i;
+  for (i = 0; i < lasheader->number_of_variable_length_records; i++)
+  {
+    if (lasheader->vlrs[i].data == (U8*)lasheader->ogc_wkt)
+    {
+      return lasheader->vlrs[i].record_length_after_header;
+    }
+  }
+  for (i = 0; i < lasheader->number_of_extended_variable_length_records; i++)
+  {
+    if (lasheader->evlrs[i].data == (U8*)lasheader->ogc_wkt)
+    {
+      return (U32)lasheader->evlrs[i].record_length_after_header;
+    }
+  }
+  return (U32)strlen(lasheader->ogc_wkt);
+}
+
+static void crs_cache_key(const LASheader* lasheader, const BOOL no_CRS_fail, CRScacheKey* key)
+{
+  U32 flags = (no_CRS_fail ? 1 : 0);
+  if (lasheader->geokeys) flags |= 2;
+  if (lasheader->ogc_wkt) flags |= ((lasheader->ogc_wkt == lasheader->file_signature) ? 4 : 8);
+  key->append(&flags, sizeof(U32));
+
+  if (lasheader->geokeys)
+  {
+    U32 num_geokey_entries = lasheader->geokeys->number_of_keys;
+    key->append(&num_geokey_entries, sizeof(U32));
+    for (U32 i = 0; i < num_geokey_entries; i++)
+    {
+      const LASgeokey_entry* entry = &(lasheader->geokey_entries[i]);
+      key->append(&(entry->key_id), sizeof(U16));
+      key->append(&(entry->tiff_tag_location), sizeof(U16));
+      key->append(&(entry->count), sizeof(U16));
+      key->append(&(entry->value_offset), sizeof(U16));
+      if ((entry->tiff_tag_location == 34736) && lasheader->geokey_double_params)
+      {
+        key->append(&(lasheader->geokey_double_params[entry->value_offset]), sizeof(F64));
       }
+    }
+  }
+
+  if (flags & 8)
+  {
+    U32 length = get_wkt_length(lasheader);
+    key->append(&length, sizeof(U32));
+    key->append(lasheader->ogc_wkt, length);
+  }
+}
+
+static CHAR** crs_cache_copy_notes(CHAR** notes, const I32 start, const I32 end)
+{
+  if (start >= end)
+  {
+    return 0;
+  }
+  CHAR** copies = (CHAR**)malloc(sizeof(CHAR*)*(end - start));
+  for (I32 i = start; i < end; i++)
+  {
+    copies[i - start] = strdup(notes[i]);
+  }
+  return copies;
+}
+
+void CRScheck::copy(const CRScheck* other)
+{
+  for (I32 i = 0; i < 2; i++)
+  {
+    horizontal_epsg[i] = other->horizontal_epsg[i];
+    coordinate_units[i] = other->coordinate_units[i];
+    elevation_units[i] = other->elevation_units[i];
+    vertical_epsg[i] = other->vertical_epsg[i];
+    ellipsoid_storage[i] = other->ellipsoid_storage[i];
+    ellipsoids[i] = (other->ellipsoids[i] ? &(ellipsoid_storage[i]) : 0);
+    projection_storage[i] = other->projection_storage[i];
+    projections[i] = (other->projections[i] ? (CRSprojectionParameters*)(projection_storage[i].bytes) : 0);
+  }
+}
+
+void CRScheck::check(LASheader* lasheader, CHAR* description, BOOL no_CRS_fail)
+{
+  reset();
+
+  CRScacheKey key;
+  crs_cache_key(lasheader, no_CRS_fail, &key);
+  U64 hash = crs_cache_hash(key.data, key.size);
+  U32 bucket = (U32)(hash & (CRS_CACHE_BUCKETS-1));
+
+  crs_cache_acquire();
+  CRScacheEntry* entry = crs_cache_buckets[bucket];
+  while (entry)
+  {
+    if ((entry->hash == hash) && (entry->key_size == key.size) && (memcmp(entry->key, key.data, key.size) == 0))
+    {
       break;
-    case 3076: // ProjLinearUnitsGeoKey
-      set_coordinates_from_ProjLinearUnitsGeoKey(geokey_entries[i].value_offset);
-      break;
-    case 3078: // ProjStdParallel1GeoKey
-      offsetProjStdParallel1GeoKey = geokey_entries[i].value_offset;
-      break;
-    case 3079: // ProjStdParallel2GeoKey
-      offsetProjStdParallel2GeoKey = geokey_entries[i].value_offset;
-      break;        
-    case 3081: // ProjNatOriginLatGeoKey
-      offsetProjNatOriginLatGeoKey = geokey_entries[i].value_offset;
-      break;
-    case 3082: // ProjFalseEastingGeoKey
-      offsetProjFalseEastingGeoKey = geokey_entries[i].value_offset;
-      break;
-    case 3083: // ProjFalseNorthingGeoKey
-      offsetProjFalseNorthingGeoKey = geokey_entries[i].value_offset;
-      break;
-    case 3088: // ProjCenterLongGeoKey
-      offsetProjCenterLongGeoKey = geokey_entries[i].value_offset;
-      break;
-    case 3092: // ProjScaleAtNatOriginGeoKey
-      offsetProjScaleAtNatOriginGeoKey = geokey_entries[i].value_offset;
-      break;
-    case 4096: // VerticalCSTypeGeoKey 
-      set_vertical_from_VerticalCSTypeGeoKey(geokey_entries[i].value_offset);
-      break;
-    case 4099: // VerticalUnitsGeoKey
-      set_elevation_from_VerticalUnitsGeoKey(geokey_entries[i].value_offset);
-      break;
     }
+    entry = entry->next;
+  }
+  if (entry)
+  {
+    if (description && entry->description)
+    {
+      strcpy(description, entry->description);
+    }
+    for (I32 i = 0; i < entry->fail_num; i += 2)
+    {
+      lasheader->add_fail(entry->fails[i], entry->fails[i+1]);
+    }
+    for (I32 i = 0; i < entry->warning_num; i += 2)
+    {
+      lasheader->add_warning(entry->warnings[i], entry->warnings[i+1]);
+    }
+    copy(&(entry->crscheck));
+    crs_cache_release();
+    return;
   }
+  crs_cache_release();
 
-  if (ellipsoid != -1)
+  // a miss is checked outside of the lock
+
+  I32 fail_num = lasheader->fail_num;
+  I32 warning_num = lasheader->warning_num;
+  CHAR checked_description[512];
+  checked_description[0] = '\0';
+
+  check_uncached(lasheader, checked_description, no_CRS_fail);
+
+  if (description && checked_description[0])
   {
-    set_ellipsoid(ellipsoid, TRUE);
+    strcpy(description, checked_description);
   }
 
-  if (!has_projection)
+  crs_cache_acquire();
+  if (crs_cache_entries < CRS_CACHE_MAX_ENTRIES)
   {
-    if (user_defined_projection == 1)
+    entry = new CRScacheEntry();
+    entry->hash = hash;
+    entry->key_size = key.size;
+    entry->key = key.detach();
+    entry->description = (checked_description[0] ? strdup(checked_description) : 0);
+    entry->fail_num = lasheader->fail_num - fail_num;
+    entry->fails = crs_cache_copy_notes(lasheader->fails, fail_num, lasheader->fail_num);
+    entry->warning_num = lasheader->warning_num - warning_num;
+    entry->warnings = crs_cache_copy_notes(lasheader->warnings, warning_num, lasheader->warning_num);
+    entry->crscheck.copy(this);
+    entry->next = crs_cache_buckets[bucket];
+    crs_cache_buckets[bucket] = entry;
+    crs_cache_entries++;
+  }
+  crs_cache_release();
+}
+
+// the OGC WKT is resolved into the second set of units, ellipsoid, and projection
+// (the first set is resolved from the geokeys) so that both can be compared
+
+static I32 find_ellipsoid(const F64 semi_major_axis, const F64 inverse_flattening)
+{
+  I32 best = -1;
+  F64 best_difference = 1e-3;
+  for (I32 i = 1; i < 25; i++)
+  {
+    if (fabs(ellipsoid_list[i].equatorialRadius - semi_major_axis) < 0.5)
     {
-      if ((offsetProjFalseEastingGeoKey >= 0) &&
-          (offsetProjFalseNorthingGeoKey >= 0) &&
-          (offsetProjNatOriginLatGeoKey >= 0) &&
-          (offsetProjCenterLongGeoKey >= 0) &&
-          (offsetProjScaleAtNatOriginGeoKey >= 0))
+      F64 difference = fabs(ellipsoid_list[i].inverseFlattening - inverse_flattening);
+      if (difference < best_difference)
       {
-        F64 falseEasting = geokey_double_params[offsetProjFalseEastingGeoKey];
-        F64 falseNorthing = geokey_double_params[offsetProjFalseNorthingGeoKey];
-        F64 latOriginDeg = geokey_double_params[offsetProjNatOriginLatGeoKey];
-        F64 longMeridianDeg = geokey_double_params[offsetProjCenterLongGeoKey];
-        F64 scaleFactor = geokey_double_params[offsetProjScaleAtNatOriginGeoKey];
-        set_transverse_mercator_projection(falseEasting, falseNorthing, latOriginDeg, longMeridianDeg, scaleFactor, TRUE, description);
-        if (description)
-        {
-          sprintf(description, "generic transverse mercator");
-        }
-        has_projection = TRUE;
+        best = i;
+        best_difference = difference;
       }
     }
-    else if (user_defined_projection == 8)
+  }
+  return best;
+}
+
+static BOOL same_projection(const CRSprojectionParameters* a, const CRSprojectionParameters* b)
+{
+  if (a->type != b->type)
+  {
+    return FALSE;
+  }
+  if (a->type == CRS_PROJECTION_UTM)
+  {
+    const CRSprojectionParametersUTM* utm_a = (const CRSprojectionParametersUTM*)a;
+    const CRSprojectionParametersUTM* utm_b = (const CRSprojectionParametersUTM*)b;
+    return ((utm_a->utm_zone_number == utm_b->utm_zone_number) && (utm_a->utm_northern_hemisphere == utm_b->utm_northern_hemisphere));
+  }
+  if (a->type == CRS_PROJECTION_TM)
+  {
+    const CRSprojectionParametersTM* tm_a = (const CRSprojectionParametersTM*)a;
+    const CRSprojectionParametersTM* tm_b = (const CRSprojectionParametersTM*)b;
+    return ((fabs(tm_a->tm_false_easting_meter - tm_b->tm_false_easting_meter) < 0.01) &&
+            (fabs(tm_a->tm_false_northing_meter - tm_b->tm_false_northing_meter) < 0.01) &&
+            (fabs(tm_a->tm_lat_origin_degree - tm_b->tm_lat_origin_degree) < 1e-6) &&
+            (fabs(tm_a->tm_long_meridian_degree - tm_b->tm_long_meridian_degree) < 1e-6) &&
+            (fabs(tm_a->tm_scale_factor - tm_b->tm_scale_factor) < 1e-8));
+  }
+  if (a->type == CRS_PROJECTION_LCC)
+  {
+    const CRSprojectionParametersLCC* lcc_a = (const CRSprojectionParametersLCC*)a;
+    const CRSprojectionParametersLCC* lcc_b = (const CRSprojectionParametersLCC*)b;
+    return ((fabs(lcc_a->lcc_false_easting_meter - lcc_b->lcc_false_easting_meter) < 0.01) &&
+            (fabs(lcc_a->lcc_false_northing_meter - lcc_b->lcc_false_northing_meter) < 0.01) &&
+            (fabs(lcc_a->lcc_lat_origin_degree - lcc_b->lcc_lat_origin_degree) < 1e-6) &&
+            (fabs(lcc_a->lcc_long_meridian_degree - lcc_b->lcc_long_meridian_degree) < 1e-6) &&
+            (fabs(lcc_a->lcc_first_std_parallel_degree - lcc_b->lcc_first_std_parallel_degree) < 1e-6) &&
+            (fabs(lcc_a->lcc_second_std_parallel_degree - lcc_b->lcc_second_std_parallel_degree) < 1e-6));
+  }
+  return TRUE;
+}
+
+// UTM zones are compared with a transverse mercator as one
+
+static CRSprojectionParameters* as_transverse_mercator(const CRSprojectionParameters* projection, CRSprojectionParametersTM* tm)
+{
+  if (projection->type != CRS_PROJECTION_UTM)
+  {
+    return (CRSprojectionParameters*)projection;
+  }
+  const CRSprojectionParametersUTM* utm = (const CRSprojectionParametersUTM*)projection;
+  tm->type = CRS_PROJECTION_TM;
+  strcpy(tm->name, utm->name);
+  tm->tm_false_easting_meter = 500000.0;
+  tm->tm_false_northing_meter = (utm->utm_northern_hemisphere ? 0.0 : 10000000.0);
+  tm->tm_lat_origin_degree = 0.0;
+  tm->tm_long_meridian_degree = utm->utm_long_origin;
+  tm->tm_scale_factor = 0.9996;
+  return tm;
+}
+
+static const CHAR* units_name(const U32 units)
+{
+  switch (units)
+  {
+  case 1:
+    return "meter";
+  case 2:
+    return "feet";
+  case 3:
+    return "US survey feet";
+  }
+  return "unknown";
+}
+
+static U32 units_from_factor(const F64 factor)
+{
+  if (fabs(factor - 1.0) < 1e-9) return 1;
+  if (fabs(factor - feet2meter) < 1e-9) return 2;
+  if (fabs(factor - surveyfeet2meter) < 1e-9) return 3;
+  return 0;
+}
+
+void CRScheck::get_identity(const LASheader* lasheader, CRSidentity* identity) const
+{
+  U32 slot = ((projections[0] || horizontal_epsg[0]) ? 0 : 1);
+  identity->horizontal_epsg = horizontal_epsg[slot];
+  identity->coordinate_units = (coordinate_units[0] ? coordinate_units[0] : coordinate_units[1]);
+  identity->elevation_units = (elevation_units[0] ? elevation_units[0] : elevation_units[1]);
+  identity->vertical_epsg = (vertical_epsg[0] ? vertical_epsg[0] : vertical_epsg[1]);
+
+  // the parameters tell apart user-defined projections that have no EPSG code. UTM
+  // zones are hashed as the transverse mercator they are so the geokeys and the WKT agree
+
+  identity->projection_fingerprint = 0;
+  const CRSprojectionParameters* projection = projections[slot];
+  if (projection)
+  {
+    CRSprojectionParametersTM utm_as_tm;
+    projection = as_transverse_mercator(projection, &utm_as_tm);
+    I32 ellipsoid_id = (ellipsoids[slot] ? ellipsoids[slot]->id : 0);
+    U32 number_of_parameters = 0;
+    F64 parameters[6];
+    if (projection->type == CRS_PROJECTION_LCC)
     {
-      if ((offsetProjFalseEastingGeoKey >= 0) &&
-          (offsetProjFalseNorthingGeoKey >= 0) &&
-          (offsetProjNatOriginLatGeoKey >= 0) &&
-          (offsetProjCenterLongGeoKey >= 0) &&
-          (offsetProjStdParallel1GeoKey >= 0) &&
-          (offsetProjStdParallel2GeoKey >= 0))
-      {
-        F64 falseEasting = geokey_double_params[offsetProjFalseEastingGeoKey];
-        F64 falseNorthing = geokey_double_params[offsetProjFalseNorthingGeoKey];
-        F64 latOriginDeg = geokey_double_params[offsetProjNatOriginLatGeoKey];
-        F64 longOriginDeg = geokey_double_params[offsetProjCenterLongGeoKey];
-        F64 firstStdParallelDeg = geokey_double_params[offsetProjStdParallel1GeoKey];
-        F64 secondStdParallelDeg = geokey_double_params[offsetProjStdParallel2GeoKey];
-        set_lambert_conformal_conic_projection(falseEasting, falseNorthing, latOriginDeg, longOriginDeg, firstStdParallelDeg, secondStdParallelDeg, TRUE, description);
-        if (description)
-        {
-          sprintf(description, "generic lambert conformal conic");
-        }
-        has_projection = TRUE;
-      }
+      const CRSprojectionParametersLCC* lcc = (const CRSprojectionParametersLCC*)projection;
+      parameters[0] = lcc->lcc_false_easting_meter;
+      parameters[1] = lcc->lcc_false_northing_meter;
+      parameters[2] = lcc->lcc_lat_origin_degree;
+      parameters[3] = lcc->lcc_long_meridian_degree;
+      parameters[4] = lcc->lcc_first_std_parallel_degree;
+      parameters[5] = lcc->lcc_second_std_parallel_degree;
+      number_of_parameters = 6;
+    }
+    else if (projection->type == CRS_PROJECTION_TM)
+    {
+      const CRSprojectionParametersTM* tm = (const CRSprojectionParametersTM*)projection;
+      parameters[0] = tm->tm_false_easting_meter;
+      parameters[1] = tm->tm_false_northing_meter;
+      parameters[2] = tm->tm_lat_origin_degree;
+      parameters[3] = tm->tm_long_meridian_degree;
+      parameters[4] = tm->tm_scale_factor;
+      number_of_parameters = 5;
+    }
+    CRScacheKey key;
+    key.append(&(projection->type), sizeof(I32));
+    key.append(&ellipsoid_id, sizeof(I32));
+    for (U32 i = 0; i < number_of_parameters; i++)
+    {
+      F64 parameter = parameters[i] + 0.0; // no negative zero
+      key.append(&parameter, sizeof(F64));
+    }
+    identity->projection_fingerprint = crs_cache_hash(key.data, key.size);
+  }
+
+  // the same WKT with or without a terminating zero has the same fingerprint
+
+  identity->wkt_fingerprint = 0;
+  if (lasheader->ogc_wkt && (lasheader->ogc_wkt != lasheader->file_signature))
+  {
+    U32 length = get_wkt_length(lasheader);
+    while (length && ((lasheader->ogc_wkt[length-1] == '\0') || (lasheader->ogc_wkt[length-1] == ' ') || (lasheader->ogc_wkt[length-1] == '\n') || (lasheader->ogc_wkt[length-1] == '\r')))
+    {
+      length--;
+    }
+    if (length)
+    {
+      identity->wkt_fingerprint = crs_cache_hash((const U8*)lasheader->ogc_wkt, length);
     }
   }
-  return has_projection;
 }
 
-void CRScheck::check(LASheader* lasheader, CHAR* description, BOOL no_CRS_fail)
+void CRScheck::check_wkt(LASheader* lasheader, CHAR* description, BOOL no_CRS_fail)
+{
+  CHAR note[512];
+  CRSwkt wkt;
+
+  if (!wkt.parse(lasheader->ogc_wkt, get_wkt_length(lasheader)))
+  {
+    sprintf(note, "OGC WKT is not well formed at character %u: %s", wkt.error_position, wkt.error);
+    if (no_CRS_fail)
+    {
+      lasheader->add_warning("CRS", note);
+    }
+    else
+    {
+      lasheader->add_fail("CRS", note);
+    }
+    return;
+  }
+
+  if (!wkt.is_projected && !wkt.is_geographic && !wkt.is_geocentric)
+  {
+    sprintf(note, "OGC WKT does not specify a horizontal Coordinate Reference System");
+    if (no_CRS_fail)
+    {
+      lasheader->add_warning("CRS", note);
+    }
+    else
+    {
+      lasheader->add_fail("CRS", note);
+    }
+    return;
+  }
+
+  // resolve what the WKT specifies
+
+  switch (units_from_factor(wkt.linear_unit))
+  {
+  case 1:
+    set_coordinates_in_meter(FALSE);
+    break;
+  case 2:
+    set_coordinates_in_feet(FALSE);
+    break;
+  case 3:
+    set_coordinates_in_survey_feet(FALSE);
+    break;
+  }
+  switch (units_from_factor(wkt.vertical_unit))
+  {
+  case 1:
+    set_elevation_in_meter(FALSE);
+    break;
+  case 2:
+    set_elevation_in_feet(FALSE);
+    break;
+  case 3:
+    set_elevation_in_survey_feet(FALSE);
+    break;
+  }
+  horizontal_epsg[1] = wkt.horizontal_epsg;
+  vertical_epsg[1] = wkt.vertical_epsg;
+
+  if (wkt.semi_major_axis > 0.0)
+  {
+    set_ellipsoid(find_ellipsoid(wkt.semi_major_axis, wkt.inverse_flattening), FALSE);
+  }
+
+  if (wkt.is_projected)
+  {
+    if ((wkt.method == CRSWKT_METHOD_TM) && ((wkt.parameters & (CRSWKT_FALSE_EASTING|CRSWKT_FALSE_NORTHING|CRSWKT_CENTRAL_MERIDIAN)) == (CRSWKT_FALSE_EASTING|CRSWKT_FALSE_NORTHING|CRSWKT_CENTRAL_MERIDIAN)))
+    {
+      set_transverse_mercator_projection(wkt.false_easting, wkt.false_northing, wkt.latitude_of_origin, wkt.central_meridian, wkt.scale_factor, FALSE);
+    }
+    else if ((wkt.method == CRSWKT_METHOD_LCC) && ((wkt.parameters & (CRSWKT_FALSE_EASTING|CRSWKT_FALSE_NORTHING|CRSWKT_CENTRAL_MERIDIAN|CRSWKT_STANDARD_PARALLEL1|CRSWKT_STANDARD_PARALLEL2)) == (CRSWKT_FALSE_EASTING|CRSWKT_FALSE_NORTHING|CRSWKT_CENTRAL_MERIDIAN|CRSWKT_STANDARD_PARALLEL1|CRSWKT_STANDARD_PARALLEL2)))
+    {
+      set_lambert_conformal_conic_projection(wkt.false_easting, wkt.false_northing, wkt.latitude_of_origin, wkt.central_meridian, wkt.standard_parallel1, wkt.standard_parallel2, FALSE);
+    }
+  }
+  else if (wkt.is_geographic)
+  {
+    set_longlat_projection(FALSE);
+  }
+  else
+  {
+    set_ecef_projection(FALSE);
+  }
+
+  // the WKT names the CRS when the geokeys did not
+
+  if (description && (description[0] == '\0') && wkt.name[0])
+  {
+    sprintf(description, "%s", wkt.name);
+  }
+
+  // and if there are also geokeys they must specify the same CRS
+
+  if (lasheader->geokeys == 0)
+  {
+    return;
+  }
+
+  U32 geokey_epsg = 0;
+  for (U32 i = 0; i < lasheader->geokeys->number_of_keys; i++)
+  {
+    U16 key_id = lasheader->geokey_entries[i].key_id;
+    U16 value = lasheader->geokey_entries[i].value_offset;
+    if ((key_id == 3072) && (value != 32767))
+    {
+      geokey_epsg = value;
+    }
+    else if ((key_id == 2048) && (value != 32767) && (geokey_epsg == 0) && !wkt.is_projected)
+    {
+      geokey_epsg = value;
+    }
+  }
+
+  note[0] = '\0';
+  if (geokey_epsg && wkt.horizontal_epsg && (geokey_epsg != wkt.horizontal_epsg))
+  {
+    sprintf(note, "inconsistency. geokeys specify EPSG code %u but OGC WKT specifies EPSG code %u", geokey_epsg, wkt.horizontal_epsg);
+  }
+  else if (projections[0] && projections[1])
+  {
+    CRSprojectionParametersTM tm[2];
+    if (!same_projection(as_transverse_mercator(projections[0], &tm[0]), as_transverse_mercator(projections[1], &tm[1])))
+    {
+      sprintf(note, "inconsistency. geokeys specify %.200s but OGC WKT specifies %.200s with different parameters", projections[0]->name, projections[1]->name);
+    }
+  }
+  if ((note[0] == '\0') && coordinate_units[0] && coordinate_units[1] && (coordinate_units[0] != coordinate_units[1]))
+  {
+    sprintf(note, "inconsistency. geokeys specify coordinates in %s but OGC WKT specifies them in %s", units_name(coordinate_units[0]), units_name(coordinate_units[1]));
+  }
+  if ((note[0] == '\0') && vertical_epsg[0] && vertical_epsg[1] && (vertical_epsg[0] != vertical_epsg[1]))
+  {
+    sprintf(note, "inconsistency. geokeys specify vertical EPSG code %u but OGC WKT specifies vertical EPSG code %u", vertical_epsg[0], vertical_epsg[1]);
+  }
+  if (note[0])
+  {
+    if (no_CRS_fail)
+    {
+      lasheader->add_warning("CRS", note);
+    }
+    else
+    {
+      lasheader->add_fail("CRS", note);
+    }
+  }
+}
+
+void CRScheck::check_uncached(LASheader* lasheader, CHAR* description, BOOL no_CRS_fail)
 {
   CHAR note[512];
 
@@ -14547,8 +15096,7 @@ void CRScheck::check(LASheader* lasheader, CHAR* description, BOOL no_CRS_fail)
       }
       else
       {
-        sprintf(note, "there is a OGC WKT string but its check is not yet implemented");
-        lasheader->add_warning("CRS", note);
+        check_wkt(lasheader, description, no_CRS_fail);
       }
     }
   }
@@ -14566,19 +15114,21 @@ void CRScheck::check(LASheader* lasheader, CHAR* description, BOOL no_CRS_fail)
   }
 }
 
-CRScheck::CRScheck()
+void CRScheck::reset()
 {
+  horizontal_epsg[0] = horizontal_epsg[1] = 0;
   coordinate_units[0] = coordinate_units[1] = 0;
   elevation_units[0] = elevation_units[1] = 0;
   vertical_epsg[0] = vertical_epsg[1] = 0;
   ellipsoids[0] = ellipsoids[1] = 0;
   projections[0] = projections[1] = 0;
+}
+
+CRScheck::CRScheck()
+{
+  reset();
 };
 
 CRScheck::~CRScheck()
 {
-  if (ellipsoids[0]) delete ellipsoids[0];
-  if (ellipsoids[1]) delete ellipsoids[1];
-  if (projections[0]) delete projections[0];
-  if (projections[1]) delete projections[1];
 };
@@ -25,6 +25,16 @@
 
   CHANGE HISTORY:
 
+    19 October 2026 -- areas of use of national and state grids from the EPSG registry
+    19 October 2026 -- identity of the resolved CRS for grouping the files of a batch
+    19 October 2026 -- ellipsoids and projections in inline storage and reset() for reuse
+    19 October 2026 -- projected CRS from a memory-mapped CRS database before the built-in tables
+    19 October 2026 -- OGC WKT is parsed and compared with the geokeys
+    19 October 2026 -- inverse projections to check the bounding box against the area of use
+    19 October 2026 -- verdicts are cached by the CRS VLRs they were found for
+    19 October 2026 -- state plane zones from a perfect hash by zone name and geokey
+    19 October 2026 -- binary search for the names of EPSG codes
+    19 October 2026 -- EPSG codes of UTM, MGA, and state plane zones from a sorted table
     8 July 2015 -- look-up name of unknown ESPG codes in list by Loren Dawe
     3 July 2014 -- allowing unknown ESPG codes to pass CRS check with warning
     8 September 2013 -- it started raining on the beach after TREEMAPS meeting
@@ -103,19 +113,90 @@ public:
   F64 tm_ep;
 };
 
+// what files must share to be in the same CRS. the codes and units are 0 when
+// not specified and the fingerprints are 0 without a projection or OGC WKT.
+
+class CRSidentity
+{
+public:
+  U32 horizontal_epsg;
+  U32 coordinate_units;
+  U32 elevation_units;
+  U32 vertical_epsg;
+  U64 projection_fingerprint;
+  U64 wkt_fingerprint;
+};
+
+// inline storage that is large enough for any of the projection parameters
+
+#define CRS_STORAGE_MAX(a, b) ((a) > (b) ? (a) : (b))
+#define CRS_PROJECTION_STORAGE_SIZE CRS_STORAGE_MAX(sizeof(CRSprojectionParametersUTM), CRS_STORAGE_MAX(sizeof(CRSprojectionParametersLCC), sizeof(CRSprojectionParametersTM)))
+
+union CRSprojectionStorage
+{
+  F64 alignment;
+  U8 bytes[CRS_PROJECTION_STORAGE_SIZE];
+};
+
 class CRScheck
 {
 public:
+  // identical CRS VLRs get the verdict that was cached when they were first checked
+
   void check(LASheader* lasheader, CHAR* description=0, BOOL no_CRS_fail=FALSE);
+
+  // resolves the geokeys only, without adding warnings or fails to the header
+
+  BOOL check_geokeys(LASheader* lasheader, CHAR* description);
+
+  // resolves one ProjectedCSTypeGeoKey on its own (crsbench compares this for every value)
+
+  BOOL set_projection_from_ProjectedCSTypeGeoKey(const U16 value, CHAR* description=0);
+
+  const CRSprojectionEllipsoid* get_ellipsoid(const BOOL from_geokeys=TRUE) const { return ellipsoids[from_geokeys ? 0 : 1]; };
+  const CRSprojectionParameters* get_projection(const BOOL from_geokeys=TRUE) const { return projections[from_geokeys ? 0 : 1]; };
+
+  // inverse projects coordinates in the coordinate units to longitude and latitude in degrees
+
+  BOOL inverse_project(const F64* x, const F64* y, F64* longitude, F64* latitude, const U32 number, const BOOL from_geokeys=TRUE);
+
+  // the corners of the bounding box and a sample of the points given as integers must be in the area of use
+
+  void check_area_of_use(LASheader* lasheader, const I32* X=0, const I32* Y=0, const U32 number=0);
+
+  // the resolved CRS with the geokeys taking precedence over the OGC WKT
+
+  void get_identity(const LASheader* lasheader, CRSidentity* identity) const;
+
+  // the name of a projected EPSG code or NULL if the code is not known
+
+  static const CHAR* get_epsg_description(const U16 code);
+
+  // writes a CRS database with everything the built-in tables resolve (see crsdatabase.hpp)
+
+  static BOOL write_database(const CHAR* file_name);
+
+  // forgets everything that was resolved so that the object can check another file
+
+  void reset();
+
   CRScheck();
   ~CRScheck();
 
 private:
+  U32 horizontal_epsg[2];
   U32 coordinate_units[2];
   U32 elevation_units[2];
   U32 vertical_epsg[2];
   CRSprojectionEllipsoid* ellipsoids[2];
   CRSprojectionParameters* projections[2];
+  CRSprojectionEllipsoid ellipsoid_storage[2];
+  CRSprojectionStorage projection_storage[2];
+
+  F64 get_coordinates2meter(const BOOL from_geokeys) const;
+  void check_wkt(LASheader* lasheader, CHAR* description, BOOL no_CRS_fail);
+  void check_uncached(LASheader* lasheader, CHAR* description, BOOL no_CRS_fail);
+  void copy(const CRScheck* other);
 
   void set_coordinates_in_survey_feet(const BOOL from_geokeys);
   void set_coordinates_in_feet(const BOOL from_geokeys);
@@ -124,7 +205,7 @@ private:
   void set_elevation_in_feet(const BOOL from_geokeys);
   void set_elevation_in_meter(const BOOL from_geokeys);
   BOOL set_ellipsoid(const I32 ellipsoid_id, const BOOL from_geokeys, char* description=0);
-  void set_projection(CRSprojectionParameters* projection, const BOOL from_geokeys);
+  CRSprojectionParameters* init_projection(const I32 type, const BOOL from_geokeys);
   BOOL set_no_projection(const BOOL from_geokeys, CHAR* description=0);
   BOOL set_latlong_projection(const BOOL from_geokeys, CHAR* description=0);
   BOOL set_longlat_projection(const BOOL from_geokeys, CHAR* description=0);
@@ -141,9 +222,8 @@ private:
   BOOL set_coordinates_from_ProjLinearUnitsGeoKey(U16 value);
   BOOL set_elevation_from_VerticalUnitsGeoKey(U16 value);
   BOOL set_vertical_from_VerticalCSTypeGeoKey(U16 value);
-  BOOL set_projection_from_ProjectedCSTypeGeoKey(const U16 value, CHAR* description=0);
-
-  BOOL check_geokeys(LASheader* lasheader, CHAR* description);
+  BOOL set_projection_from_database(const U16 value, CHAR* description);
+  BOOL set_projection_from_EPSG_tables(const U16 value, CHAR* description);
 };
 
 #endif
@@ -0,0 +1,295 @@
+/*
+===============================================================================
+
+  FILE:  crsdatabase.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "crsdatabase.hpp"
+
+// the file is mapped once by whichever worker looks up the first code. after
+// that the mapping is only read and stays until the process exits.
+
+static CHAR* crs_database_file_name = 0;
+static BOOL crs_database_tried = FALSE;
+static const U8* crs_database_data = 0;
+static const CRSdatabaseHeader* crs_database_header = 0;
+static const CRSdatabaseProjection* crs_database_projections = 0;
+static const CRSdatabaseName* crs_database_names = 0;
+static const CHAR* crs_database_strings = 0;
+
+#ifdef _WIN32
+static SRWLOCK crs_database_lock = SRWLOCK_INIT;
+static void crs_database_acquire() { AcquireSRWLockExclusive(&crs_database_lock); }
+static void crs_database_release() { ReleaseSRWLockExclusive(&crs_database_lock); }
+#else
+static pthread_mutex_t crs_database_lock = PTHREAD_MUTEX_INITIALIZER;
+static void crs_database_acquire() { pthread_mutex_lock(&crs_database_lock); }
+static void crs_database_release() { pthread_mutex_unlock(&crs_database_lock); }
+#endif
+
+// returns the mapped bytes of the file or NULL
+
+static const U8* crs_database_map_file(const CHAR* file_name, U64* size)
+{
+#ifdef _WIN32
+  HANDLE file = CreateFileA(file_name, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    return 0;
+  }
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file, &file_size) || (file_size.QuadPart == 0))
+  {
+    CloseHandle(file);
+    return 0;
+  }
+  HANDLE mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+  CloseHandle(file);
+  if (mapping == 0)
+  {
+    return 0;
+  }
+  const U8* data = (const U8*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  *size = (U64)file_size.QuadPart;
+  return data;
+#else
+  int file = open(file_name, O_RDONLY);
+  if (file == -1)
+  {
+    return 0;
+  }
+  struct stat file_stat;
+  if ((fstat(file, &file_stat) != 0) || (file_stat.st_size == 0))
+  {
+    close(file);
+    return 0;
+  }
+  void* data = mmap(0, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+  close(file);
+  if (data == MAP_FAILED)
+  {
+    return 0;
+  }
+  *size = (U64)file_stat.st_size;
+  return (const U8*)data;
+#endif
+}
+
+static void crs_database_unmap_file(const U8* data, const U64 size)
+{
+#ifdef _WIN32
+  UnmapViewOfFile(data);
+#else
+  munmap((void*)data, (size_t)size);
+#endif
+}
+
+void CRSdatabase::set_file_name(const CHAR* file_name)
+{
+  crs_database_acquire();
+  if (crs_database_file_name) free(crs_database_file_name);
+  crs_database_file_name = (file_name ? strdup(file_name) : 0);
+  crs_database_tried = FALSE;
+  crs_database_release();
+}
+
+BOOL CRSdatabase::map()
+{
+  crs_database_acquire();
+  if (!crs_database_tried)
+  {
+    crs_database_tried = TRUE;
+    if (crs_database_file_name)
+    {
+      U64 size = 0;
+      const U8* data = crs_database_map_file(crs_database_file_name, &size);
+      if (data == 0)
+      {
+        fprintf(stderr, "WARNING: cannot map CRS database '%s'. using built-in tables.\n", crs_database_file_name);
+      }
+      else
+      {
+        // only the header is checked here so that the tables are not touched before they are needed
+
+        const CRSdatabaseHeader* header = (const CRSdatabaseHeader*)data;
+        const CHAR* reason = 0;
+        if (size < sizeof(CRSdatabaseHeader))
+        {
+          reason = "too short for its header";
+        }
+        else if (strncmp(header->signature, CRSDATABASE_SIGNATURE, 8) != 0)
+        {
+          reason = "wrong signature";
+        }
+        else if (header->version != CRSDATABASE_VERSION)
+        {
+          reason = "unsupported version or byte order";
+        }
+        else if ((header->offset_to_projections % 8) || (((U64)header->offset_to_projections + (U64)header->number_of_projections*sizeof(CRSdatabaseProjection)) > size))
+        {
+          reason = "projection records out of bounds";
+        }
+        else if ((header->offset_to_names % 4) || (((U64)header->offset_to_names + (U64)header->number_of_names*sizeof(CRSdatabaseName)) > size))
+        {
+          reason = "names out of bounds";
+        }
+        else if ((header->size_of_strings == 0) || (((U64)header->offset_to_strings + header->size_of_strings) > size) || (data[header->offset_to_strings + header->size_of_strings - 1] != '\0'))
+        {
+          reason = "string pool out of bounds or not terminated";
+        }
+        if (reason)
+        {
+          fprintf(stderr, "WARNING: CRS database '%s' is corrupt (%s). using built-in tables.\n", crs_database_file_name, reason);
+          crs_database_unmap_file(data, size);
+        }
+        else
+        {
+          crs_database_header = header;
+          crs_database_projections = (const CRSdatabaseProjection*)(data + header->offset_to_projections);
+          crs_database_names = (const CRSdatabaseName*)(data + header->offset_to_names);
+          crs_database_strings = (const CHAR*)(data + header->offset_to_strings);
+          crs_database_data = data;
+        }
+      }
+    }
+  }
+  crs_database_release();
+  return (crs_database_data != 0);
+}
+
+const CRSdatabaseProjection* CRSdatabase::find_projection(const U16 code)
+{
+  if (!map())
+  {
+    return 0;
+  }
+  I32 lo = 0;
+  I32 hi = (I32)crs_database_header->number_of_projections - 1;
+  while (lo <= hi)
+  {
+    I32 mid = (lo + hi) / 2;
+    if (code < crs_database_projections[mid].code)
+    {
+      hi = mid - 1;
+    }
+    else if (code > crs_database_projections[mid].code)
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      return &(crs_database_projections[mid]);
+    }
+  }
+  return 0;
+}
+
+const CHAR* CRSdatabase::find_name(const U16 code)
+{
+  if (!map())
+  {
+    return 0;
+  }
+  I32 lo = 0;
+  I32 hi = (I32)crs_database_header->number_of_names - 1;
+  while (lo <= hi)
+  {
+    I32 mid = (lo + hi) / 2;
+    if (code < crs_database_names[mid].code)
+    {
+      hi = mid - 1;
+    }
+    else if (code > crs_database_names[mid].code)
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      return get_string(crs_database_names[mid].name);
+    }
+  }
+  return 0;
+}
+
+// the pool ends with a zero so any offset inside of it gives a terminated string
+
+const CHAR* CRSdatabase::get_string(const U32 offset)
+{
+  if ((crs_database_data == 0) || (offset >= crs_database_header->size_of_strings))
+  {
+    return 0;
+  }
+  return crs_database_strings + offset;
+}
+
+BOOL CRSdatabase::write(const CHAR* file_name, const CRSdatabaseProjection* projections, const U32 number_of_projections, const CRSdatabaseName* names, const U32 number_of_names, const CHAR* strings, const U32 size_of_strings)
+{
+  FILE* file = fopen(file_name, "wb");
+  if (file == 0)
+  {
+    fprintf(stderr, "ERROR: cannot open CRS database '%s' for writing\n", file_name);
+    return FALSE;
+  }
+  CRSdatabaseHeader header;
+  memset(&header, 0, sizeof(CRSdatabaseHeader));
+  strncpy(header.signature, CRSDATABASE_SIGNATURE, 8);
+  header.version = CRSDATABASE_VERSION;
+  header.number_of_projections = number_of_projections;
+  header.offset_to_projections = sizeof(CRSdatabaseHeader);
+  header.number_of_names = number_of_names;
+  header.offset_to_names = header.offset_to_projections + number_of_projections*sizeof(CRSdatabaseProjection);
+  header.offset_to_strings = header.offset_to_names + number_of_names*sizeof(CRSdatabaseName);
+  header.size_of_strings = size_of_strings;
+  BOOL success = TRUE;
+  if (fwrite(&header, sizeof(CRSdatabaseHeader), 1, file) != 1) success = FALSE;
+  if (number_of_projections && (fwrite(projections, sizeof(CRSdatabaseProjection), number_of_projections, file) != number_of_projections)) success = FALSE;
+  if (number_of_names && (fwrite(names, sizeof(CRSdatabaseName), number_of_names, file) != number_of_names)) success = FALSE;
+  if (fwrite(strings, 1, size_of_strings, file) != size_of_strings) success = FALSE;
+  if (fclose(file) != 0) success = FALSE;
+  if (!success)
+  {
+    fprintf(stderr, "ERROR: cannot write CRS database '%s'\n", file_name);
+  }
+  return success;
+}
@@ -0,0 +1,110 @@
+/*
+===============================================================================
+
+  FILE:  crsdatabase.hpp
+
+  CONTENTS:
+
+    A compact binary file with the projected CRS that the CRS check knows by
+    their EPSG code. It starts with a header that is followed by a table of
+    projection records and a table of names, both sorted by EPSG code, and a
+    pool of zero-terminated strings that the records refer to by offset. The
+    file is memory-mapped when the first code is looked up and each look-up
+    is a binary search on the mapped tables, so a run that sees only a few
+    codes touches only a few pages. All numbers are little-endian. When no
+    file was given or it cannot be mapped, the look-ups simply find nothing
+    and the CRS check uses its built-in tables.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    19 October 2026 -- created for updating EPSG codes without a new release
+
+===============================================================================
+*/
+#ifndef CRS_DATABASE_HPP
+#define CRS_DATABASE_HPP
+
+#include "mydefs.hpp"
+
+#define CRSDATABASE_SIGNATURE "LASVCRS"
+#define CRSDATABASE_VERSION 1
+
+#define CRSDATABASE_NO_STRING     0xFFFFFFFF
+#define CRSDATABASE_NO_PROJECTION 0xFF
+
+class CRSdatabaseHeader
+{
+public:
+  CHAR signature[8];
+  U32 version;
+  U32 number_of_projections;
+  U32 offset_to_projections;
+  U32 number_of_names;
+  U32 offset_to_names;
+  U32 offset_to_strings;
+  U32 size_of_strings;
+  U32 reserved;
+};
+
+// what a ProjectedCSTypeGeoKey resolves to. the ellipsoid and the units are 0
+// when the code does not set them. the parameters are zone, hemisphere, and
+// zone letter for UTM, false easting and northing, latitude of origin, central
+// meridian, and scale factor for TM, and false easting and northing, latitude
+// of origin, central meridian, and both standard parallels for LCC.
+
+class CRSdatabaseProjection
+{
+public:
+  U16 code;
+  U8 type;
+  U8 coordinate_units;
+  I16 ellipsoid;
+  U16 reserved;
+  U32 name;
+  U32 description;
+  F64 parameters[6];
+};
+
+class CRSdatabaseName
+{
+public:
+  U16 code;
+  U16 reserved;
+  U32 name;
+};
+
+class CRSdatabase
+{
+public:
+  // the file is only mapped at the first look-up
+
+  static void set_file_name(const CHAR* file_name);
+
+  // binary searches on the mapped tables that return NULL for unknown codes
+
+  static const CRSdatabaseProjection* find_projection(const U16 code);
+  static const CHAR* find_name(const U16 code);
+  static const CHAR* get_string(const U32 offset);
+
+  static BOOL write(const CHAR* file_name, const CRSdatabaseProjection* projections, const U32 number_of_projections, const CRSdatabaseName* names, const U32 number_of_names, const CHAR* strings, const U32 size_of_strings);
+
+private:
+  static BOOL map();
+};
+
+#endif
@@ -0,0 +1,263 @@
+/*
+===============================================================================
+
+  FILE:  crsgroupcheck.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "crsgroupcheck.hpp"
+
+static U64 hash_value(U64 h, const U64 value)
+{
+  h ^= value;
+  h *= 1099511628211ull;
+  h ^= h >> 29;
+  return h;
+}
+
+static U64 hash_identity(const CRSidentity* identity)
+{
+  U64 h = 14695981039346656037ull;
+  h = hash_value(h, identity->horizontal_epsg);
+  h = hash_value(h, identity->coordinate_units);
+  h = hash_value(h, identity->elevation_units);
+  h = hash_value(h, identity->vertical_epsg);
+  h = hash_value(h, identity->projection_fingerprint);
+  h = hash_value(h, identity->wkt_fingerprint);
+  return h;
+}
+
+static BOOL same_identity(const CRSidentity* a, const CRSidentity* b)
+{
+  return ((a->horizontal_epsg == b->horizontal_epsg) && (a->coordinate_units == b->coordinate_units) && (a->elevation_units == b->elevation_units) && (a->vertical_epsg == b->vertical_epsg) && (a->projection_fingerprint == b->projection_fingerprint) && (a->wkt_fingerprint == b->wkt_fingerprint));
+}
+
+static int compare_groups(const void* a, const void* b)
+{
+  const CRSgroup* group_a = *((const CRSgroup**)a);
+  const CRSgroup* group_b = *((const CRSgroup**)b);
+  if (group_a->count != group_b->count) return (group_a->count > group_b->count ? -1 : 1);
+  if (group_a->first != group_b->first) return (group_a->first < group_b->first ? -1 : 1);
+  return 0;
+}
+
+static const CHAR* units_name(const U32 units)
+{
+  switch (units)
+  {
+  case 1:
+    return "meter";
+  case 2:
+    return "feet";
+  case 3:
+    return "survey feet";
+  }
+  return "unknown units";
+}
+
+static void describe_identity(CHAR* string, const CRSidentity* identity)
+{
+  if (identity->horizontal_epsg)
+  {
+    string += sprintf(string, "EPSG %u", identity->horizontal_epsg);
+  }
+  else if (identity->projection_fingerprint || identity->wkt_fingerprint)
+  {
+    string += sprintf(string, "a CRS without EPSG code");
+  }
+  else
+  {
+    sprintf(string, "no CRS");
+    return;
+  }
+  if (identity->coordinate_units)
+  {
+    string += sprintf(string, " in %s", units_name(identity->coordinate_units));
+  }
+  if (identity->projection_fingerprint && (identity->horizontal_epsg == 0))
+  {
+    string += sprintf(string, " with projection %08x%08x", (U32)(identity->projection_fingerprint >> 32), (U32)(identity->projection_fingerprint));
+  }
+  if (identity->vertical_epsg)
+  {
+    string += sprintf(string, " and vertical EPSG %u", identity->vertical_epsg);
+  }
+  else
+  {
+    string += sprintf(string, " and no vertical EPSG code");
+  }
+  if (identity->elevation_units)
+  {
+    string += sprintf(string, " in %s", units_name(identity->elevation_units));
+  }
+  if (identity->wkt_fingerprint)
+  {
+    sprintf(string, " and OGC WKT %08x%08x", (U32)(identity->wkt_fingerprint >> 32), (U32)(identity->wkt_fingerprint));
+  }
+}
+
+CRSgroup* CRSGROUPcheck::find_group(const U64 hash, const CRSidentity* identity)
+{
+  U32 mask = groups_capacity - 1;
+  U32 slot = ((U32)hash ^ (U32)(hash >> 32)) & mask;
+  while (groups[slot].count && ((groups[slot].hash != hash) || !same_identity(&(groups[slot].identity), identity)))
+  {
+    slot = (slot + 1) & mask;
+  }
+  return &(groups[slot]);
+}
+
+void CRSGROUPcheck::grow_groups()
+{
+  CRSgroup* old_groups = groups;
+  U32 old_capacity = groups_capacity;
+  groups_capacity = (groups_capacity ? 2*groups_capacity : 64);
+  groups = (CRSgroup*)calloc(groups_capacity, sizeof(CRSgroup));
+  for (U32 i = 0; i < old_capacity; i++)
+  {
+    if (old_groups[i].count)
+    {
+      *find_group(old_groups[i].hash, &(old_groups[i].identity)) = old_groups[i];
+    }
+  }
+  if (old_groups) free(old_groups);
+}
+
+void CRSGROUPcheck::add(const CHAR* file_name, const CRSidentity* identity, const CHAR* description)
+{
+  U64 hash = hash_identity(identity);
+  if (2*(number_of_groups + 1) > groups_capacity)
+  {
+    grow_groups();
+  }
+  CRSgroup* group = find_group(hash, identity);
+  if (group->count == 0)
+  {
+    group->hash = hash;
+    group->identity = *identity;
+    group->first = number_of_files;
+    group->file_name = strdup(file_name);
+    group->description = strdup(description ? description : "");
+    number_of_groups++;
+  }
+  group->count++;
+  number_of_files++;
+}
+
+void CRSGROUPcheck::check()
+{
+  if (sorted) free(sorted);
+  sorted = (CRSgroup**)malloc(sizeof(CRSgroup*)*(number_of_groups ? number_of_groups : 1));
+  U32 i, j;
+  for (i = 0, j = 0; i < groups_capacity; i++)
+  {
+    if (groups[i].count) sorted[j++] = &(groups[i]);
+  }
+  qsort(sorted, number_of_groups, sizeof(CRSgroup*), compare_groups);
+}
+
+BOOL CRSGROUPcheck::has_warnings() const
+{
+  return (number_of_groups > 1);
+}
+
+void CRSGROUPcheck::write(XMLwriter* xmlwriter) const
+{
+  U32 i;
+  CHAR identity[512];
+  CHAR largest[512];
+  CHAR note[2048];
+
+  xmlwriter->write("files", (I32)number_of_files);
+  xmlwriter->write("groups", (I32)number_of_groups);
+
+  if (sorted == 0)
+  {
+    return;
+  }
+
+  for (i = 0; (i < number_of_groups) && (i < CRSGROUPCHECK_SAMPLES); i++)
+  {
+    describe_identity(identity, &(sorted[i]->identity));
+    sprintf(note, "%u file%s with %s ('%.200s') such as '%.400s'", sorted[i]->count, (sorted[i]->count > 1 ? "s" : ""), identity, sorted[i]->description, sorted[i]->file_name);
+    xmlwriter->write("group", note);
+  }
+
+  // every group but the largest is reported
+
+  if (number_of_groups > 1)
+  {
+    describe_identity(largest, &(sorted[0]->identity));
+    U32 other_files = 0;
+    for (i = 1; i < number_of_groups; i++)
+    {
+      if (i < CRSGROUPCHECK_SAMPLES)
+      {
+        describe_identity(identity, &(sorted[i]->identity));
+        sprintf(note, "%u of %u files such as '%.400s' %s %s but the %u file%s of the largest group %s %s", sorted[i]->count, number_of_files, sorted[i]->file_name, (sorted[i]->count > 1 ? "have" : "has"), identity, sorted[0]->count, (sorted[0]->count > 1 ? "s" : ""), (sorted[0]->count > 1 ? "have" : "has"), largest);
+        xmlwriter->write("CRS", "warning", note);
+      }
+      else
+      {
+        other_files += sorted[i]->count;
+      }
+    }
+    if (number_of_groups > CRSGROUPCHECK_SAMPLES)
+    {
+      sprintf(note, "%u more groups with %u files also differ from the CRS of the largest group", number_of_groups - CRSGROUPCHECK_SAMPLES, other_files);
+      xmlwriter->write("CRS", "warning", note);
+    }
+  }
+}
+
+CRSGROUPcheck::CRSGROUPcheck()
+{
+  number_of_files = 0;
+  groups = 0;
+  groups_capacity = 0;
+  number_of_groups = 0;
+  grow_groups();
+  sorted = 0;
+}
+
+CRSGROUPcheck::~CRSGROUPcheck()
+{
+  for (U32 i = 0; i < groups_capacity; i++)
+  {
+    if (groups[i].count)
+    {
+      free(groups[i].file_name);
+      free(groups[i].description);
+    }
+  }
+  free(groups);
+  if (sorted) free(sorted);
+}
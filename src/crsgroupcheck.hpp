@@ -0,0 +1,86 @@
+/*
+===============================================================================
+
+  FILE:  crsgroupcheck.hpp
+
+  CONTENTS:
+
+    Checks that all files of a batch are in the same CRS. Each file is put
+    into a group by the identity of the CRS that was resolved for it: the
+    horizontal and the vertical EPSG code, the units, a fingerprint of the
+    projection parameters, and a fingerprint of the OGC WKT. The groups are
+    kept in a hash map that is keyed by a hash of the identity, so time is
+    linear in the number of files and memory grows only with the number of
+    groups. The largest group is taken to be the CRS of the delivery and all
+    other groups are reported as warnings.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    19 October 2026 -- created for finding tiles in the wrong CRS in a delivery
+
+===============================================================================
+*/
+#ifndef CRS_GROUP_CHECK_HPP
+#define CRS_GROUP_CHECK_HPP
+
+#include "crscheck.hpp"
+
+#include "xmlwriter.hpp"
+
+#define CRSGROUPCHECK_SAMPLES 10
+
+class CRSgroup
+{
+public:
+  U64 hash;
+  CRSidentity identity;
+  U32 count;
+  U32 first;
+  CHAR* file_name;
+  CHAR* description;
+};
+
+class CRSGROUPcheck
+{
+public:
+
+  void add(const CHAR* file_name, const CRSidentity* identity, const CHAR* description);
+  void check();
+  BOOL has_warnings() const;
+  void write(XMLwriter* xmlwriter) const;
+
+  CRSGROUPcheck();
+  ~CRSGROUPcheck();
+
+private:
+  U32 number_of_files;
+
+  // hash map of the groups that is at most half full
+
+  CRSgroup* groups;
+  U32 groups_capacity;
+  U32 number_of_groups;
+  CRSgroup* find_group(const U64 hash, const CRSidentity* identity);
+  void grow_groups();
+
+  // the results with the largest group first
+
+  CRSgroup** sorted;
+};
+
+#endif
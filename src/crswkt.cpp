@@ -0,0 +1,642 @@
+/*
+===============================================================================
+
+  FILE:  crswkt.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "crswkt.hpp"
+
+#define CRSWKT_TOKEN_END    0
+#define CRSWKT_TOKEN_OPEN   1
+#define CRSWKT_TOKEN_CLOSE  2
+#define CRSWKT_TOKEN_COMMA  3
+#define CRSWKT_TOKEN_STRING 4
+#define CRSWKT_TOKEN_NUMBER 5
+#define CRSWKT_TOKEN_WORD   6
+#define CRSWKT_TOKEN_ERROR  7
+
+#define CRSWKT_KEYWORD_OTHER      0
+#define CRSWKT_KEYWORD_PROJECTED  1
+#define CRSWKT_KEYWORD_GEOGRAPHIC 2
+#define CRSWKT_KEYWORD_BASE       3
+#define CRSWKT_KEYWORD_GEOCENTRIC 4
+#define CRSWKT_KEYWORD_VERTICAL   5
+#define CRSWKT_KEYWORD_AUTHORITY  6
+#define CRSWKT_KEYWORD_UNIT       7
+#define CRSWKT_KEYWORD_ANGLEUNIT  8
+#define CRSWKT_KEYWORD_SCALEUNIT  9
+#define CRSWKT_KEYWORD_DATUM      10
+#define CRSWKT_KEYWORD_ELLIPSOID  11
+#define CRSWKT_KEYWORD_METHOD     12
+#define CRSWKT_KEYWORD_PARAMETER  13
+#define CRSWKT_KEYWORD_AXIS       14
+#define CRSWKT_KEYWORD_IGNORED    15
+
+static const F64 rad2deg = 180.0 / 3.141592653589793238462643383279502884197169;
+
+class CRSwktKeyword
+{
+public:
+  const CHAR* name;
+  U32 keyword;
+};
+
+// the WKT1 and the WKT2 spellings of the keywords that matter for the check. the
+// transformations of a BOUNDCRS are ignored so that their parameters are not
+// mistaken for those of the projection.
+
+static const CRSwktKeyword keyword_list[] =
+{
+  {"PROJCS", CRSWKT_KEYWORD_PROJECTED},
+  {"PROJCRS", CRSWKT_KEYWORD_PROJECTED},
+  {"PROJECTEDCRS", CRSWKT_KEYWORD_PROJECTED},
+  {"GEOGCS", CRSWKT_KEYWORD_GEOGRAPHIC},
+  {"GEOGCRS", CRSWKT_KEYWORD_GEOGRAPHIC},
+  {"GEOGRAPHICCRS", CRSWKT_KEYWORD_GEOGRAPHIC},
+  {"GEODCRS", CRSWKT_KEYWORD_GEOGRAPHIC},
+  {"GEODETICCRS", CRSWKT_KEYWORD_GEOGRAPHIC},
+  {"BASEGEOGCRS", CRSWKT_KEYWORD_BASE},
+  {"BASEGEODCRS", CRSWKT_KEYWORD_BASE},
+  {"GEOCCS", CRSWKT_KEYWORD_GEOCENTRIC},
+  {"VERT_CS", CRSWKT_KEYWORD_VERTICAL},
+  {"VERTCRS", CRSWKT_KEYWORD_VERTICAL},
+  {"VERTICALCRS", CRSWKT_KEYWORD_VERTICAL},
+  {"AUTHORITY", CRSWKT_KEYWORD_AUTHORITY},
+  {"ID", CRSWKT_KEYWORD_AUTHORITY},
+  {"UNIT", CRSWKT_KEYWORD_UNIT},
+  {"LENGTHUNIT", CRSWKT_KEYWORD_UNIT},
+  {"ANGLEUNIT", CRSWKT_KEYWORD_ANGLEUNIT},
+  {"SCALEUNIT", CRSWKT_KEYWORD_SCALEUNIT},
+  {"DATUM", CRSWKT_KEYWORD_DATUM},
+  {"GEODETICDATUM", CRSWKT_KEYWORD_DATUM},
+  {"TRF", CRSWKT_KEYWORD_DATUM},
+  {"SPHEROID", CRSWKT_KEYWORD_ELLIPSOID},
+  {"ELLIPSOID", CRSWKT_KEYWORD_ELLIPSOID},
+  {"PROJECTION", CRSWKT_KEYWORD_METHOD},
+  {"METHOD", CRSWKT_KEYWORD_METHOD},
+  {"PARAMETER", CRSWKT_KEYWORD_PARAMETER},
+  {"AXIS", CRSWKT_KEYWORD_AXIS},
+  {"TARGETCRS", CRSWKT_KEYWORD_IGNORED},
+  {"ABRIDGEDTRANSFORMATION", CRSWKT_KEYWORD_IGNORED},
+  {0, CRSWKT_KEYWORD_OTHER}
+};
+
+class CRSwktParameter
+{
+public:
+  const CHAR* name;
+  U32 parameter;
+};
+
+// parameter names in lower case without spaces, underscores, and punctuation
+
+static const CRSwktParameter parameter_list[] =
+{
+  {"falseeasting", CRSWKT_FALSE_EASTING},
+  {"eastingatfalseorigin", CRSWKT_FALSE_EASTING},
+  {"falsenorthing", CRSWKT_FALSE_NORTHING},
+  {"northingatfalseorigin", CRSWKT_FALSE_NORTHING},
+  {"latitudeoforigin", CRSWKT_LATITUDE_ORIGIN},
+  {"latitudeofnaturalorigin", CRSWKT_LATITUDE_ORIGIN},
+  {"latitudeoffalseorigin", CRSWKT_LATITUDE_ORIGIN},
+  {"latitudeofcenter", CRSWKT_LATITUDE_ORIGIN},
+  {"centralmeridian", CRSWKT_CENTRAL_MERIDIAN},
+  {"longitudeoforigin", CRSWKT_CENTRAL_MERIDIAN},
+  {"longitudeofnaturalorigin", CRSWKT_CENTRAL_MERIDIAN},
+  {"longitudeoffalseorigin", CRSWKT_CENTRAL_MERIDIAN},
+  {"longitudeofcenter", CRSWKT_CENTRAL_MERIDIAN},
+  {"scalefactor", CRSWKT_SCALE_FACTOR},
+  {"scalefactoratnaturalorigin", CRSWKT_SCALE_FACTOR},
+  {"standardparallel1", CRSWKT_STANDARD_PARALLEL1},
+  {"latitudeof1ststandardparallel", CRSWKT_STANDARD_PARALLEL1},
+  {"standardparallel2", CRSWKT_STANDARD_PARALLEL2},
+  {"latitudeof2ndstandardparallel", CRSWKT_STANDARD_PARALLEL2},
+  {0, 0}
+};
+
+static BOOL is_crs(const U32 keyword)
+{
+  return ((keyword >= CRSWKT_KEYWORD_PROJECTED) && (keyword <= CRSWKT_KEYWORD_VERTICAL));
+}
+
+static BOOL is_space(const CHAR c)
+{
+  return ((c == ' ') || (c == '\t') || (c == '\r') || (c == '\n'));
+}
+
+static BOOL is_letter(const CHAR c)
+{
+  return (((c >= 'A') && (c <= 'Z')) || ((c >= 'a') && (c <= 'z')) || (c == '_'));
+}
+
+static BOOL is_digit(const CHAR c)
+{
+  return ((c >= '0') && (c <= '9'));
+}
+
+static CHAR to_upper(const CHAR c)
+{
+  return (((c >= 'a') && (c <= 'z')) ? (c - 'a' + 'A') : c);
+}
+
+// lower case letters and digits only so that "Lambert_Conformal_Conic_2SP" and
+// "Lambert Conic Conformal (2SP)" differ only in the order of their words
+
+static void normalize(CHAR* normalized, const CHAR* name)
+{
+  while (*name)
+  {
+    if (((*name >= 'A') && (*name <= 'Z')))
+    {
+      *normalized++ = *name - 'A' + 'a';
+    }
+    else if (((*name >= 'a') && (*name <= 'z')) || is_digit(*name))
+    {
+      *normalized++ = *name;
+    }
+    name++;
+  }
+  *normalized = '\0';
+}
+
+static U32 classify_method(const CHAR* name)
+{
+  CHAR normalized[CRSWKT_MAX_NAME];
+  normalize(normalized, name);
+  if (strcmp(normalized, "transversemercator") == 0)
+  {
+    return CRSWKT_METHOD_TM;
+  }
+  if ((strcmp(normalized, "lambertconformalconic2sp") == 0) || (strcmp(normalized, "lambertconicconformal2sp") == 0) || (strcmp(normalized, "lambertconformalconic") == 0))
+  {
+    return CRSWKT_METHOD_LCC;
+  }
+  return CRSWKT_METHOD_UNKNOWN;
+}
+
+U32 CRSwkt::next_token()
+{
+  while ((position < length) && is_space(wkt[position]))
+  {
+    position++;
+  }
+  token_start = position;
+  token_length = 0;
+
+  if ((position >= length) || (wkt[position] == '\0'))
+  {
+    token = CRSWKT_TOKEN_END;
+  }
+  else if ((wkt[position] == '[') || (wkt[position] == '('))
+  {
+    position++;
+    token = CRSWKT_TOKEN_OPEN;
+  }
+  else if ((wkt[position] == ']') || (wkt[position] == ')'))
+  {
+    position++;
+    token = CRSWKT_TOKEN_CLOSE;
+  }
+  else if (wkt[position] == ',')
+  {
+    position++;
+    token = CRSWKT_TOKEN_COMMA;
+  }
+  else if (wkt[position] == '"')
+  {
+    // a quote inside a string is written as two quotes
+
+    position++;
+    token_start = position;
+    token = CRSWKT_TOKEN_ERROR;
+    while ((position < length) && (wkt[position] != '\0'))
+    {
+      if (wkt[position] == '"')
+      {
+        if (((position + 1) < length) && (wkt[position + 1] == '"'))
+        {
+          position += 2;
+          continue;
+        }
+        token_length = position - token_start;
+        position++;
+        token = CRSWKT_TOKEN_STRING;
+        break;
+      }
+      position++;
+    }
+  }
+  else if (is_digit(wkt[position]) || (wkt[position] == '-') || (wkt[position] == '+') || (wkt[position] == '.'))
+  {
+    while ((position < length) && (is_digit(wkt[position]) || (wkt[position] == '-') || (wkt[position] == '+') || (wkt[position] == '.') || (wkt[position] == 'e') || (wkt[position] == 'E')))
+    {
+      position++;
+    }
+    token_length = position - token_start;
+    token = CRSWKT_TOKEN_NUMBER;
+  }
+  else if (is_letter(wkt[position]))
+  {
+    while ((position < length) && (is_letter(wkt[position]) || is_digit(wkt[position])))
+    {
+      position++;
+    }
+    token_length = position - token_start;
+    token = CRSWKT_TOKEN_WORD;
+  }
+  else
+  {
+    token = CRSWKT_TOKEN_ERROR;
+  }
+  return token;
+}
+
+void CRSwkt::copy_token(CHAR* string, const U32 size) const
+{
+  U32 i, j;
+  for (i = 0, j = 0; (i < token_length) && (j < (size - 1)); i++, j++)
+  {
+    string[j] = wkt[token_start + i];
+    if ((string[j] == '"') && (token == CRSWKT_TOKEN_STRING))
+    {
+      i++;
+    }
+  }
+  string[j] = '\0';
+}
+
+BOOL CRSwkt::fail(const CHAR* reason)
+{
+  error_position = token_start;
+  sprintf(error, "%s", reason);
+  return FALSE;
+}
+
+I32 CRSwkt::enclosing_crs(const U32 depth) const
+{
+  for (I32 i = (I32)depth - 1; i >= 0; i--)
+  {
+    if (is_crs(nodes[i].keyword))
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+BOOL CRSwkt::parse_node(const U32 depth, const U32 keyword_start, const U32 keyword_length)
+{
+  if (depth == CRSWKT_MAX_DEPTH)
+  {
+    return fail("nodes are nested too deeply");
+  }
+
+  CRSwktNode* node = &(nodes[depth]);
+  node->keyword = CRSWKT_KEYWORD_OTHER;
+  for (U32 k = 0; keyword_list[k].name; k++)
+  {
+    U32 i;
+    for (i = 0; i < keyword_length; i++)
+    {
+      if (to_upper(wkt[keyword_start + i]) != keyword_list[k].name[i]) break;
+    }
+    if ((i == keyword_length) && (keyword_list[k].name[i] == '\0'))
+    {
+      node->keyword = keyword_list[k].keyword;
+      break;
+    }
+  }
+  node->ignored = ((node->keyword == CRSWKT_KEYWORD_IGNORED) || (depth && nodes[depth-1].ignored));
+  node->number_of_strings = 0;
+  node->number_of_numbers = 0;
+  node->unit = 0.0;
+
+  // the values are strings, numbers, enumerations, and nested nodes separated by commas
+
+  U32 t = next_token();
+  while (TRUE)
+  {
+    if (t == CRSWKT_TOKEN_STRING)
+    {
+      if (node->number_of_strings < 2)
+      {
+        copy_token(node->strings[node->number_of_strings], CRSWKT_MAX_NAME);
+        node->number_of_strings++;
+      }
+      t = next_token();
+    }
+    else if (t == CRSWKT_TOKEN_NUMBER)
+    {
+      if (node->number_of_numbers < 3)
+      {
+        CHAR number[64];
+        copy_token(number, 64);
+        node->numbers[node->number_of_numbers] = atof(number);
+        node->number_of_numbers++;
+      }
+      t = next_token();
+    }
+    else if (t == CRSWKT_TOKEN_WORD)
+    {
+      U32 start = token_start;
+      U32 size = token_length;
+      t = next_token();
+      if (t == CRSWKT_TOKEN_OPEN)
+      {
+        if (!parse_node(depth + 1, start, size))
+        {
+          return FALSE;
+        }
+        t = next_token();
+      }
+    }
+    else if ((t == CRSWKT_TOKEN_CLOSE) && (node->number_of_strings + node->number_of_numbers) == 0)
+    {
+      break;
+    }
+    else if (t == CRSWKT_TOKEN_END)
+    {
+      return fail("the string ends before all brackets are closed");
+    }
+    else
+    {
+      return fail("expected a value");
+    }
+
+    if (t == CRSWKT_TOKEN_CLOSE)
+    {
+      break;
+    }
+    if (t != CRSWKT_TOKEN_COMMA)
+    {
+      return fail((t == CRSWKT_TOKEN_END) ? "the string ends before all brackets are closed" : "expected a comma or a closing bracket");
+    }
+    t = next_token();
+  }
+
+  close_node(depth);
+  return TRUE;
+}
+
+void CRSwkt::close_node(const U32 depth)
+{
+  CRSwktNode* node = &(nodes[depth]);
+  if (node->ignored)
+  {
+    return;
+  }
+
+  CRSwktNode* parent = (depth ? &(nodes[depth-1]) : 0);
+  I32 crs = enclosing_crs(depth);
+  U32 crs_keyword = (crs >= 0 ? nodes[crs].keyword : CRSWKT_KEYWORD_OTHER);
+
+  switch (node->keyword)
+  {
+  case CRSWKT_KEYWORD_PROJECTED:
+    is_projected = TRUE;
+    if (node->number_of_strings) strcpy(name, node->strings[0]);
+    break;
+  case CRSWKT_KEYWORD_GEOGRAPHIC:
+  case CRSWKT_KEYWORD_GEOCENTRIC:
+    // the geographic CRS that a WKT1 projected CRS is based on is not the CRS of the points
+    if (crs_keyword != CRSWKT_KEYWORD_PROJECTED)
+    {
+      if (node->keyword == CRSWKT_KEYWORD_GEOCENTRIC)
+        is_geocentric = TRUE;
+      else
+        is_geographic = TRUE;
+      if (!is_projected && node->number_of_strings) strcpy(name, node->strings[0]);
+    }
+    break;
+  case CRSWKT_KEYWORD_VERTICAL:
+    is_vertical = TRUE;
+    break;
+  case CRSWKT_KEYWORD_AUTHORITY:
+    if (parent && is_crs(parent->keyword) && node->number_of_strings && (strcmp(node->strings[0], "EPSG") == 0))
+    {
+      U32 code = (node->number_of_numbers ? (U32)node->numbers[0] : ((node->number_of_strings > 1) ? (U32)atoi(node->strings[1]) : 0));
+      if (parent->keyword == CRSWKT_KEYWORD_PROJECTED)
+      {
+        horizontal_epsg = code;
+      }
+      else if (parent->keyword == CRSWKT_KEYWORD_VERTICAL)
+      {
+        vertical_epsg = code;
+      }
+      else if ((parent->keyword != CRSWKT_KEYWORD_BASE) && (enclosing_crs(depth-1) == -1) && !is_projected)
+      {
+        horizontal_epsg = code;
+      }
+    }
+    break;
+  case CRSWKT_KEYWORD_UNIT:
+    if (parent && node->number_of_numbers)
+    {
+      if (parent->keyword == CRSWKT_KEYWORD_PARAMETER)
+      {
+        parent->unit = node->numbers[0];
+      }
+      else
+      {
+        // the unit of a WKT1 CRS or of the axes of a WKT2 CRS
+
+        U32 owner = CRSWKT_KEYWORD_OTHER;
+        if (is_crs(parent->keyword))
+          owner = parent->keyword;
+        else if ((parent->keyword == CRSWKT_KEYWORD_AXIS) && (depth > 1) && is_crs(nodes[depth-2].keyword))
+          owner = nodes[depth-2].keyword;
+        if (((owner == CRSWKT_KEYWORD_PROJECTED) || (owner == CRSWKT_KEYWORD_GEOCENTRIC)) && (linear_unit == 0.0))
+        {
+          linear_unit = node->numbers[0];
+        }
+        else if ((owner == CRSWKT_KEYWORD_VERTICAL) && (vertical_unit == 0.0))
+        {
+          vertical_unit = node->numbers[0];
+        }
+      }
+    }
+    break;
+  case CRSWKT_KEYWORD_ANGLEUNIT:
+  case CRSWKT_KEYWORD_SCALEUNIT:
+    if (parent && (parent->keyword == CRSWKT_KEYWORD_PARAMETER) && node->number_of_numbers)
+    {
+      parent->unit = node->numbers[0];
+    }
+    break;
+  case CRSWKT_KEYWORD_DATUM:
+    if ((datum[0] == '\0') && (crs_keyword != CRSWKT_KEYWORD_VERTICAL) && node->number_of_strings)
+    {
+      strcpy(datum, node->strings[0]);
+    }
+    break;
+  case CRSWKT_KEYWORD_ELLIPSOID:
+    if ((semi_major_axis == 0.0) && (node->number_of_numbers >= 2))
+    {
+      semi_major_axis = node->numbers[0];
+      inverse_flattening = node->numbers[1];
+    }
+    break;
+  case CRSWKT_KEYWORD_METHOD:
+    if ((crs_keyword == CRSWKT_KEYWORD_PROJECTED) && node->number_of_strings)
+    {
+      strcpy(method_name, node->strings[0]);
+      method = classify_method(method_name);
+    }
+    break;
+  case CRSWKT_KEYWORD_PARAMETER:
+    if ((crs_keyword == CRSWKT_KEYWORD_PROJECTED) && node->number_of_strings && node->number_of_numbers)
+    {
+      CHAR normalized[CRSWKT_MAX_NAME];
+      normalize(normalized, node->strings[0]);
+      U32 parameter = 0;
+      for (U32 p = 0; parameter_list[p].name; p++)
+      {
+        if (strcmp(normalized, parameter_list[p].name) == 0)
+        {
+          parameter = parameter_list[p].parameter;
+          break;
+        }
+      }
+      F64 value = node->numbers[0];
+      switch (parameter)
+      {
+      case CRSWKT_FALSE_EASTING:
+      case CRSWKT_FALSE_NORTHING:
+        // lengths without a unit of their own are in the unit of the CRS
+        if (node->unit > 0.0)
+        {
+          value *= node->unit;
+          parameters_in_meter |= parameter;
+        }
+        if (parameter == CRSWKT_FALSE_EASTING)
+          false_easting = value;
+        else
+          false_northing = value;
+        break;
+      case CRSWKT_LATITUDE_ORIGIN:
+      case CRSWKT_CENTRAL_MERIDIAN:
+      case CRSWKT_STANDARD_PARALLEL1:
+      case CRSWKT_STANDARD_PARALLEL2:
+        // angles without a unit of their own are in degrees
+        if (node->unit > 0.0)
+        {
+          value *= node->unit * rad2deg;
+        }
+        if (parameter == CRSWKT_LATITUDE_ORIGIN)
+          latitude_of_origin = value;
+        else if (parameter == CRSWKT_CENTRAL_MERIDIAN)
+          central_meridian = value;
+        else if (parameter == CRSWKT_STANDARD_PARALLEL1)
+          standard_parallel1 = value;
+        else
+          standard_parallel2 = value;
+        break;
+      case CRSWKT_SCALE_FACTOR:
+        scale_factor = (node->unit > 0.0 ? value * node->unit : value);
+        break;
+      }
+      parameters |= parameter;
+    }
+    break;
+  }
+}
+
+BOOL CRSwkt::parse(const CHAR* wkt, const U32 length)
+{
+  this->wkt = wkt;
+  this->length = length;
+  position = 0;
+  token = CRSWKT_TOKEN_END;
+  token_start = 0;
+  token_length = 0;
+
+  if (next_token() != CRSWKT_TOKEN_WORD)
+  {
+    return fail("expected a keyword");
+  }
+  U32 start = token_start;
+  U32 size = token_length;
+  if (next_token() != CRSWKT_TOKEN_OPEN)
+  {
+    return fail("expected an opening bracket");
+  }
+  if (!parse_node(0, start, size))
+  {
+    return FALSE;
+  }
+  if (next_token() != CRSWKT_TOKEN_END)
+  {
+    return fail("unexpected characters after the closing bracket");
+  }
+
+  // the lengths of WKT1 projection parameters are in the linear unit of the CRS
+
+  F64 unit = (linear_unit > 0.0 ? linear_unit : 1.0);
+  if (!(parameters_in_meter & CRSWKT_FALSE_EASTING)) false_easting *= unit;
+  if (!(parameters_in_meter & CRSWKT_FALSE_NORTHING)) false_northing *= unit;
+  return TRUE;
+}
+
+CRSwkt::CRSwkt()
+{
+  is_projected = FALSE;
+  is_geographic = FALSE;
+  is_geocentric = FALSE;
+  is_vertical = FALSE;
+  name[0] = '\0';
+  datum[0] = '\0';
+  method_name[0] = '\0';
+  method = CRSWKT_METHOD_UNKNOWN;
+  horizontal_epsg = 0;
+  vertical_epsg = 0;
+  linear_unit = 0.0;
+  vertical_unit = 0.0;
+  semi_major_axis = 0.0;
+  inverse_flattening = 0.0;
+  parameters = 0;
+  parameters_in_meter = 0;
+  false_easting = 0.0;
+  false_northing = 0.0;
+  latitude_of_origin = 0.0;
+  central_meridian = 0.0;
+  scale_factor = 1.0;
+  standard_parallel1 = 0.0;
+  standard_parallel2 = 0.0;
+  error_position = 0;
+  error[0] = '\0';
+  wkt = 0;
+  length = 0;
+  position = 0;
+  token = CRSWKT_TOKEN_END;
+  token_start = 0;
+  token_length = 0;
+}
@@ -0,0 +1,127 @@
+/*
+===============================================================================
+
+  FILE:  crswkt.hpp
+
+  CONTENTS:
+
+    Parses the OGC WKT string of a LAS 1.4 file in one pass over its bytes
+    without allocating any memory. Both WKT1 (PROJCS, GEOGCS, VERT_CS, ...)
+    and WKT2 (PROJCRS, GEOGCRS, VERTCRS, ...) are understood. The tokenizer
+    feeds a recursive descent parser with a fixed depth that keeps one small
+    record per open node. When a node closes it hands what it found to the
+    enclosing CRS: the EPSG codes of the horizontal and the vertical CRS, the
+    linear and the vertical units, the datum, the ellipsoid, the projection
+    method, and the projection parameters converted to meters and degrees.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    19 October 2026 -- created for checking the OGC WKT of LAS 1.4 files
+
+===============================================================================
+*/
+#ifndef CRS_WKT_HPP
+#define CRS_WKT_HPP
+
+#include "mydefs.hpp"
+
+#define CRSWKT_MAX_DEPTH 16
+#define CRSWKT_MAX_NAME  128
+
+#define CRSWKT_METHOD_UNKNOWN 0
+#define CRSWKT_METHOD_TM      1
+#define CRSWKT_METHOD_LCC     2
+
+#define CRSWKT_FALSE_EASTING      0x01
+#define CRSWKT_FALSE_NORTHING     0x02
+#define CRSWKT_LATITUDE_ORIGIN    0x04
+#define CRSWKT_CENTRAL_MERIDIAN   0x08
+#define CRSWKT_SCALE_FACTOR       0x10
+#define CRSWKT_STANDARD_PARALLEL1 0x20
+#define CRSWKT_STANDARD_PARALLEL2 0x40
+
+class CRSwktNode
+{
+public:
+  U32 keyword;
+  BOOL ignored;
+  U32 number_of_strings;
+  U32 number_of_numbers;
+  CHAR strings[2][CRSWKT_MAX_NAME];
+  F64 numbers[3];
+  F64 unit;
+};
+
+class CRSwkt
+{
+public:
+  BOOL parse(const CHAR* wkt, const U32 length);
+
+  // what the WKT specifies (codes and units are 0 if not given)
+
+  BOOL is_projected;
+  BOOL is_geographic;
+  BOOL is_geocentric;
+  BOOL is_vertical;
+  CHAR name[CRSWKT_MAX_NAME];
+  CHAR datum[CRSWKT_MAX_NAME];
+  CHAR method_name[CRSWKT_MAX_NAME];
+  U32 method;
+  U32 horizontal_epsg;
+  U32 vertical_epsg;
+  F64 linear_unit;
+  F64 vertical_unit;
+  F64 semi_major_axis;
+  F64 inverse_flattening;
+
+  // projection parameters in meters and degrees with a bit for each one that was given
+
+  U32 parameters;
+  F64 false_easting;
+  F64 false_northing;
+  F64 latitude_of_origin;
+  F64 central_meridian;
+  F64 scale_factor;
+  F64 standard_parallel1;
+  F64 standard_parallel2;
+
+  // the position and the reason if the WKT is not well formed
+
+  U32 error_position;
+  CHAR error[CRSWKT_MAX_NAME];
+
+  CRSwkt();
+
+private:
+  const CHAR* wkt;
+  U32 length;
+  U32 position;
+  U32 token;
+  U32 token_start;
+  U32 token_length;
+  U32 parameters_in_meter;
+  CRSwktNode nodes[CRSWKT_MAX_DEPTH];
+  U32 next_token();
+  void copy_token(CHAR* string, const U32 size) const;
+  BOOL parse_node(const U32 depth, const U32 keyword_start, const U32 keyword_length);
+  void close_node(const U32 depth);
+  I32 enclosing_crs(const U32 depth) const;
+  BOOL fail(const CHAR* reason);
+};
+
+#endif
@@ -0,0 +1,341 @@
+/*
+===============================================================================
+
+  FILE:  densitycheck.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "densitycheck.hpp"
+
+static const F64 percentile_levels[5] = { 0.05, 0.25, 0.50, 0.75, 0.95 };
+static const CHAR* percentile_names[5] = { "density_5th_percentile", "density_25th_percentile", "density_median", "density_75th_percentile", "density_95th_percentile" };
+
+static int compare_counts(const void* a, const void* b)
+{
+  U32 count_a = *((const U32*)a);
+  U32 count_b = *((const U32*)b);
+  return (count_a < count_b ? -1 : (count_a > count_b ? 1 : 0));
+}
+
+// cells are stored in blocks of 8 by 8 so that one block spans two cache lines of 16 bit counters
+
+U32 DENSITYcheck::index(const U32 col, const U32 row) const
+{
+  return ((((row >> 3) * blocks_per_row) + (col >> 3)) << 6) | ((row & 7) << 3) | (col & 7);
+}
+
+U32 DENSITYcheck::get_count(const U32 col, const U32 row) const
+{
+  return (counts32 ? counts32[index(col, row)] : counts16[index(col, row)]);
+}
+
+void DENSITYcheck::parse(const LASpoint* laspoint)
+{
+  if (counts16 == 0)
+  {
+    return;
+  }
+
+  // only the first return of each pulse counts
+
+  if ((laspoint->extended_point_type ? laspoint->extended_return_number : laspoint->return_number) > 1)
+  {
+    return;
+  }
+
+  F64 col = ((x_scale_factor*laspoint->X + x_offset) - min_x) / cell_size;
+  F64 row = ((y_scale_factor*laspoint->Y + y_offset) - min_y) / cell_size;
+
+  // points outside the bounding box are reported elsewhere
+
+  if ((col < 0.0) || (row < 0.0) || (col >= ncols) || (row >= nrows))
+  {
+    if ((col < 0.0) || (row < 0.0) || (col > ncols) || (row > nrows))
+    {
+      return;
+    }
+    if (col >= ncols) col = ncols - 1;
+    if (row >= nrows) row = nrows - 1;
+  }
+
+  U32 i = index((U32)col, (U32)row);
+  number_of_pulses++;
+
+  if (counts32)
+  {
+    counts32[i]++;
+  }
+  else if (counts16[i] == U16_MAX)
+  {
+    // this cell overflows so all counters become 32 bit
+
+    U32 number_of_counters = blocks_per_row * ((nrows + 7) >> 3) * 64; // at most DENSITYCHECK_MAX_CELLS
+    counts32 = (U32*)malloc(sizeof(U32)*number_of_counters);
+    if (counts32 == 0)
+    {
+      return;
+    }
+    for (U32 j = 0; j < number_of_counters; j++)
+    {
+      counts32[j] = counts16[j];
+    }
+    counts32[i]++;
+  }
+  else
+  {
+    counts16[i]++;
+  }
+}
+
+void DENSITYcheck::check(LASheader* lasheader)
+{
+  CHAR note[512];
+  U32 col, row;
+
+  if (too_many_cells)
+  {
+    sprintf(note, "cannot check density because a grid of %u by %u cells of size %g is too large", ncols, nrows, cell_size);
+    lasheader->add_warning("point density", note);
+    return;
+  }
+
+  // only cells that lie completely inside the bounding box are evaluated
+
+  U32 number_of_cells = full_ncols * full_nrows;
+  if (ncols && (number_of_cells == 0))
+  {
+    sprintf(note, "cannot check density because the bounding box is smaller than one cell of size %g", cell_size);
+    lasheader->add_warning("point density", note);
+    return;
+  }
+
+  if (counts16 == 0)
+  {
+    return;
+  }
+
+  F64 cell_area = cell_size * cell_size;
+  U32* counts = (U32*)malloc(sizeof(U32)*number_of_cells);
+  if (counts == 0)
+  {
+    return;
+  }
+
+  U32 n = 0;
+  I64 pulses_in_covered_cells = 0;
+  for (row = 0; row < full_nrows; row++)
+  {
+    for (col = 0; col < full_ncols; col++)
+    {
+      U32 count = get_count(col, row);
+      if (count == 0)
+      {
+        if (number_of_void_cells == 0)
+        {
+          first_void_col = col;
+          first_void_row = row;
+        }
+        number_of_void_cells++;
+      }
+      else
+      {
+        pulses_in_covered_cells += count;
+      }
+      if ((count / cell_area) < min_density)
+      {
+        number_of_low_cells++;
+      }
+      counts[n++] = count;
+    }
+  }
+
+  qsort(counts, number_of_cells, sizeof(U32), compare_counts);
+  for (U32 i = 0; i < 5; i++)
+  {
+    percentiles[i] = counts[(U32)(percentile_levels[i] * (number_of_cells - 1) + 0.5)] / cell_area;
+  }
+  free(counts);
+
+  // the nominal pulse spacing is measured over the covered area only
+
+  if (number_of_cells > number_of_void_cells)
+  {
+    F64 covered_area = (number_of_cells - number_of_void_cells) * cell_area;
+    nominal_pulse_density = pulses_in_covered_cells / covered_area;
+    nominal_pulse_spacing = sqrt(covered_area / pulses_in_covered_cells);
+  }
+
+  if (number_of_void_cells)
+  {
+    sprintf(note, "%u of %u cells of size %g have no pulses (%.1f percent), the first at %.2f %.2f", number_of_void_cells, number_of_cells, cell_size, 100.0*number_of_void_cells/number_of_cells, min_x + (first_void_col + 0.5)*cell_size, min_y + (first_void_row + 0.5)*cell_size);
+    lasheader->add_warning("point density", note);
+  }
+
+  if (number_of_low_cells > number_of_void_cells)
+  {
+    sprintf(note, "%u of %u cells of size %g have fewer than %g pulses per square unit (%.1f percent)", number_of_low_cells, number_of_cells, cell_size, min_density, 100.0*number_of_low_cells/number_of_cells);
+    lasheader->add_warning("point density", note);
+  }
+}
+
+void DENSITYcheck::write_statistics(XMLwriter* xmlwriter) const
+{
+  CHAR value[64];
+
+  if ((counts16 == 0) || (full_ncols * full_nrows == 0))
+  {
+    return;
+  }
+
+  sprintf(value, "%g", cell_size);
+  xmlwriter->write("density_cell_size", value);
+  xmlwriter->write("density_cells", (I32)(full_ncols * full_nrows));
+  xmlwriter->write("density_void_cells", (I32)number_of_void_cells);
+  for (U32 i = 0; i < 5; i++)
+  {
+    sprintf(value, "%.3f", percentiles[i]);
+    xmlwriter->write(percentile_names[i], value);
+  }
+  sprintf(value, "%.3f", nominal_pulse_density);
+  xmlwriter->write("nominal_pulse_density", value);
+  sprintf(value, "%.3f", nominal_pulse_spacing);
+  xmlwriter->write("nominal_pulse_spacing", value);
+}
+
+BOOL DENSITYcheck::write_raster(const CHAR* file_name) const
+{
+  if (counts16 == 0)
+  {
+    return FALSE;
+  }
+
+  FILE* file = fopen(file_name, "w");
+  if (file == 0)
+  {
+    return FALSE;
+  }
+
+  // an ESRI ASCII grid of pulses per square unit with the northern row first
+
+  F64 cell_area = cell_size * cell_size;
+  fprintf(file, "ncols %u\n", ncols);
+  fprintf(file, "nrows %u\n", nrows);
+  fprintf(file, "xllcorner %.10g\n", min_x);
+  fprintf(file, "yllcorner %.10g\n", min_y);
+  fprintf(file, "cellsize %g\n", cell_size);
+  fprintf(file, "NODATA_value -1\n");
+  for (U32 row = nrows; row > 0; row--)
+  {
+    for (U32 col = 0; col < ncols; col++)
+    {
+      fprintf(file, (col ? " %g" : "%g"), get_count(col, row-1) / cell_area);
+    }
+    fprintf(file, "\n");
+  }
+  fclose(file);
+  return TRUE;
+}
+
+DENSITYcheck::DENSITYcheck(const LASheader* lasheader, const F64 cell_size, const F64 min_density)
+{
+  this->cell_size = cell_size;
+  this->min_density = min_density;
+  min_x = lasheader->min_x;
+  min_y = lasheader->min_y;
+  x_scale_factor = lasheader->x_scale_factor;
+  y_scale_factor = lasheader->y_scale_factor;
+  x_offset = lasheader->x_offset;
+  y_offset = lasheader->y_offset;
+  counts16 = 0;
+  counts32 = 0;
+  too_many_cells = FALSE;
+  number_of_pulses = 0;
+  number_of_void_cells = 0;
+  number_of_low_cells = 0;
+  first_void_col = first_void_row = 0;
+  percentiles[0] = percentiles[1] = percentiles[2] = percentiles[3] = percentiles[4] = 0.0;
+  nominal_pulse_density = 0.0;
+  nominal_pulse_spacing = 0.0;
+  ncols = nrows = 0;
+  full_ncols = full_nrows = 0;
+  blocks_per_row = 0;
+
+  F64 width = (lasheader->max_x - lasheader->min_x) / cell_size;
+  F64 height = (lasheader->max_y - lasheader->min_y) / cell_size;
+
+  if (!(width >= 0.0) || !(height >= 0.0))
+  {
+    return;
+  }
+  // the last column and row may stick out of the bounding box and a flat bounding
+  // box still has one of them. the grid is limited after rounding up to full blocks.
+
+  F64 cols = (ceil(width) < 1.0 ? 1.0 : ceil(width));
+  F64 rows = (ceil(height) < 1.0 ? 1.0 : ceil(height));
+  if ((cols > DENSITYCHECK_MAX_CELLS) || (rows > DENSITYCHECK_MAX_CELLS))
+  {
+    too_many_cells = TRUE;
+    ncols = (cols < U32_MAX ? (U32)cols : U32_MAX);
+    nrows = (rows < U32_MAX ? (U32)rows : U32_MAX);
+    return;
+  }
+  ncols = (U32)cols;
+  nrows = (U32)rows;
+  U64 number_of_counters = ((U64)((ncols + 7) >> 3)) * ((U64)((nrows + 7) >> 3)) * 64;
+  if (number_of_counters > DENSITYCHECK_MAX_CELLS)
+  {
+    too_many_cells = TRUE;
+    return;
+  }
+  full_ncols = (U32)floor(width + 1e-9);
+  full_nrows = (U32)floor(height + 1e-9);
+  if (full_ncols > ncols) full_ncols = ncols;
+  if (full_nrows > nrows) full_nrows = nrows;
+  if ((full_ncols == 0) || (full_nrows == 0))
+  {
+    // no cell to evaluate so no grid is needed
+
+    return;
+  }
+  blocks_per_row = (ncols + 7) >> 3;
+  counts16 = (U16*)calloc((size_t)number_of_counters, sizeof(U16));
+  if (counts16 == 0)
+  {
+    too_many_cells = TRUE;
+  }
+}
+
+DENSITYcheck::~DENSITYcheck()
+{
+  if (counts16) free(counts16);
+  if (counts32) free(counts32);
+}
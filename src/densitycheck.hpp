@@ -0,0 +1,87 @@
+/*
+===============================================================================
+
+  FILE:  densitycheck.hpp
+
+  CONTENTS:
+
+    Counts the pulses (the first returns) of a tile in a 2D grid that covers
+    the bounding box of the header. The counters are stored in 8 by 8 blocks
+    of 16 bit (promoted to 32 bit if one overflows) so neighbouring points of
+    a scan line mostly hit the same cache lines. From the grid come density
+    percentiles, the nominal pulse spacing, void cells, and cells below a
+    minimum density. The grid can be stored as an ASCII raster.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    19 October 2026 -- created for density and coverage checks of tiles
+
+===============================================================================
+*/
+#ifndef DENSITY_CHECK_HPP
+#define DENSITY_CHECK_HPP
+
+#include "lasheader.hpp"
+#include "laspoint.hpp"
+
+#include "xmlwriter.hpp"
+
+#define DENSITYCHECK_MAX_CELLS 0x10000000
+
+class DENSITYcheck
+{
+public:
+
+  void parse(const LASpoint* laspoint);
+  void check(LASheader* lasheader);
+  void write_statistics(XMLwriter* xmlwriter) const;
+  BOOL write_raster(const CHAR* file_name) const;
+
+  DENSITYcheck(const LASheader* lasheader, const F64 cell_size, const F64 min_density=0.0);
+  ~DENSITYcheck();
+
+private:
+  F64 cell_size;
+  F64 min_density;
+  F64 min_x, min_y;
+  F64 x_scale_factor, y_scale_factor;
+  F64 x_offset, y_offset;
+
+  // the grid and its cells that lie completely inside the bounding box
+
+  U32 ncols, nrows;
+  U32 full_ncols, full_nrows;
+  U32 blocks_per_row;
+  U16* counts16;
+  U32* counts32;
+  U32 index(const U32 col, const U32 row) const;
+  U32 get_count(const U32 col, const U32 row) const;
+
+  // the results
+
+  BOOL too_many_cells;
+  I64 number_of_pulses;
+  U32 number_of_void_cells;
+  U32 number_of_low_cells;
+  U32 first_void_col, first_void_row;
+  F64 percentiles[5];
+  F64 nominal_pulse_density;
+  F64 nominal_pulse_spacing;
+};
+
+#endif
@@ -0,0 +1,424 @@
+/*
+===============================================================================
+
+  FILE:  duplicatecheck.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "duplicatecheck.hpp"
+#include "checkutility.hpp"
+
+#define DUPLICATECHECK_MIN_CAPACITY 65536
+#define DUPLICATECHECK_BUFFER 1024
+
+static U64 mix64(U64 h)
+{
+  h ^= h >> 30;
+  h *= 0xBF58476D1CE4E5B9ULL;
+  h ^= h >> 27;
+  h *= 0x94D049BB133111EBULL;
+  h ^= h >> 31;
+  return h;
+}
+
+// the low bits select the table slot and the high bits select the partition
+
+static U64 hash_entry(const DUPLICATEentry* entry)
+{
+  U64 h = mix64((((U64)(U32)entry->X) << 32) | ((U64)(U32)entry->Y));
+  h = mix64(h ^ (U64)(U32)entry->Z);
+  return mix64(h ^ (U64)entry->gps_time);
+}
+
+static U32 partition_of(const U64 hash, const I32 level)
+{
+  return (U32)(hash >> (58 - 6*level)) & (DUPLICATECHECK_PARTITIONS - 1);
+}
+
+// the smallest power of two that keeps a table with this many entries at most
+// half full or 0 when no U32 capacity is large enough
+
+static U32 capacity_for(const U64 number_of_entries)
+{
+  U64 capacity = DUPLICATECHECK_MIN_CAPACITY;
+  while (capacity < 2*number_of_entries)
+  {
+    capacity *= 2;
+  }
+  return (capacity > 0x80000000 ? 0 : (U32)capacity);
+}
+
+BOOL DUPLICATEcheck::allocate_table(const U32 capacity)
+{
+  if (table_capacity != capacity)
+  {
+    // the old entries are not needed so the old table goes before the new one comes
+
+    if (table) free(table);
+    table = (DUPLICATEentry*)malloc(sizeof(DUPLICATEentry)*capacity);
+    if (table == 0)
+    {
+      table_capacity = 0;
+      table_mask = 0;
+      table_size = 0;
+      out_of_memory = TRUE;
+      return FALSE;
+    }
+    table_capacity = capacity;
+    table_mask = capacity - 1;
+  }
+  clear_table();
+  return TRUE;
+}
+
+BOOL DUPLICATEcheck::grow_table()
+{
+  // the old and the new table are both allocated while the entries move over
+
+  U32 capacity = 2*table_capacity;
+  if ((capacity == 0) || (((U64)table_capacity + (U64)capacity)*sizeof(DUPLICATEentry) > budget))
+  {
+    return FALSE;
+  }
+  DUPLICATEentry* new_table = (DUPLICATEentry*)calloc(capacity, sizeof(DUPLICATEentry));
+  if (new_table == 0)
+  {
+    return FALSE;
+  }
+  DUPLICATEentry* old_table = table;
+  U32 old_capacity = table_capacity;
+  table = new_table;
+  table_capacity = capacity;
+  table_mask = capacity - 1;
+  table_size = 0;
+  for (U32 i = 0; i < old_capacity; i++)
+  {
+    if (old_table[i].count)
+    {
+      insert(&(old_table[i]), hash_entry(&(old_table[i])));
+    }
+  }
+  free(old_table);
+  return TRUE;
+}
+
+void DUPLICATEcheck::insert(const DUPLICATEentry* entry, const U64 hash)
+{
+  U32 slot = (U32)hash & table_mask;
+  while (table[slot].count)
+  {
+    if ((table[slot].X == entry->X) && (table[slot].Y == entry->Y) && (table[slot].Z == entry->Z) && (table[slot].gps_time == entry->gps_time))
+    {
+      table[slot].count += entry->count;
+      return;
+    }
+    slot = (slot + 1) & table_mask;
+  }
+  table[slot] = *entry;
+  table_size++;
+}
+
+void DUPLICATEcheck::count_table()
+{
+  for (U32 i = 0; i < table_capacity; i++)
+  {
+    if (table[i].count > 1)
+    {
+      number_of_locations++;
+      number_of_duplicates += (table[i].count - 1);
+      if (number_of_samples < DUPLICATECHECK_SAMPLES)
+      {
+        samples[number_of_samples] = table[i];
+        number_of_samples++;
+      }
+    }
+  }
+}
+
+void DUPLICATEcheck::clear_table()
+{
+  memset(table, 0, sizeof(DUPLICATEentry)*table_capacity);
+  table_size = 0;
+}
+
+BOOL DUPLICATEcheck::spill_table()
+{
+  U32 i;
+  if (partitions[0] == 0)
+  {
+    for (i = 0; i < DUPLICATECHECK_PARTITIONS; i++)
+    {
+      partitions[i] = tmpfile();
+      if (partitions[i] == 0)
+      {
+        return FALSE;
+      }
+    }
+  }
+  for (i = 0; i < table_capacity; i++)
+  {
+    if (table[i].count)
+    {
+      U32 p = partition_of(hash_entry(&(table[i])), 0);
+      if (fwrite(&(table[i]), sizeof(DUPLICATEentry), 1, partitions[p]) != 1)
+      {
+        return FALSE;
+      }
+      partition_records[p]++;
+    }
+  }
+  clear_table();
+  return TRUE;
+}
+
+BOOL DUPLICATEcheck::count_partition(FILE* file, const U64 number_of_records, const I32 level)
+{
+  U32 i, n;
+  DUPLICATEentry buffer[DUPLICATECHECK_BUFFER];
+
+  rewind(file);
+
+  if (number_of_records == 0)
+  {
+    return TRUE;
+  }
+
+  U32 capacity = capacity_for(number_of_records);
+
+  if (((capacity == 0) || (((U64)capacity)*sizeof(DUPLICATEentry) > budget)) && (level < DUPLICATECHECK_MAX_LEVEL))
+  {
+    // still too big so split it further with the next six bits of the hash
+
+    FILE* subpartitions[DUPLICATECHECK_PARTITIONS];
+    U64 subpartition_records[DUPLICATECHECK_PARTITIONS];
+    for (i = 0; i < DUPLICATECHECK_PARTITIONS; i++)
+    {
+      subpartition_records[i] = 0;
+      subpartitions[i] = tmpfile();
+      if (subpartitions[i] == 0)
+      {
+        while (i) fclose(subpartitions[--i]);
+        return FALSE;
+      }
+    }
+    BOOL success = TRUE;
+    while (success && (n = (U32)fread(buffer, sizeof(DUPLICATEentry), DUPLICATECHECK_BUFFER, file)))
+    {
+      for (i = 0; i < n; i++)
+      {
+        U32 p = partition_of(hash_entry(&(buffer[i])), level);
+        if (fwrite(&(buffer[i]), sizeof(DUPLICATEentry), 1, subpartitions[p]) != 1)
+        {
+          success = FALSE;
+          break;
+        }
+        subpartition_records[p]++;
+      }
+    }
+    for (i = 0; i < DUPLICATECHECK_PARTITIONS; i++)
+    {
+      if (success)
+      {
+        success = count_partition(subpartitions[i], subpartition_records[i], level + 1);
+      }
+      fclose(subpartitions[i]);
+    }
+    return success;
+  }
+
+  // the partition fits into a table (or it cannot be split any further)
+
+  if (capacity == 0)
+  {
+    out_of_memory = TRUE;
+    return FALSE;
+  }
+  if (!allocate_table(capacity))
+  {
+    return FALSE;
+  }
+  while ((n = (U32)fread(buffer, sizeof(DUPLICATEentry), DUPLICATECHECK_BUFFER, file)))
+  {
+    for (i = 0; i < n; i++)
+    {
+      insert(&(buffer[i]), hash_entry(&(buffer[i])));
+    }
+  }
+  count_table();
+  return TRUE;
+}
+
+void DUPLICATEcheck::parse(const LASpoint* laspoint)
+{
+  if (failed)
+  {
+    return;
+  }
+
+  DUPLICATEentry entry;
+  entry.X = laspoint->X;
+  entry.Y = laspoint->Y;
+  entry.Z = laspoint->Z;
+  entry.count = 1;
+  if (has_gps_time)
+  {
+    memcpy(&(entry.gps_time), &(laspoint->gps_time), sizeof(I64));
+  }
+  else
+  {
+    entry.gps_time = 0;
+  }
+
+  if (2*table_size >= table_capacity)
+  {
+    // a full table is grown while the budget allows and spilled to disk otherwise
+
+    if (!grow_table())
+    {
+      if (!spill_table())
+      {
+        failed = TRUE;
+        return;
+      }
+    }
+  }
+
+  insert(&entry, hash_entry(&entry));
+  number_of_points++;
+}
+
+void DUPLICATEcheck::check(LASheader* lasheader)
+{
+  CHAR note[512];
+
+  if (!failed)
+  {
+    if (partitions[0])
+    {
+      // count the partitions on disk one after the other
+
+      if (spill_table())
+      {
+        for (U32 i = 0; i < DUPLICATECHECK_PARTITIONS; i++)
+        {
+          if (!count_partition(partitions[i], partition_records[i], 1))
+          {
+            failed = TRUE;
+            break;
+          }
+        }
+      }
+      else
+      {
+        failed = TRUE;
+      }
+    }
+    else
+    {
+      count_table();
+    }
+  }
+
+  if (failed)
+  {
+    if (out_of_memory)
+    {
+      sprintf(note, "could not check for duplicate points because there was not enough memory");
+    }
+    else
+    {
+      sprintf(note, "could not check for duplicate points because temporary files could not be written");
+    }
+    lasheader->add_warning("duplicate points", note);
+    return;
+  }
+
+  if (number_of_duplicates)
+  {
+#ifdef _WIN32
+    sprintf(note, "there are %I64d duplicate points at %I64d locations with identical X, Y, and Z coordinates%s", number_of_duplicates, number_of_locations, (has_gps_time ? " and GPS time" : ""));
+#else
+    sprintf(note, "there are %lld duplicate points at %lld locations with identical X, Y, and Z coordinates%s", number_of_duplicates, number_of_locations, (has_gps_time ? " and GPS time" : ""));
+#endif
+    lasheader->add_warning("duplicate points", note);
+
+    I32 digits_x = decimal_digits(lasheader->x_scale_factor);
+    I32 digits_y = decimal_digits(lasheader->y_scale_factor);
+    I32 digits_z = decimal_digits(lasheader->z_scale_factor);
+    for (U32 i = 0; i < number_of_samples; i++)
+    {
+      if (has_gps_time)
+      {
+        F64 gps_time;
+        memcpy(&gps_time, &(samples[i].gps_time), sizeof(F64));
+        sprintf(note, "%u points at %.*f %.*f %.*f with GPS time %.6f", samples[i].count, digits_x, lasheader->get_x(samples[i].X), digits_y, lasheader->get_y(samples[i].Y), digits_z, lasheader->get_z(samples[i].Z), gps_time);
+      }
+      else
+      {
+        sprintf(note, "%u points at %.*f %.*f %.*f", samples[i].count, digits_x, lasheader->get_x(samples[i].X), digits_y, lasheader->get_y(samples[i].Y), digits_z, lasheader->get_z(samples[i].Z));
+      }
+      lasheader->add_warning("duplicate points", note);
+    }
+  }
+}
+
+DUPLICATEcheck::DUPLICATEcheck(const BOOL has_gps_time, const U32 budget_in_MB)
+{
+  this->has_gps_time = has_gps_time;
+  budget = ((U64)budget_in_MB) << 20;
+  if (budget < DUPLICATECHECK_MIN_CAPACITY*sizeof(DUPLICATEentry))
+  {
+    budget = DUPLICATECHECK_MIN_CAPACITY*sizeof(DUPLICATEentry);
+  }
+  table = 0;
+  table_capacity = 0;
+  table_mask = 0;
+  table_size = 0;
+  out_of_memory = FALSE;
+  for (U32 i = 0; i < DUPLICATECHECK_PARTITIONS; i++)
+  {
+    partitions[i] = 0;
+    partition_records[i] = 0;
+  }
+  failed = !allocate_table(DUPLICATECHECK_MIN_CAPACITY);
+  number_of_points = 0;
+  number_of_duplicates = 0;
+  number_of_locations = 0;
+  number_of_samples = 0;
+}
+
+DUPLICATEcheck::~DUPLICATEcheck()
+{
+  for (U32 i = 0; i < DUPLICATECHECK_PARTITIONS; i++)
+  {
+    if (partitions[i]) fclose(partitions[i]);
+  }
+  if (table) free(table);
+}
@@ -0,0 +1,105 @@
+/*
+===============================================================================
+
+  FILE:  duplicatecheck.hpp
+
+  CONTENTS:
+
+    Counts points that have the same integer X, Y, and Z coordinates (and the
+    same GPS time when the point type has one) as another point of the file.
+    The coordinates are hashed into an open-addressing table that combines
+    repeated keys. When the table would exceed the memory budget it is spilled
+    into partitions on temporary files that are later counted one by one, so
+    tiles with billions of points need disk space but no more memory.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    19 October 2026 -- the memory budget holds for rounded and growing tables
+    19 October 2026 -- created for finding duplicate points in huge tiles
+
+===============================================================================
+*/
+#ifndef DUPLICATE_CHECK_HPP
+#define DUPLICATE_CHECK_HPP
+
+#include <stdio.h>
+
+#include "lasheader.hpp"
+#include "laspoint.hpp"
+
+#define DUPLICATECHECK_PARTITIONS 64
+#define DUPLICATECHECK_MAX_LEVEL 4
+#define DUPLICATECHECK_SAMPLES 5
+
+// one table entry and also one record in the partition files
+
+class DUPLICATEentry
+{
+public:
+  I32 X;
+  I32 Y;
+  I32 Z;
+  U32 count;
+  I64 gps_time;
+};
+
+class DUPLICATEcheck
+{
+public:
+
+  void parse(const LASpoint* laspoint);
+  void check(LASheader* lasheader);
+
+  DUPLICATEcheck(const BOOL has_gps_time, const U32 budget_in_MB=512);
+  ~DUPLICATEcheck();
+
+private:
+  BOOL has_gps_time;
+  U64 budget;
+
+  // the table is at most half full
+
+  DUPLICATEentry* table;
+  U32 table_capacity;
+  U32 table_mask;
+  U32 table_size;
+  BOOL allocate_table(const U32 capacity);
+  BOOL grow_table();
+  void insert(const DUPLICATEentry* entry, const U64 hash);
+  void count_table();
+  void clear_table();
+
+  // the partition files (only created once the table would exceed the budget)
+
+  FILE* partitions[DUPLICATECHECK_PARTITIONS];
+  U64 partition_records[DUPLICATECHECK_PARTITIONS];
+  BOOL spill_table();
+  BOOL count_partition(FILE* file, const U64 number_of_records, const I32 level);
+
+  // the results
+
+  BOOL failed;
+  BOOL out_of_memory;
+  I64 number_of_points;
+  I64 number_of_duplicates;
+  I64 number_of_locations;
+  U32 number_of_samples;
+  DUPLICATEentry samples[DUPLICATECHECK_SAMPLES];
+};
+
+#endif
@@ -0,0 +1,410 @@
+/*
+===============================================================================
+
+  FILE:  extrabytescheck.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "extrabytescheck.hpp"
+
+// the size of the standard fields of the point data formats 0 to 10
+
+static const U32 standard_record_length[11] = { 20, 28, 26, 34, 57, 63, 30, 36, 38, 59, 67 };
+
+// the size and the name of the data types 1 to 10. the types 11 to 30 are
+// deprecated tuples of two or three of them.
+
+static const U32 data_type_size[11] = { 0, 1, 1, 2, 2, 4, 4, 8, 8, 4, 8 };
+static const CHAR* data_type_names[11] = { "undocumented", "uchar", "char", "ushort", "short", "ulong", "long", "ulonglong", "longlong", "float", "double" };
+
+static inline BOOL is_unsigned(const U8 data_type) { return ((data_type == 1) || (data_type == 3) || (data_type == 5) || (data_type == 7)); }
+static inline BOOL is_float(const U8 data_type) { return ((data_type == 9) || (data_type == 10)); }
+
+template<typename A> static inline A& get(U64I64F64& value);
+template<> inline U64& get<U64>(U64I64F64& value) { return value.u64; }
+template<> inline I64& get<I64>(U64I64F64& value) { return value.i64; }
+template<> inline F64& get<F64>(U64I64F64& value) { return value.f64; }
+
+// reads a value of type T and compares it as type A with the descriptor
+
+template<typename T, typename A>
+static void scan_attribute(EXTRABYTESattribute* attribute, const U8* extra_bytes)
+{
+  T raw;
+  memcpy(&raw, extra_bytes + attribute->start, sizeof(T));
+  A value = (A)raw;
+  if ((attribute->options & EXTRABYTESCHECK_OPTION_NO_DATA) && (value == get<A>(attribute->no_data)))
+  {
+    attribute->number_of_no_data++;
+    return;
+  }
+  if (attribute->number_of_values == 0)
+  {
+    get<A>(attribute->value_min) = value;
+    get<A>(attribute->value_max) = value;
+  }
+  else if (value < get<A>(attribute->value_min))
+  {
+    get<A>(attribute->value_min) = value;
+  }
+  else if (value > get<A>(attribute->value_max))
+  {
+    get<A>(attribute->value_max) = value;
+  }
+  if ((attribute->options & EXTRABYTESCHECK_OPTION_MIN) && (value < get<A>(attribute->min)))
+  {
+    attribute->number_below_min++;
+  }
+  if ((attribute->options & EXTRABYTESCHECK_OPTION_MAX) && (value > get<A>(attribute->max)))
+  {
+    attribute->number_above_max++;
+  }
+  attribute->number_of_values++;
+}
+
+static const EXTRABYTESkernel kernels[11] =
+{
+  0,
+  scan_attribute<U8, U64>,
+  scan_attribute<I8, I64>,
+  scan_attribute<U16, U64>,
+  scan_attribute<I16, I64>,
+  scan_attribute<U32, U64>,
+  scan_attribute<I32, I64>,
+  scan_attribute<U64, U64>,
+  scan_attribute<I64, I64>,
+  scan_attribute<F32, F64>,
+  scan_attribute<F64, F64>
+};
+
+void EXTRABYTEScheck::parse_descriptors(const U8* data, const U32 number_of_descriptors)
+{
+  attributes = (EXTRABYTESattribute*)calloc(number_of_descriptors, sizeof(EXTRABYTESattribute));
+  kernel_attributes = (EXTRABYTESattribute**)calloc(number_of_descriptors, sizeof(EXTRABYTESattribute*));
+  if ((attributes == 0) || (kernel_attributes == 0))
+  {
+    return;
+  }
+  number_of_attributes = number_of_descriptors;
+
+  U32 start = 0;
+  for (U32 i = 0; i < number_of_attributes; i++)
+  {
+    const U8* descriptor = data + i*EXTRABYTESCHECK_DESCRIPTOR_SIZE;
+    EXTRABYTESattribute* attribute = &attributes[i];
+    attribute->data_type = descriptor[2];
+    attribute->options = descriptor[3];
+    memcpy(attribute->name, descriptor + 4, 32);
+    attribute->name[32] = '\0';
+    memcpy(&(attribute->no_data), descriptor + 40, 8);
+    memcpy(&(attribute->min), descriptor + 64, 8);
+    memcpy(&(attribute->max), descriptor + 88, 8);
+    memcpy(&(attribute->scale), descriptor + 112, 8);
+    memcpy(&(attribute->offset), descriptor + 136, 8);
+
+    if (attribute->data_type == 0)
+    {
+      attribute->size = attribute->options;
+    }
+    else if (attribute->data_type <= 10)
+    {
+      attribute->size = data_type_size[attribute->data_type];
+    }
+    else if (attribute->data_type <= 30)
+    {
+      attribute->size = data_type_size[(attribute->data_type - 1) % 10 + 1] * ((attribute->data_type - 1) / 10 + 1);
+    }
+    attribute->start = start;
+    start += attribute->size;
+
+    // only attributes that fit completely into the extra bytes of the records are scanned
+
+    if ((attribute->data_type >= 1) && (attribute->data_type <= 10) && (start <= number_of_extra_bytes))
+    {
+      attribute->kernel = kernels[attribute->data_type];
+      kernel_attributes[number_of_kernels] = attribute;
+      number_of_kernels++;
+    }
+  }
+  number_of_described_bytes = start;
+}
+
+BOOL EXTRABYTEScheck::has_extra_bytes() const
+{
+  return (number_of_extra_bytes || descriptor_payload_size);
+}
+
+void EXTRABYTEScheck::parse(const LASpoint* laspoint)
+{
+  if (number_of_extra_bytes == 0)
+  {
+    return;
+  }
+  if ((laspoint->extra_bytes == 0) || (laspoint->num_extra_bytes < (I32)number_of_extra_bytes))
+  {
+    number_of_short_records++;
+    return;
+  }
+  for (U32 i = 0; i < number_of_kernels; i++)
+  {
+    kernel_attributes[i]->kernel(kernel_attributes[i], laspoint->extra_bytes);
+  }
+}
+
+I32 EXTRABYTEScheck::format_value(CHAR* string, const EXTRABYTESattribute* attribute, const U64I64F64 value) const
+{
+  if (attribute->options & (EXTRABYTESCHECK_OPTION_SCALE | EXTRABYTESCHECK_OPTION_OFFSET))
+  {
+    F64 scale = ((attribute->options & EXTRABYTESCHECK_OPTION_SCALE) ? attribute->scale : 1.0);
+    F64 offset = ((attribute->options & EXTRABYTESCHECK_OPTION_OFFSET) ? attribute->offset : 0.0);
+    F64 unscaled = (is_float(attribute->data_type) ? value.f64 : (is_unsigned(attribute->data_type) ? (F64)value.u64 : (F64)value.i64));
+    return sprintf(string, "%.10g", scale*unscaled + offset);
+  }
+  if (is_float(attribute->data_type))
+  {
+    return sprintf(string, "%.10g", value.f64);
+  }
+  else if (is_unsigned(attribute->data_type))
+  {
+#ifdef _WIN32
+    return sprintf(string, "%I64u", value.u64);
+#else
+    return sprintf(string, "%llu", value.u64);
+#endif
+  }
+#ifdef _WIN32
+  return sprintf(string, "%I64d", value.i64);
+#else
+  return sprintf(string, "%lld", value.i64);
+#endif
+}
+
+void EXTRABYTEScheck::check(LASheader* lasheader)
+{
+  CHAR note[512];
+  CHAR string[64];
+  U32 i;
+
+  // check the descriptors
+
+  if (descriptor_payload_size % EXTRABYTESCHECK_DESCRIPTOR_SIZE)
+  {
+#ifdef _WIN32
+    sprintf(note, "payload of Extra Bytes VLR is %I64d bytes which is not a multiple of %d", descriptor_payload_size, EXTRABYTESCHECK_DESCRIPTOR_SIZE);
+#else
+    sprintf(note, "payload of Extra Bytes VLR is %lld bytes which is not a multiple of %d", descriptor_payload_size, EXTRABYTESCHECK_DESCRIPTOR_SIZE);
+#endif
+    lasheader->add_fail("extra bytes", note);
+  }
+
+  for (i = 0; i < number_of_attributes; i++)
+  {
+    const EXTRABYTESattribute* attribute = &attributes[i];
+    if (attribute->data_type > 30)
+    {
+      sprintf(note, "attribute %u '%s' has unknown data type %d", i, attribute->name, attribute->data_type);
+      lasheader->add_fail("extra bytes", note);
+    }
+    else if (attribute->data_type > 10)
+    {
+      sprintf(note, "attribute %u '%s' has deprecated data type %d", i, attribute->name, attribute->data_type);
+      lasheader->add_warning("extra bytes", note);
+    }
+    else if ((attribute->data_type == 0) && (attribute->size == 0))
+    {
+      sprintf(note, "attribute %u '%s' of undocumented bytes has a size of zero in its options", i, attribute->name);
+      lasheader->add_fail("extra bytes", note);
+    }
+    if ((attribute->data_type >= 1) && (attribute->data_type <= 10))
+    {
+      if ((attribute->options & EXTRABYTESCHECK_OPTION_SCALE) && (attribute->scale == 0.0))
+      {
+        sprintf(note, "attribute %u '%s' has a scale of zero", i, attribute->name);
+        lasheader->add_fail("extra bytes", note);
+      }
+      if ((attribute->options & EXTRABYTESCHECK_OPTION_MIN) && (attribute->options & EXTRABYTESCHECK_OPTION_MAX))
+      {
+        BOOL inverted;
+        if (is_float(attribute->data_type)) inverted = (attribute->min.f64 > attribute->max.f64);
+        else if (is_unsigned(attribute->data_type)) inverted = (attribute->min.u64 > attribute->max.u64);
+        else inverted = (attribute->min.i64 > attribute->max.i64);
+        if (inverted)
+        {
+          sprintf(note, "attribute %u '%s' has a min that is larger than its max", i, attribute->name);
+          lasheader->add_fail("extra bytes", note);
+        }
+      }
+    }
+  }
+
+  // check the descriptors against the record length
+
+  if (number_of_described_bytes > number_of_extra_bytes)
+  {
+    sprintf(note, "descriptors describe %u bytes but point records have only %u extra bytes", number_of_described_bytes, number_of_extra_bytes);
+    lasheader->add_fail("extra bytes", note);
+  }
+  else if ((number_of_attributes == 0) && number_of_extra_bytes)
+  {
+    sprintf(note, "%u extra bytes per point record are not described by an Extra Bytes VLR", number_of_extra_bytes);
+    lasheader->add_warning("extra bytes", note);
+  }
+  else if (number_of_described_bytes < number_of_extra_bytes)
+  {
+    sprintf(note, "only %u of the %u extra bytes per point record are described", number_of_described_bytes, number_of_extra_bytes);
+    lasheader->add_warning("extra bytes", note);
+  }
+
+  if (number_of_short_records)
+  {
+#ifdef _WIN32
+    sprintf(note, "%I64d point records have fewer than %u extra bytes", number_of_short_records, number_of_extra_bytes);
+#else
+    sprintf(note, "%lld point records have fewer than %u extra bytes", number_of_short_records, number_of_extra_bytes);
+#endif
+    lasheader->add_warning("extra bytes", note);
+  }
+
+  // check the values against the descriptors
+
+  for (i = 0; i < number_of_kernels; i++)
+  {
+    const EXTRABYTESattribute* attribute = kernel_attributes[i];
+    if (attribute->number_below_min)
+    {
+      format_value(string, attribute, attribute->min);
+#ifdef _WIN32
+      sprintf(note, "%I64d values of attribute '%s' are below the min of %s in its descriptor", attribute->number_below_min, attribute->name, string);
+#else
+      sprintf(note, "%lld values of attribute '%s' are below the min of %s in its descriptor", attribute->number_below_min, attribute->name, string);
+#endif
+      lasheader->add_warning("extra bytes", note);
+    }
+    if (attribute->number_above_max)
+    {
+      format_value(string, attribute, attribute->max);
+#ifdef _WIN32
+      sprintf(note, "%I64d values of attribute '%s' are above the max of %s in its descriptor", attribute->number_above_max, attribute->name, string);
+#else
+      sprintf(note, "%lld values of attribute '%s' are above the max of %s in its descriptor", attribute->number_above_max, attribute->name, string);
+#endif
+      lasheader->add_warning("extra bytes", note);
+    }
+    if ((attribute->number_of_values == 0) && attribute->number_of_no_data)
+    {
+#ifdef _WIN32
+      sprintf(note, "all %I64d values of attribute '%s' are no_data", attribute->number_of_no_data, attribute->name);
+#else
+      sprintf(note, "all %lld values of attribute '%s' are no_data", attribute->number_of_no_data, attribute->name);
+#endif
+      lasheader->add_warning("extra bytes", note);
+    }
+  }
+}
+
+// one 'extra_bytes' entry per scanned attribute with its range and no_data count
+
+void EXTRABYTEScheck::write_statistics(XMLwriter* xmlwriter) const
+{
+  CHAR value[512];
+
+  for (U32 i = 0; i < number_of_kernels; i++)
+  {
+    const EXTRABYTESattribute* attribute = kernel_attributes[i];
+    I32 len = sprintf(value, "%s (%s):", attribute->name, data_type_names[attribute->data_type]);
+    if (attribute->number_of_values)
+    {
+      len += sprintf(&value[len], " min ");
+      len += format_value(&value[len], attribute, attribute->value_min);
+      len += sprintf(&value[len], " max ");
+      len += format_value(&value[len], attribute, attribute->value_max);
+    }
+#ifdef _WIN32
+    sprintf(&value[len], " no_data %I64d", attribute->number_of_no_data);
+#else
+    sprintf(&value[len], " no_data %lld", attribute->number_of_no_data);
+#endif
+    xmlwriter->write("extra_bytes", value);
+  }
+}
+
+EXTRABYTEScheck::EXTRABYTEScheck(const LASheader* lasheader)
+{
+  U32 i;
+
+  number_of_extra_bytes = 0;
+  if ((lasheader->point_data_format <= 10) && (lasheader->point_data_record_length > standard_record_length[lasheader->point_data_format]))
+  {
+    number_of_extra_bytes = lasheader->point_data_record_length - standard_record_length[lasheader->point_data_format];
+  }
+  number_of_described_bytes = 0;
+  descriptor_payload_size = 0;
+  number_of_attributes = 0;
+  attributes = 0;
+  number_of_kernels = 0;
+  kernel_attributes = 0;
+  number_of_short_records = 0;
+
+  // the descriptors come from the Extra Bytes VLR or EVLR or from those parsed by the reader
+
+  for (i = 0; i < lasheader->number_of_variable_length_records; i++)
+  {
+    if ((strncmp(lasheader->vlrs[i].user_id, "LASF_Spec", 16) == 0) && (lasheader->vlrs[i].record_id == 4) && lasheader->vlrs[i].data)
+    {
+      descriptor_payload_size = lasheader->vlrs[i].record_length_after_header;
+      parse_descriptors(lasheader->vlrs[i].data, (U32)(descriptor_payload_size / EXTRABYTESCHECK_DESCRIPTOR_SIZE));
+      return;
+    }
+  }
+  if (lasheader->evlrs)
+  {
+    for (i = 0; i < lasheader->number_of_extended_variable_length_records; i++)
+    {
+      if ((strncmp(lasheader->evlrs[i].user_id, "LASF_Spec", 16) == 0) && (lasheader->evlrs[i].record_id == 4) && lasheader->evlrs[i].data)
+      {
+        descriptor_payload_size = lasheader->evlrs[i].record_length_after_header;
+        parse_descriptors(lasheader->evlrs[i].data, (U32)(descriptor_payload_size / EXTRABYTESCHECK_DESCRIPTOR_SIZE));
+        return;
+      }
+    }
+  }
+  if (lasheader->number_attributes && lasheader->attributes)
+  {
+    descriptor_payload_size = (I64)lasheader->number_attributes * EXTRABYTESCHECK_DESCRIPTOR_SIZE;
+    parse_descriptors((const U8*)lasheader->attributes, lasheader->number_attributes);
+  }
+}
+
+EXTRABYTEScheck::~EXTRABYTEScheck()
+{
+  if (attributes) free(attributes);
+  if (kernel_attributes) free(kernel_attributes);
+}
@@ -0,0 +1,114 @@
+/*
+===============================================================================
+
+  FILE:  extrabytescheck.hpp
+
+  CONTENTS:
+
+    Checks the extra bytes that follow the standard fields of each point record
+    against their descriptors in the Extra Bytes VLR (or EVLR) of the header.
+    The descriptors must be well formed and describe no more bytes than the
+    point records have. The values of every described attribute are scanned
+    for their range, their no_data count, and violations of the min and max
+    given in the descriptor. Each attribute is scanned by a kernel that is
+    instantiated for its data type at compile time and selected once when
+    the descriptors are parsed, so there is no switch on the type per value.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    19 October 2026 -- created for validating extra bytes and their descriptors
+
+===============================================================================
+*/
+#ifndef EXTRA_BYTES_CHECK_HPP
+#define EXTRA_BYTES_CHECK_HPP
+
+#include "lasheader.hpp"
+#include "laspoint.hpp"
+
+#include "xmlwriter.hpp"
+
+#define EXTRABYTESCHECK_DESCRIPTOR_SIZE 192
+
+#define EXTRABYTESCHECK_OPTION_NO_DATA 0x01
+#define EXTRABYTESCHECK_OPTION_MIN     0x02
+#define EXTRABYTESCHECK_OPTION_MAX     0x04
+#define EXTRABYTESCHECK_OPTION_SCALE   0x08
+#define EXTRABYTESCHECK_OPTION_OFFSET  0x10
+
+class EXTRABYTESattribute;
+
+typedef void (*EXTRABYTESkernel)(EXTRABYTESattribute* attribute, const U8* extra_bytes);
+
+class EXTRABYTESattribute
+{
+public:
+  U8 data_type;
+  U8 options;
+  CHAR name[33];
+  U32 start;
+  U32 size;
+
+  // descriptor fields as u64 for unsigned, i64 for signed, and f64 for floating point types
+
+  U64I64F64 no_data;
+  U64I64F64 min;
+  U64I64F64 max;
+  F64 scale;
+  F64 offset;
+
+  // NULL for undocumented bytes, deprecated tuples, and attributes beyond the record
+
+  EXTRABYTESkernel kernel;
+
+  // the results
+
+  I64 number_of_values;
+  I64 number_of_no_data;
+  I64 number_below_min;
+  I64 number_above_max;
+  U64I64F64 value_min;
+  U64I64F64 value_max;
+};
+
+class EXTRABYTEScheck
+{
+public:
+
+  BOOL has_extra_bytes() const;
+  void parse(const LASpoint* laspoint);
+  void check(LASheader* lasheader);
+  void write_statistics(XMLwriter* xmlwriter) const;
+
+  EXTRABYTEScheck(const LASheader* lasheader);
+  ~EXTRABYTEScheck();
+
+private:
+  U32 number_of_extra_bytes;
+  U32 number_of_described_bytes;
+  I64 descriptor_payload_size;
+  U32 number_of_attributes;
+  EXTRABYTESattribute* attributes;
+  U32 number_of_kernels;
+  EXTRABYTESattribute** kernel_attributes;
+  I64 number_of_short_records;
+  void parse_descriptors(const U8* data, const U32 number_of_descriptors);
+  I32 format_value(CHAR* string, const EXTRABYTESattribute* attribute, const U64I64F64 value) const;
+};
+
+#endif
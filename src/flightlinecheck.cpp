@@ -0,0 +1,141 @@
+/*
+===============================================================================
+
+  FILE:  flightlinecheck.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "flightlinecheck.hpp"
+#include "checkutility.hpp"
+
+void FLIGHTLINEcheck::parse(const LASpoint* laspoint)
+{
+  U32 page = (laspoint->point_source_ID >> 8);
+  if (pages[page] == 0)
+  {
+    pages[page] = (FLIGHTLINEentry*)calloc(FLIGHTLINECHECK_PAGE_SIZE, sizeof(FLIGHTLINEentry));
+    if (pages[page] == 0)
+    {
+      return;
+    }
+  }
+  FLIGHTLINEentry* entry = &(pages[page][laspoint->point_source_ID & 255]);
+  if (entry->number_of_points == 0)
+  {
+    entry->min_X = entry->max_X = laspoint->X;
+    entry->min_Y = entry->max_Y = laspoint->Y;
+    entry->min_Z = entry->max_Z = laspoint->Z;
+    entry->min_gps_time = entry->max_gps_time = laspoint->gps_time;
+    number_of_flightlines++;
+  }
+  else
+  {
+    if (laspoint->X < entry->min_X) entry->min_X = laspoint->X;
+    else if (laspoint->X > entry->max_X) entry->max_X = laspoint->X;
+    if (laspoint->Y < entry->min_Y) entry->min_Y = laspoint->Y;
+    else if (laspoint->Y > entry->max_Y) entry->max_Y = laspoint->Y;
+    if (laspoint->Z < entry->min_Z) entry->min_Z = laspoint->Z;
+    else if (laspoint->Z > entry->max_Z) entry->max_Z = laspoint->Z;
+    if (laspoint->gps_time < entry->min_gps_time) entry->min_gps_time = laspoint->gps_time;
+    else if (laspoint->gps_time > entry->max_gps_time) entry->max_gps_time = laspoint->gps_time;
+  }
+  entry->number_of_points++;
+  entry->intensity_sum += laspoint->intensity;
+}
+
+// one 'flightline' entry per point source ID in increasing order
+
+void FLIGHTLINEcheck::write_statistics(XMLwriter* xmlwriter) const
+{
+  CHAR value[512];
+
+  if (number_of_flightlines == 0)
+  {
+    return;
+  }
+
+  I32 digits_x = decimal_digits(x_scale_factor);
+  I32 digits_y = decimal_digits(y_scale_factor);
+  I32 digits_z = decimal_digits(z_scale_factor);
+
+  xmlwriter->write("number_of_flightlines", (I32)number_of_flightlines);
+  for (U32 page = 0; page < FLIGHTLINECHECK_PAGES; page++)
+  {
+    if (pages[page] == 0)
+    {
+      continue;
+    }
+    for (U32 i = 0; i < FLIGHTLINECHECK_PAGE_SIZE; i++)
+    {
+      const FLIGHTLINEentry* entry = &(pages[page][i]);
+      if (entry->number_of_points == 0)
+      {
+        continue;
+      }
+#ifdef _WIN32
+      I32 len = sprintf(value, "point source ID %u: %I64d points", (page << 8) | i, entry->number_of_points);
+#else
+      I32 len = sprintf(value, "point source ID %u: %lld points", (page << 8) | i, entry->number_of_points);
+#endif
+      len += sprintf(&value[len], ", x %.*f to %.*f, y %.*f to %.*f, z %.*f to %.*f",
+        digits_x, x_scale_factor*entry->min_X + x_offset, digits_x, x_scale_factor*entry->max_X + x_offset,
+        digits_y, y_scale_factor*entry->min_Y + y_offset, digits_y, y_scale_factor*entry->max_Y + y_offset,
+        digits_z, z_scale_factor*entry->min_Z + z_offset, digits_z, z_scale_factor*entry->max_Z + z_offset);
+      if (has_gps_time)
+      {
+        len += sprintf(&value[len], ", GPS time %.6f to %.6f", entry->min_gps_time, entry->max_gps_time);
+      }
+      sprintf(&value[len], ", mean intensity %.1f", (F64)entry->intensity_sum / entry->number_of_points);
+      xmlwriter->write("flightline", value);
+    }
+  }
+}
+
+FLIGHTLINEcheck::FLIGHTLINEcheck(const LASheader* lasheader)
+{
+  has_gps_time = format_has_gps_time(lasheader->point_data_format);
+  x_scale_factor = lasheader->x_scale_factor;
+  y_scale_factor = lasheader->y_scale_factor;
+  z_scale_factor = lasheader->z_scale_factor;
+  x_offset = lasheader->x_offset;
+  y_offset = lasheader->y_offset;
+  z_offset = lasheader->z_offset;
+  number_of_flightlines = 0;
+  memset(pages, 0, sizeof(pages));
+}
+
+FLIGHTLINEcheck::~FLIGHTLINEcheck()
+{
+  for (U32 page = 0; page < FLIGHTLINECHECK_PAGES; page++)
+  {
+    if (pages[page]) free(pages[page]);
+  }
+}
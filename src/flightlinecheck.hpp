@@ -0,0 +1,76 @@
+/*
+===============================================================================
+
+  FILE:  flightlinecheck.hpp
+
+  CONTENTS:
+
+    Collects an inventory of the flight lines in a file: the number of points,
+    the bounding box, the GPS time range, and the mean intensity for each of
+    the point source IDs. The entries live in a dense table that is indexed
+    directly with the 16 bit point source ID. The table is split into 256
+    pages of 256 entries that are only allocated once a point source ID of
+    that page occurs, so a file with a few flight lines costs a few pages.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    19 October 2026 -- created for swath QA without a separate pass over the points
+
+===============================================================================
+*/
+#ifndef FLIGHTLINE_CHECK_HPP
+#define FLIGHTLINE_CHECK_HPP
+
+#include "lasheader.hpp"
+#include "laspoint.hpp"
+
+#include "xmlwriter.hpp"
+
+#define FLIGHTLINECHECK_PAGES 256
+#define FLIGHTLINECHECK_PAGE_SIZE 256
+
+class FLIGHTLINEentry
+{
+public:
+  I64 number_of_points;
+  I64 intensity_sum;
+  I32 min_X, min_Y, min_Z;
+  I32 max_X, max_Y, max_Z;
+  F64 min_gps_time;
+  F64 max_gps_time;
+};
+
+class FLIGHTLINEcheck
+{
+public:
+
+  void parse(const LASpoint* laspoint);
+  void write_statistics(XMLwriter* xmlwriter) const;
+
+  FLIGHTLINEcheck(const LASheader* lasheader);
+  ~FLIGHTLINEcheck();
+
+private:
+  BOOL has_gps_time;
+  F64 x_scale_factor, y_scale_factor, z_scale_factor;
+  F64 x_offset, y_offset, z_offset;
+  U32 number_of_flightlines;
+  FLIGHTLINEentry* pages[FLIGHTLINECHECK_PAGES];
+};
+
+#endif
@@ -0,0 +1,242 @@
+/*
+===============================================================================
+
+  FILE:  gpstimecheck.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "gpstimecheck.hpp"
+
+GPStimesource* GPStimecheck::get_source(const U16 point_source_ID)
+{
+  // points of one flight line usually come in long runs
+
+  if ((last_source < number_of_sources) && (sources[last_source].point_source_ID == point_source_ID))
+  {
+    return &(sources[last_source]);
+  }
+
+  // binary search in the sources sorted by point source ID
+
+  U32 lo = 0;
+  U32 hi = number_of_sources;
+  while (lo < hi)
+  {
+    U32 mid = (lo + hi) / 2;
+    if (sources[mid].point_source_ID < point_source_ID)
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+
+  if ((lo == number_of_sources) || (sources[lo].point_source_ID != point_source_ID))
+  {
+    // insert a new source
+
+    if (number_of_sources == allocated_sources)
+    {
+      allocated_sources = (allocated_sources ? 2*allocated_sources : 16);
+      sources = (GPStimesource*)realloc(sources, sizeof(GPStimesource)*allocated_sources);
+    }
+    if (lo < number_of_sources)
+    {
+      memmove(&(sources[lo+1]), &(sources[lo]), sizeof(GPStimesource)*(number_of_sources-lo));
+    }
+    number_of_sources++;
+    memset(&(sources[lo]), 0, sizeof(GPStimesource));
+    sources[lo].point_source_ID = point_source_ID;
+  }
+
+  last_source = lo;
+  return &(sources[lo]);
+}
+
+void GPStimecheck::parse(const LASpoint* laspoint)
+{
+  GPStimesource* source = get_source(laspoint->point_source_ID);
+
+  F64 gps_time = laspoint->gps_time;
+  I64 second = (I64)floor(gps_time);
+  BOOL pulse = ((laspoint->extended_point_type ? laspoint->extended_return_number : laspoint->return_number) <= 1);
+
+  if (source->number_of_points == 0)
+  {
+    source->first_gps_time = gps_time;
+    source->min_gps_time = gps_time;
+    source->max_gps_time = gps_time;
+    source->current_second = second;
+    source->current_second_full = FALSE;
+  }
+  else
+  {
+    F64 step = gps_time - source->last_gps_time;
+    if (step < 0.0)
+    {
+      // the time runs backwards
+
+      source->number_of_steps_back++;
+      if (-step > source->largest_step_back)
+      {
+        source->largest_step_back = -step;
+      }
+    }
+    else if (step > gap)
+    {
+      // the scanner stopped recording
+
+      source->number_of_gaps++;
+      source->total_gap_time += step;
+      if (step > source->largest_gap)
+      {
+        source->largest_gap = step;
+        source->largest_gap_start = source->last_gps_time;
+      }
+    }
+
+    if (second != source->current_second)
+    {
+      // the second just finished only counts if it was recorded from beginning to end
+
+      if ((step >= 0.0) && (step <= gap))
+      {
+        if (source->current_second_full)
+        {
+          if ((source->number_of_full_seconds == 0) || (source->current_second_pulses < source->min_pulses_per_second))
+          {
+            source->min_pulses_per_second = source->current_second_pulses;
+            source->min_pulses_per_second_start = (F64)source->current_second;
+          }
+          if (source->current_second_pulses > source->max_pulses_per_second)
+          {
+            source->max_pulses_per_second = source->current_second_pulses;
+          }
+          source->number_of_full_seconds++;
+        }
+
+        // seconds that were skipped without a gap had no pulses at all
+
+        if (second > (source->current_second + 1))
+        {
+          source->min_pulses_per_second = 0;
+          source->min_pulses_per_second_start = (F64)(source->current_second + 1);
+          source->number_of_full_seconds += (U32)(second - source->current_second - 1);
+        }
+        source->current_second_full = TRUE;
+      }
+      else
+      {
+        source->current_second_full = FALSE;
+      }
+      source->current_second = second;
+      source->current_second_pulses = 0;
+    }
+    else if ((step < 0.0) || (step > gap))
+    {
+      source->current_second_full = FALSE;
+    }
+
+    if (gps_time < source->min_gps_time) source->min_gps_time = gps_time;
+    else if (gps_time > source->max_gps_time) source->max_gps_time = gps_time;
+  }
+
+  source->last_gps_time = gps_time;
+  source->number_of_points++;
+  if (pulse)
+  {
+    source->number_of_pulses++;
+    source->current_second_pulses++;
+  }
+}
+
+void GPStimecheck::check(LASheader* lasheader)
+{
+  CHAR note[512];
+
+  for (U32 i = 0; i < number_of_sources; i++)
+  {
+    GPStimesource* source = &(sources[i]);
+
+    // are the time stamps of the flight line in increasing order
+
+    if (source->number_of_steps_back)
+    {
+#ifdef _WIN32
+      sprintf(note, "point source ID %d: %I64d of %I64d points have a smaller time stamp than the point before (largest step back is %g sec)", (I32)source->point_source_ID, source->number_of_steps_back, source->number_of_points, source->largest_step_back);
+#else
+      sprintf(note, "point source ID %d: %lld of %lld points have a smaller time stamp than the point before (largest step back is %g sec)", (I32)source->point_source_ID, source->number_of_steps_back, source->number_of_points, source->largest_step_back);
+#endif
+      lasheader->add_warning("GPS time", note);
+    }
+
+    // did the scanner stop recording during the flight line
+
+    if (source->number_of_gaps)
+    {
+#ifdef _WIN32
+      sprintf(note, "point source ID %d: %I64d gaps of more than %g sec in the time stamps totalling %g sec (longest is %g sec after %.6f)", (I32)source->point_source_ID, source->number_of_gaps, gap, source->total_gap_time, source->largest_gap, source->largest_gap_start);
+#else
+      sprintf(note, "point source ID %d: %lld gaps of more than %g sec in the time stamps totalling %g sec (longest is %g sec after %.6f)", (I32)source->point_source_ID, source->number_of_gaps, gap, source->total_gap_time, source->largest_gap, source->largest_gap_start);
+#endif
+      lasheader->add_warning("GPS time", note);
+    }
+
+    // did the pulse rate drop to less than half of the average
+
+    if ((source->number_of_steps_back == 0) && (source->max_gps_time > source->min_gps_time) && (source->number_of_full_seconds > 1))
+    {
+      F64 pulses_per_second = source->number_of_pulses / (source->max_gps_time - source->min_gps_time - source->total_gap_time);
+      if (source->min_pulses_per_second < 0.5*pulses_per_second)
+      {
+        sprintf(note, "point source ID %d: pulse rate drops to %u pulses per sec in second %.0f (average is %.0f and maximum is %u)", (I32)source->point_source_ID, source->min_pulses_per_second, source->min_pulses_per_second_start, pulses_per_second, source->max_pulses_per_second);
+        lasheader->add_warning("GPS time", note);
+      }
+    }
+  }
+}
+
+GPStimecheck::GPStimecheck(const F64 gap)
+{
+  this->gap = gap;
+  number_of_sources = 0;
+  allocated_sources = 0;
+  last_source = 0;
+  sources = 0;
+}
+
+GPStimecheck::~GPStimecheck()
+{
+  if (sources) free(sources);
+}
@@ -0,0 +1,93 @@
+/*
+===============================================================================
+
+  FILE:  gpstimecheck.hpp
+
+  CONTENTS:
+
+    Checks in one pass whether the GPS time stamps of each flight line (the
+    points sharing one point source ID) are increasing, where the scanner
+    stopped recording for longer than a given gap, and how the pulse rate
+    varies from second to second. Memory is one entry per point source ID.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    19 October 2026 -- created to find sensor dropouts without sorting by time
+
+===============================================================================
+*/
+#ifndef GPS_TIME_CHECK_HPP
+#define GPS_TIME_CHECK_HPP
+
+#include "lasheader.hpp"
+#include "laspoint.hpp"
+
+class GPStimesource
+{
+public:
+  U16 point_source_ID;
+  I64 number_of_points;
+  I64 number_of_pulses;
+  F64 first_gps_time;
+  F64 last_gps_time;
+  F64 min_gps_time;
+  F64 max_gps_time;
+
+  // time stamps that are smaller than the one before
+
+  I64 number_of_steps_back;
+  F64 largest_step_back;
+
+  // time stamps that follow the one before by more than the gap
+
+  I64 number_of_gaps;
+  F64 total_gap_time;
+  F64 largest_gap;
+  F64 largest_gap_start;
+
+  // pulses per full second of recording (seconds cut by a gap or a step back are not full)
+
+  I64 current_second;
+  BOOL current_second_full;
+  U32 current_second_pulses;
+  U32 number_of_full_seconds;
+  U32 min_pulses_per_second;
+  U32 max_pulses_per_second;
+  F64 min_pulses_per_second_start;
+};
+
+class GPStimecheck
+{
+public:
+
+  void parse(const LASpoint* laspoint);
+  void check(LASheader* lasheader);
+
+  GPStimecheck(const F64 gap);
+  ~GPStimecheck();
+
+private:
+  F64 gap;
+  U32 number_of_sources;
+  U32 allocated_sources;
+  U32 last_source;
+  GPStimesource* sources;
+  GPStimesource* get_source(const U16 point_source_ID);
+};
+
+#endif
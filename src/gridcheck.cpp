@@ -0,0 +1,405 @@
+/*
+===============================================================================
+
+  FILE:  gridcheck.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "gridcheck.hpp"
+
+// a run of uncovered cells between two covered cells of one row
+
+class GRIDrun
+{
+public:
+  I32 row;
+  I32 start, end;
+  U32 parent;
+  BOOL outside;
+};
+
+class GRIDrow
+{
+public:
+  I32 row;
+  I32 first_col, last_col;
+  U32 first_run, number_of_runs;
+};
+
+static U32 hash_cell(const I32 col, const I32 row)
+{
+  U32 h = ((U32)col) * 0x9E3779B1 + ((U32)row) * 0x85EBCA77;
+  h ^= h >> 15;
+  h *= 0x2C1B3C6D;
+  h ^= h >> 12;
+  return h;
+}
+
+static int compare_cells(const void* a, const void* b)
+{
+  const GRIDcell* cell_a = (const GRIDcell*)a;
+  const GRIDcell* cell_b = (const GRIDcell*)b;
+  if (cell_a->row != cell_b->row) return (cell_a->row < cell_b->row ? -1 : 1);
+  if (cell_a->col != cell_b->col) return (cell_a->col < cell_b->col ? -1 : 1);
+  return 0;
+}
+
+static U32 find_root(GRIDrun* runs, U32 i)
+{
+  while (runs[i].parent != i)
+  {
+    runs[i].parent = runs[runs[i].parent].parent;
+    i = runs[i].parent;
+  }
+  return i;
+}
+
+static void unite(GRIDrun* runs, U32 i, U32 j)
+{
+  i = find_root(runs, i);
+  j = find_root(runs, j);
+  if (i < j) runs[j].parent = i;
+  else if (j < i) runs[i].parent = j;
+}
+
+BOOL GRIDcheck::get_cell(const LASheader* lasheader, const F64 tile_size, const F64 origin_x, const F64 origin_y, I32* col, I32* row)
+{
+  // points on the upper and right border of a cell still belong to it
+
+  F64 min_x = lasheader->min_x + 0.5*lasheader->x_scale_factor;
+  F64 min_y = lasheader->min_y + 0.5*lasheader->y_scale_factor;
+  F64 max_x = lasheader->max_x - 0.5*lasheader->x_scale_factor;
+  F64 max_y = lasheader->max_y - 0.5*lasheader->y_scale_factor;
+  if (max_x < min_x) max_x = min_x = (lasheader->min_x + lasheader->max_x)/2;
+  if (max_y < min_y) max_y = min_y = (lasheader->min_y + lasheader->max_y)/2;
+
+  F64 min_col = floor((min_x - origin_x)/tile_size);
+  F64 min_row = floor((min_y - origin_y)/tile_size);
+  F64 max_col = floor((max_x - origin_x)/tile_size);
+  F64 max_row = floor((max_y - origin_y)/tile_size);
+
+  // the cell of the center is used when the box spans several cells
+
+  F64 center_col = floor(((min_x + max_x)/2 - origin_x)/tile_size);
+  F64 center_row = floor(((min_y + max_y)/2 - origin_y)/tile_size);
+
+  if (!(center_col > I32_MIN) || !(center_col <= I32_MAX) || !(center_row > I32_MIN) || !(center_row <= I32_MAX))
+  {
+    *col = *row = I32_MIN;
+    return FALSE;
+  }
+
+  *col = (I32)center_col;
+  *row = (I32)center_row;
+  return ((min_col == max_col) && (min_row == max_row));
+}
+
+GRIDcell* GRIDcheck::find_cell(const I32 col, const I32 row)
+{
+  U32 mask = cells_capacity - 1;
+  U32 slot = hash_cell(col, row) & mask;
+  while (cells[slot].count && ((cells[slot].col != col) || (cells[slot].row != row)))
+  {
+    slot = (slot + 1) & mask;
+  }
+  return &(cells[slot]);
+}
+
+void GRIDcheck::grow_cells()
+{
+  GRIDcell* old_cells = cells;
+  U32 old_capacity = cells_capacity;
+  cells_capacity = (cells_capacity ? 2*cells_capacity : 1024);
+  cells = (GRIDcell*)calloc(cells_capacity, sizeof(GRIDcell));
+  for (U32 i = 0; i < old_capacity; i++)
+  {
+    if (old_cells[i].count)
+    {
+      *find_cell(old_cells[i].col, old_cells[i].row) = old_cells[i];
+    }
+  }
+  if (old_cells) free(old_cells);
+}
+
+void GRIDcheck::add(const CHAR* file_name, const LASheader* lasheader)
+{
+  I32 col, row;
+
+  if (!(lasheader->min_x <= lasheader->max_x) || !(lasheader->min_y <= lasheader->max_y))
+  {
+    return;
+  }
+
+  if (number_of_files == allocated_files)
+  {
+    allocated_files = (allocated_files ? 2*allocated_files : 256);
+    file_names = (CHAR**)realloc(file_names, sizeof(CHAR*)*allocated_files);
+  }
+  file_names[number_of_files] = (CHAR*)malloc(strlen(file_name) + 1);
+  strcpy(file_names[number_of_files], file_name);
+
+  if (!get_cell(lasheader, tile_size, origin_x, origin_y, &col, &row))
+  {
+    if (number_of_misfit_samples < GRIDCHECK_SAMPLES)
+    {
+      misfit_samples[number_of_misfit_samples++] = number_of_files;
+    }
+    number_of_misfits++;
+  }
+
+  if ((col != I32_MIN) && (row != I32_MIN))
+  {
+    if (2*(number_of_cells + 1) > cells_capacity)
+    {
+      grow_cells();
+    }
+    GRIDcell* cell = find_cell(col, row);
+    if (cell->count == 0)
+    {
+      cell->col = col;
+      cell->row = row;
+      cell->file1 = number_of_files;
+      number_of_cells++;
+    }
+    else if (cell->count == 1)
+    {
+      cell->file2 = number_of_files;
+    }
+    cell->count++;
+  }
+
+  number_of_files++;
+}
+
+void GRIDcheck::check_missing()
+{
+  U32 i, j, k;
+
+  // the covered cells sorted by row and column
+
+  GRIDcell* sorted = (GRIDcell*)malloc(sizeof(GRIDcell)*number_of_cells);
+  for (i = 0, j = 0; i < cells_capacity; i++)
+  {
+    if (cells[i].count) sorted[j++] = cells[i];
+  }
+  qsort(sorted, number_of_cells, sizeof(GRIDcell), compare_cells);
+
+  // the rows with their runs of uncovered cells between covered cells
+
+  U32 number_of_rows = 0;
+  U32 number_of_runs = 0;
+  GRIDrow* rows = (GRIDrow*)malloc(sizeof(GRIDrow)*number_of_cells);
+  GRIDrun* runs = (GRIDrun*)malloc(sizeof(GRIDrun)*number_of_cells);
+  for (i = 0; i < number_of_cells; i++)
+  {
+    if ((i == 0) || (sorted[i].row != sorted[i-1].row))
+    {
+      rows[number_of_rows].row = sorted[i].row;
+      rows[number_of_rows].first_col = sorted[i].col;
+      rows[number_of_rows].first_run = number_of_runs;
+      rows[number_of_rows].number_of_runs = 0;
+      number_of_rows++;
+    }
+    else if (sorted[i].col > (sorted[i-1].col + 1))
+    {
+      runs[number_of_runs].row = sorted[i].row;
+      runs[number_of_runs].start = sorted[i-1].col + 1;
+      runs[number_of_runs].end = sorted[i].col - 1;
+      runs[number_of_runs].parent = number_of_runs;
+      runs[number_of_runs].outside = FALSE;
+      number_of_runs++;
+      rows[number_of_rows-1].number_of_runs++;
+    }
+    rows[number_of_rows-1].last_col = sorted[i].col;
+  }
+  free(sorted);
+
+  // runs reaching past the covered span of the row above or below connect to the outside
+
+  for (k = 0; k < number_of_rows; k++)
+  {
+    GRIDrow* row = &(rows[k]);
+    GRIDrow* below = (((k > 0) && (rows[k-1].row == (row->row - 1))) ? &(rows[k-1]) : 0);
+    GRIDrow* above = (((k+1 < number_of_rows) && (rows[k+1].row == (row->row + 1))) ? &(rows[k+1]) : 0);
+    for (i = row->first_run; i < row->first_run + row->number_of_runs; i++)
+    {
+      if ((below == 0) || (runs[i].start < below->first_col) || (runs[i].end > below->last_col))
+      {
+        runs[i].outside = TRUE;
+      }
+      if ((above == 0) || (runs[i].start < above->first_col) || (runs[i].end > above->last_col))
+      {
+        runs[i].outside = TRUE;
+      }
+    }
+
+    // runs of neighbouring rows that share a column are connected
+
+    if (above)
+    {
+      i = row->first_run;
+      j = above->first_run;
+      while ((i < row->first_run + row->number_of_runs) && (j < above->first_run + above->number_of_runs))
+      {
+        if ((runs[i].start <= runs[j].end) && (runs[j].start <= runs[i].end))
+        {
+          unite(runs, i, j);
+        }
+        if (runs[i].end < runs[j].end) i++;
+        else j++;
+      }
+    }
+  }
+
+  // components without a run that connects to the outside are holes
+
+  for (i = 0; i < number_of_runs; i++)
+  {
+    if (runs[i].outside)
+    {
+      runs[find_root(runs, i)].outside = TRUE;
+    }
+  }
+  U32* hole_cells = (U32*)calloc(number_of_runs, sizeof(U32));
+  for (i = 0; i < number_of_runs; i++)
+  {
+    U32 root = find_root(runs, i);
+    if (!runs[root].outside)
+    {
+      hole_cells[root] += (runs[i].end - runs[i].start + 1);
+      number_of_missing_cells += (runs[i].end - runs[i].start + 1);
+    }
+  }
+  for (i = 0; i < number_of_runs; i++)
+  {
+    if (hole_cells[i])
+    {
+      if (number_of_hole_samples < GRIDCHECK_SAMPLES)
+      {
+        hole_samples[number_of_hole_samples].col = runs[i].start;
+        hole_samples[number_of_hole_samples].row = runs[i].row;
+        hole_samples[number_of_hole_samples].count = hole_cells[i];
+        number_of_hole_samples++;
+      }
+      number_of_holes++;
+    }
+  }
+  free(hole_cells);
+  free(runs);
+  free(rows);
+}
+
+void GRIDcheck::check()
+{
+  for (U32 i = 0; i < cells_capacity; i++)
+  {
+    if (cells[i].count > 1)
+    {
+      if (number_of_shared_samples < GRIDCHECK_SAMPLES)
+      {
+        shared_samples[number_of_shared_samples++] = cells[i];
+      }
+      number_of_shared_cells++;
+    }
+  }
+  if (number_of_cells)
+  {
+    check_missing();
+  }
+}
+
+BOOL GRIDcheck::has_warnings() const
+{
+  return (number_of_misfits || number_of_shared_cells || number_of_missing_cells);
+}
+
+void GRIDcheck::write(XMLwriter* xmlwriter) const
+{
+  U32 i;
+  CHAR note[1024];
+
+  sprintf(note, "%g", tile_size);
+  xmlwriter->write("tile_size", note);
+  xmlwriter->write("tiles", (I32)number_of_files);
+  xmlwriter->write("cells", (I32)number_of_cells);
+  xmlwriter->write("misfits", (I32)number_of_misfits);
+  xmlwriter->write("shared_cells", (I32)number_of_shared_cells);
+  xmlwriter->write("missing_cells", (I32)number_of_missing_cells);
+  xmlwriter->write("holes", (I32)number_of_holes);
+
+  for (i = 0; i < number_of_misfit_samples; i++)
+  {
+    sprintf(note, "bounding box of '%.400s' does not fit into one cell of the grid", file_names[misfit_samples[i]]);
+    xmlwriter->write("tile grid", "warning", note);
+  }
+  for (i = 0; i < number_of_shared_samples; i++)
+  {
+    sprintf(note, "cell at %.2f %.2f is covered by %u files such as '%.400s' and '%.400s'", origin_x + shared_samples[i].col*tile_size, origin_y + shared_samples[i].row*tile_size, shared_samples[i].count, file_names[shared_samples[i].file1], file_names[shared_samples[i].file2]);
+    xmlwriter->write("tile grid", "warning", note);
+  }
+  for (i = 0; i < number_of_hole_samples; i++)
+  {
+    sprintf(note, "%u missing cells enclosed by tiles starting with the cell at %.2f %.2f", hole_samples[i].count, origin_x + hole_samples[i].col*tile_size, origin_y + hole_samples[i].row*tile_size);
+    xmlwriter->write("tile grid", "warning", note);
+  }
+}
+
+GRIDcheck::GRIDcheck(const F64 tile_size, const F64 origin_x, const F64 origin_y)
+{
+  this->tile_size = tile_size;
+  this->origin_x = origin_x;
+  this->origin_y = origin_y;
+  number_of_files = 0;
+  allocated_files = 0;
+  file_names = 0;
+  cells = 0;
+  cells_capacity = 0;
+  number_of_cells = 0;
+  grow_cells();
+  number_of_misfits = 0;
+  number_of_shared_cells = 0;
+  number_of_missing_cells = 0;
+  number_of_holes = 0;
+  number_of_misfit_samples = 0;
+  number_of_shared_samples = 0;
+  number_of_hole_samples = 0;
+}
+
+GRIDcheck::~GRIDcheck()
+{
+  for (U32 i = 0; i < number_of_files; i++)
+  {
+    free(file_names[i]);
+  }
+  if (file_names) free(file_names);
+  if (cells) free(cells);
+}
@@ -0,0 +1,102 @@
+/*
+===============================================================================
+
+  FILE:  gridcheck.hpp
+
+  CONTENTS:
+
+    Checks that the files of a batch conform to a tile grid of a given origin
+    and tile size. Each file is put into the grid cell that contains it using
+    a hash map of cells so memory grows only with the number of tiles and not
+    with the size of the project area. Cells that more than one file covers
+    are reported. Cells that no file covers but that are enclosed by covered
+    cells are reported as missing. They are found by labelling the runs of
+    uncovered cells between covered cells row by row with a union-find.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    19 October 2026 -- created for checking state-wide deliveries against a tile grid
+
+===============================================================================
+*/
+#ifndef GRID_CHECK_HPP
+#define GRID_CHECK_HPP
+
+#include "lasheader.hpp"
+
+#include "xmlwriter.hpp"
+
+#define GRIDCHECK_SAMPLES 10
+
+class GRIDcell
+{
+public:
+  I32 col, row;
+  U32 count;
+  U32 file1, file2;
+};
+
+class GRIDcheck
+{
+public:
+
+  // the cell that contains the bounding box of the header (returns FALSE if it spans more than one)
+
+  static BOOL get_cell(const LASheader* lasheader, const F64 tile_size, const F64 origin_x, const F64 origin_y, I32* col, I32* row);
+
+  void add(const CHAR* file_name, const LASheader* lasheader);
+  void check();
+  BOOL has_warnings() const;
+  void write(XMLwriter* xmlwriter) const;
+
+  GRIDcheck(const F64 tile_size, const F64 origin_x=0.0, const F64 origin_y=0.0);
+  ~GRIDcheck();
+
+private:
+  F64 tile_size;
+  F64 origin_x, origin_y;
+
+  U32 number_of_files;
+  U32 allocated_files;
+  CHAR** file_names;
+
+  // hash map of the covered cells that is at most half full
+
+  GRIDcell* cells;
+  U32 cells_capacity;
+  U32 number_of_cells;
+  GRIDcell* find_cell(const I32 col, const I32 row);
+  void grow_cells();
+
+  void check_missing();
+
+  // the results
+
+  U32 number_of_misfits;
+  U32 number_of_shared_cells;
+  U32 number_of_missing_cells;
+  U32 number_of_holes;
+  U32 number_of_misfit_samples;
+  U32 misfit_samples[GRIDCHECK_SAMPLES];
+  U32 number_of_shared_samples;
+  GRIDcell shared_samples[GRIDCHECK_SAMPLES];
+  U32 number_of_hole_samples;
+  GRIDcell hole_samples[GRIDCHECK_SAMPLES];
+};
+
+#endif
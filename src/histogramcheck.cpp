@@ -0,0 +1,154 @@
+/*
+===============================================================================
+
+  FILE:  histogramcheck.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "histogramcheck.hpp"
+
+void HISTOGRAMcheck::parse(const LASpoint* laspoint)
+{
+  U8 classification, flags, scan_angle, scanner_channel, returns;
+
+  if (laspoint->extended_point_type)
+  {
+    I32 angle = (laspoint->extended_scan_angle >= 0 ? (I32)(0.006f*laspoint->extended_scan_angle + 0.5f) : (I32)(0.006f*laspoint->extended_scan_angle - 0.5f));
+    if (angle < -128) angle = -128;
+    else if (angle > 127) angle = 127;
+    classification = laspoint->extended_classification;
+    flags = laspoint->extended_classification_flags & 0x0F;
+    scan_angle = (U8)(angle + 128);
+    scanner_channel = laspoint->extended_scanner_channel;
+    returns = (laspoint->extended_return_number & 0x0F) | (laspoint->extended_number_of_returns_of_given_pulse << 4);
+  }
+  else
+  {
+    classification = laspoint->classification;
+    flags = (laspoint->synthetic_flag ? HISTOGRAMCHECK_FLAG_SYNTHETIC : 0) | (laspoint->keypoint_flag ? HISTOGRAMCHECK_FLAG_KEYPOINT : 0) | (laspoint->withheld_flag ? HISTOGRAMCHECK_FLAG_WITHHELD : 0);
+    scan_angle = (U8)(laspoint->scan_angle_rank + 128);
+    scanner_channel = 0;
+    returns = (laspoint->return_number & 0x0F) | (laspoint->number_of_returns_of_given_pulse << 4);
+  }
+  if (laspoint->scan_direction_flag) flags |= HISTOGRAMCHECK_FLAG_SCAN_DIRECTION;
+  if (laspoint->edge_of_flight_line) flags |= HISTOGRAMCHECK_FLAG_EDGE;
+
+  totals[HISTOGRAMCHECK_CLASSIFICATION][classification]++;
+  totals[HISTOGRAMCHECK_FLAGS][flags]++;
+  totals[HISTOGRAMCHECK_USER_DATA][laspoint->user_data]++;
+  totals[HISTOGRAMCHECK_SCAN_ANGLE][scan_angle]++;
+  totals[HISTOGRAMCHECK_SCANNER_CHANNEL][scanner_channel]++;
+  totals[HISTOGRAMCHECK_RETURNS][returns]++;
+  number_of_points++;
+}
+
+void HISTOGRAMcheck::write_statistics(XMLwriter* xmlwriter) const
+{
+  U32 b;
+  I32 len;
+  CHAR value[8192];
+
+  if (number_of_points == 0)
+  {
+    return;
+  }
+
+  // the non-empty bins as 'value:count' pairs
+
+  const CHAR* names[4] = { "classification", "user_data", "scan_angle", "scanner_channel" };
+  const U32 attributes[4] = { HISTOGRAMCHECK_CLASSIFICATION, HISTOGRAMCHECK_USER_DATA, HISTOGRAMCHECK_SCAN_ANGLE, HISTOGRAMCHECK_SCANNER_CHANNEL };
+  for (U32 i = 0; i < 4; i++)
+  {
+    len = 0;
+    value[0] = '\0';
+    for (b = 0; b < 256; b++)
+    {
+      if (totals[attributes[i]][b])
+      {
+        I32 bin = (attributes[i] == HISTOGRAMCHECK_SCAN_ANGLE ? (I32)b - 128 : (I32)b);
+#ifdef _WIN32
+        len += sprintf(&value[len], (len ? " %d:%I64d" : "%d:%I64d"), bin, totals[attributes[i]][b]);
+#else
+        len += sprintf(&value[len], (len ? " %d:%lld" : "%d:%lld"), bin, totals[attributes[i]][b]);
+#endif
+      }
+    }
+    xmlwriter->write(names[i], value);
+  }
+
+  // the returns as 'return/returns:count' pairs
+
+  len = 0;
+  value[0] = '\0';
+  for (b = 0; b < 256; b++)
+  {
+    if (totals[HISTOGRAMCHECK_RETURNS][b])
+    {
+#ifdef _WIN32
+      len += sprintf(&value[len], (len ? " %d/%d:%I64d" : "%d/%d:%I64d"), b & 15, b >> 4, totals[HISTOGRAMCHECK_RETURNS][b]);
+#else
+      len += sprintf(&value[len], (len ? " %d/%d:%lld" : "%d/%d:%lld"), b & 15, b >> 4, totals[HISTOGRAMCHECK_RETURNS][b]);
+#endif
+    }
+  }
+  xmlwriter->write("returns", value);
+
+  // the flags separately as count and percentage
+
+  const CHAR* flag_names[6] = { "synthetic", "keypoint", "withheld", "overlap", "scan_direction", "edge_of_flight_line" };
+  for (U32 f = 0; f < 6; f++)
+  {
+    I64 flagged = 0;
+    for (b = 0; b < 256; b++)
+    {
+      if (b & (1 << f))
+      {
+        flagged += totals[HISTOGRAMCHECK_FLAGS][b];
+      }
+    }
+#ifdef _WIN32
+    sprintf(value, "%I64d (%.2f%%)", flagged, 100.0*flagged/number_of_points);
+#else
+    sprintf(value, "%lld (%.2f%%)", flagged, 100.0*flagged/number_of_points);
+#endif
+    xmlwriter->write(flag_names[f], value);
+  }
+}
+
+HISTOGRAMcheck::HISTOGRAMcheck()
+{
+  memset(totals, 0, sizeof(totals));
+  number_of_points = 0;
+}
+
+HISTOGRAMcheck::~HISTOGRAMcheck()
+{
+}
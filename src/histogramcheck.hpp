@@ -0,0 +1,74 @@
+/*
+===============================================================================
+
+  FILE:  histogramcheck.hpp
+
+  CONTENTS:
+
+    Dense histograms with 256 bins for the 8 bit attributes of the points:
+    classification, user data, scan angle, scanner channel, return number
+    and number of returns, and one byte combining the synthetic, keypoint,
+    withheld, overlap, scan direction, and edge of flight line flags. The
+    64 bit counters are incremented directly because spreading them over
+    several lanes for runs of the same value measured no faster.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    19 October 2026 -- one set of 64 bit counters and a const write_statistics()
+    19 October 2026 -- created to report attribute distributions without lasinfo
+
+===============================================================================
+*/
+#ifndef HISTOGRAM_CHECK_HPP
+#define HISTOGRAM_CHECK_HPP
+
+#include "laspoint.hpp"
+
+#include "xmlwriter.hpp"
+
+#define HISTOGRAMCHECK_CLASSIFICATION   0
+#define HISTOGRAMCHECK_FLAGS            1
+#define HISTOGRAMCHECK_USER_DATA        2
+#define HISTOGRAMCHECK_SCAN_ANGLE       3
+#define HISTOGRAMCHECK_SCANNER_CHANNEL  4
+#define HISTOGRAMCHECK_RETURNS          5
+#define HISTOGRAMCHECK_ATTRIBUTES       6
+
+#define HISTOGRAMCHECK_FLAG_SYNTHETIC      0x01
+#define HISTOGRAMCHECK_FLAG_KEYPOINT       0x02
+#define HISTOGRAMCHECK_FLAG_WITHHELD       0x04
+#define HISTOGRAMCHECK_FLAG_OVERLAP        0x08
+#define HISTOGRAMCHECK_FLAG_SCAN_DIRECTION 0x10
+#define HISTOGRAMCHECK_FLAG_EDGE           0x20
+
+class HISTOGRAMcheck
+{
+public:
+
+  void parse(const LASpoint* laspoint);
+  void write_statistics(XMLwriter* xmlwriter) const;
+
+  HISTOGRAMcheck();
+  ~HISTOGRAMcheck();
+
+private:
+  I64 number_of_points;
+  I64 totals[HISTOGRAMCHECK_ATTRIBUTES][256];
+};
+
+#endif
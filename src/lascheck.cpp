@@ -30,9 +30,11 @@
 */
 
 #include <time.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "lascheck.hpp"
+#include "checkutility.hpp"
 
 #include "crscheck.hpp"
 
@@ -77,21 +79,291 @@ static I32 lidardouble2string(CHAR* string, F64 value, F64 scale)
   return strlen(string)-1;
 };
 
+static U32 greatest_common_divisor(U32 a, U32 b)
+{
+  while (b)
+  {
+    U32 t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+// integer coordinate closest to value, kept slightly beyond the I32 range so it cannot overflow
+
+static I64 integer_estimate(const F64 value, const F64 scale_factor, const F64 offset)
+{
+  F64 X = (value - offset) / scale_factor;
+  if (X < -4294967296.0) return -4294967296LL;
+  if (X > 4294967296.0) return 4294967296LL;
+  return I64_QUANTIZE(X);
+}
+
+// smallest integer coordinate that is not below min after scaling and translating (the
+// rounding of the estimate is corrected with the same expression the points are checked with)
+
+static I64 integer_lower_bound(const F64 min, const F64 scale_factor, const F64 offset)
+{
+  I64 X = integer_estimate(min, scale_factor, offset);
+  for (I32 i = 0; (i < 4) && ((scale_factor*(X-1)+offset) >= min); i++) X--;
+  for (I32 i = 0; (i < 4) && ((scale_factor*X+offset) < min); i++) X++;
+  return X;
+}
+
+// largest integer coordinate that is not above max after scaling and translating
+
+static I64 integer_upper_bound(const F64 max, const F64 scale_factor, const F64 offset)
+{
+  I64 X = integer_estimate(max, scale_factor, offset);
+  for (I32 i = 0; (i < 4) && ((scale_factor*(X+1)+offset) <= max); i++) X++;
+  for (I32 i = 0; (i < 4) && ((scale_factor*X+offset) > max); i++) X--;
+  return X;
+}
+
+void LAScheck::flush_batch()
+{
+  U32 i, j;
+
+  // sample the first point of the batch and thin out the sample when it is full
+
+  if (batch_size && ((crs_sample_batches++ % crs_sample_step) == 0))
+  {
+    if (crs_sample_num == LASCHECK_CRS_SAMPLES)
+    {
+      for (i = 0; i < LASCHECK_CRS_SAMPLES/2; i++)
+      {
+        crs_samples[0][i] = crs_samples[0][2*i];
+        crs_samples[1][i] = crs_samples[1][2*i];
+      }
+      crs_sample_num = LASCHECK_CRS_SAMPLES/2;
+      crs_sample_step *= 2;
+    }
+    crs_samples[0][crs_sample_num] = batch[0][0];
+    crs_samples[1][crs_sample_num] = batch[1][0];
+    crs_sample_num++;
+  }
+
+  // check points against bounding box
+
+  points_outside_bounding_box += laskernels->count_outside_bounding_box(batch[0], batch[1], batch[2], batch_size, min_XYZ, max_XYZ);
+
+  // update the GCD of the coordinate differences for each axis that is not yet at full resolution
+
+  for (j = 0; j < 3; j++)
+  {
+    U32 gcd = resolution_gcd[j];
+    if (gcd == 1)
+    {
+      continue;
+    }
+    laskernels->absolute_differences(batch[j], batch_size, resolution_origin[j], differences);
+    for (i = 0; (i < batch_size) && (gcd != 1); i++)
+    {
+      // most differences are multiples of the current GCD so this usually costs one modulo
+
+      if (gcd == 0)
+      {
+        gcd = differences[i];
+      }
+      else if (differences[i] % gcd)
+      {
+        gcd = greatest_common_divisor(gcd, differences[i] % gcd);
+      }
+    }
+    resolution_gcd[j] = gcd;
+  }
+  batch_size = 0;
+}
+
 void LAScheck::parse(const LASpoint* laspoint)
 {
   // add point to inventory
 
   lasinventory.add(laspoint);
 
-  // check point against bounding box
+  // the first point is the origin for the resolution check
+
+  if (resolution_first)
+  {
+    resolution_origin[0] = laspoint->X;
+    resolution_origin[1] = laspoint->Y;
+    resolution_origin[2] = laspoint->Z;
+    resolution_first = FALSE;
+  }
+
+  // collect integer coordinates for bounding box and resolution checks
+
+  batch[0][batch_size] = laspoint->X;
+  batch[1][batch_size] = laspoint->Y;
+  batch[2][batch_size] = laspoint->Z;
+  batch_size++;
+  if (batch_size == LASCHECK_BATCH)
+  {
+    flush_batch();
+  }
+
+  // check the extra bytes
+
+  if (extrabytescheck)
+  {
+    extrabytescheck->parse(laspoint);
+  }
+
+  // optional checks
+
+  if (gpstimecheck)
+  {
+    gpstimecheck->parse(laspoint);
+  }
+  if (duplicatecheck)
+  {
+    duplicatecheck->parse(laspoint);
+  }
+  if (densitycheck)
+  {
+    densitycheck->parse(laspoint);
+  }
+  if (histogramcheck)
+  {
+    histogramcheck->parse(laspoint);
+  }
+  if (quantilecheck)
+  {
+    quantilecheck->parse(laspoint);
+  }
+  if (flightlinecheck)
+  {
+    flightlinecheck->parse(laspoint);
+  }
+  if (ordercheck)
+  {
+    ordercheck->parse(laspoint);
+  }
+  if (pulsecheck)
+  {
+    pulsecheck->parse(laspoint);
+  }
+}
+
+void LAScheck::check_gps_time(const F64 gap)
+{
+  if (has_gps_time && (gpstimecheck == 0))
+  {
+    gpstimecheck = new GPStimecheck(gap);
+  }
+}
+
+void LAScheck::check_duplicates(const U32 budget_in_MB)
+{
+  if (duplicatecheck == 0)
+  {
+    duplicatecheck = new DUPLICATEcheck(has_gps_time, budget_in_MB);
+  }
+}
+
+void LAScheck::check_density(const LASheader* lasheader, const F64 cell_size, const F64 min_density)
+{
+  if (densitycheck == 0)
+  {
+    densitycheck = new DENSITYcheck(lasheader, cell_size, min_density);
+  }
+}
+
+void LAScheck::check_histograms()
+{
+  if (histogramcheck == 0)
+  {
+    histogramcheck = new HISTOGRAMcheck();
+  }
+}
+
+void LAScheck::check_quantiles(const LASheader* lasheader)
+{
+  if (quantilecheck == 0)
+  {
+    quantilecheck = new QUANTILEcheck(lasheader);
+  }
+}
+
+void LAScheck::check_flightlines(const LASheader* lasheader)
+{
+  if (flightlinecheck == 0)
+  {
+    flightlinecheck = new FLIGHTLINEcheck(lasheader);
+  }
+}
+
+void LAScheck::check_point_order(const LASheader* lasheader)
+{
+  if (ordercheck == 0)
+  {
+    ordercheck = new ORDERcheck(lasheader);
+  }
+}
 
-  if (!laspoint->inside_bounding_box(min_x, min_y, min_z, max_x, max_y, max_z))
+void LAScheck::check_extra_bytes()
+{
+  report_extra_bytes = TRUE;
+}
+
+void LAScheck::check_pulses(const LASheader* lasheader)
+{
+  // the returns of a pulse are found by their GPS time
+
+  if ((pulsecheck == 0) && format_has_gps_time(lasheader->point_data_format))
   {
-    points_outside_bounding_box++;
+    pulsecheck = new PULSEcheck();
   }
 }
 
-void LAScheck::check(LASheader* lasheader, CHAR* crsdescription, BOOL no_CRS_fail, F64 tile_size)
+BOOL LAScheck::has_statistics() const
+{
+  return ((extrabytescheck && report_extra_bytes) || densitycheck || histogramcheck || quantilecheck || flightlinecheck || ordercheck || pulsecheck);
+}
+
+void LAScheck::write_statistics(XMLwriter* xmlwriter) const
+{
+  if (extrabytescheck && report_extra_bytes)
+  {
+    extrabytescheck->write_statistics(xmlwriter);
+  }
+  if (densitycheck)
+  {
+    densitycheck->write_statistics(xmlwriter);
+  }
+  if (histogramcheck)
+  {
+    histogramcheck->write_statistics(xmlwriter);
+  }
+  if (quantilecheck)
+  {
+    quantilecheck->write_statistics(xmlwriter);
+  }
+  if (flightlinecheck)
+  {
+    flightlinecheck->write_statistics(xmlwriter);
+  }
+  if (ordercheck)
+  {
+    ordercheck->write_statistics(xmlwriter);
+  }
+  if (pulsecheck)
+  {
+    pulsecheck->write_statistics(xmlwriter);
+  }
+}
+
+BOOL LAScheck::write_density_raster(const CHAR* file_name) const
+{
+  if (densitycheck)
+  {
+    return densitycheck->write_raster(file_name);
+  }
+  return FALSE;
+}
+
+void LAScheck::check(LASheader* lasheader, CHAR* crsdescription, BOOL no_CRS_fail, F64 tile_size, F64 tile_origin_x, F64 tile_origin_y)
 {
   U32 i,j;
   CHAR problem[512];
@@ -652,6 +924,16 @@ void LAScheck::check(LASheader* lasheader, CHAR* crsdescription, BOOL no_CRS_fai
       sprintf(note, "max_y - min_y is %g and exceeds %g ", (lasheader->max_y - lasheader->min_y), tile_size);
       lasheader->add_fail(problem, note);
     }  
+
+    // and that it lies inside of one cell of the tile grid
+
+    I32 col, row;
+    if (((lasheader->max_x - lasheader->min_x) <= tile_size) && ((lasheader->max_y - lasheader->min_y) <= tile_size) && !GRIDcheck::get_cell(lasheader, tile_size, tile_origin_x, tile_origin_y, &col, &row))
+    {
+      sprintf(problem, "header bounding box crosses tile grid");
+      sprintf(note, "does not fit into one tile of size %g with grid origin %g %g", tile_size, tile_origin_x, tile_origin_y);
+      lasheader->add_fail(problem, note);
+    }
   }
 
   // check number of point records in header against the counted inventory
@@ -877,23 +1159,28 @@ void LAScheck::check(LASheader* lasheader, CHAR* crsdescription, BOOL no_CRS_fai
     }
   }
 
-  // check for resolution fluff in the coordinates
+  // process the points that are still in the batch
+
+  flush_batch();
+
+  // check for resolution fluff in the coordinates (the effective resolution is the GCD of all coordinate differences).
+  // it is serious from x100 and very serious from x1000 on.
 
   if (lasinventory.is_active())
   {
-    if (lasinventory.has_fluff())
+    const CHAR* axis_name[3] = { "X", "Y", "Z" };
+    F64 scale_factor[3] = { lasheader->x_scale_factor, lasheader->y_scale_factor, lasheader->z_scale_factor };
+
+    for (i = 0; i < 3; i++)
     {
-      sprintf(note, "resolution fluff (x10) in %s%s%s", (lasinventory.has_fluff(0) ? "X" : ""), (lasinventory.has_fluff(1) ? "Y" : ""), (lasinventory.has_fluff(2) ? "Z" : ""));
-      lasheader->add_warning("coordinate values", note);
-      if (lasinventory.has_serious_fluff())
+      if (resolution_gcd[i] > 1)
       {
-        sprintf(note, "serious resolution fluff (x100) in %s%s%s", (lasinventory.has_serious_fluff(0) ? "X" : ""), (lasinventory.has_serious_fluff(1) ? "Y" : ""), (lasinventory.has_serious_fluff(2) ? "Z" : ""));
+        CHAR string1[256], string2[256];
+        lidardouble2string(string1, scale_factor[i]);
+        lidardouble2string(string2, resolution_gcd[i]*scale_factor[i]);
+        const CHAR* severity = (resolution_gcd[i] >= 1000 ? "very serious " : (resolution_gcd[i] >= 100 ? "serious " : ""));
+        sprintf(note, "%sresolution fluff (x%u) in %s: stored at %.64s but effective resolution is %.64s", severity, resolution_gcd[i], axis_name[i], string1, string2);
         lasheader->add_warning("coordinate values", note);
-        if (lasinventory.has_very_serious_fluff())
-        {
-          sprintf(note, "very serious resolution fluff (x1000) in %s%s%s", (lasinventory.has_very_serious_fluff(0) ? "X" : ""), (lasinventory.has_very_serious_fluff(1) ? "Y" : ""), (lasinventory.has_very_serious_fluff(2) ? "Z" : ""));
-          lasheader->add_warning("coordinate values", note);
-        }
       }
     }
   }
@@ -1135,7 +1422,7 @@ void LAScheck::check(LASheader* lasheader, CHAR* crsdescription, BOOL no_CRS_fai
 
   // check for point data formats 1, 3, 4, and higher in the inventory whether all GPS time stamps are identical
 
-  if ((lasheader->point_data_format != 0) && (lasheader->point_data_format != 2))
+  if (format_has_gps_time(lasheader->point_data_format))
   {
     if (lasinventory.is_active())
     {
@@ -1149,6 +1436,13 @@ void LAScheck::check(LASheader* lasheader, CHAR* crsdescription, BOOL no_CRS_fai
         lasheader->add_warning("GPS time", note);
       }
     }
+
+    // maybe check the time stamps of each flight line
+
+    if (gpstimecheck)
+    {
+      gpstimecheck->check(lasheader);
+    }
   }
 
   // check for point data formats 2, 3, 7, 8, and 10 in the inventory whether all RGB values are identical
@@ -1202,6 +1496,13 @@ void LAScheck::check(LASheader* lasheader, CHAR* crsdescription, BOOL no_CRS_fai
     }
   }
 
+  // check extra bytes against their descriptors
+
+  if (extrabytescheck)
+  {
+    extrabytescheck->check(lasheader);
+  }
+
   // check for wrong wave packet indices
 
   if ((lasheader->point_data_format == 4) || (lasheader->point_data_format == 5) || (lasheader->point_data_format == 9) || (lasheader->point_data_format == 10))
@@ -1225,10 +1526,56 @@ void LAScheck::check(LASheader* lasheader, CHAR* crsdescription, BOOL no_CRS_fai
     }
   }
 
+  // maybe check for duplicate points
+
+  if (duplicatecheck)
+  {
+    duplicatecheck->check(lasheader);
+  }
+
+  // maybe check the point density
+
+  if (densitycheck)
+  {
+    densitycheck->check(lasheader);
+  }
+
+  // maybe check for heavy tails in the distributions
+
+  if (quantilecheck)
+  {
+    quantilecheck->check(lasheader);
+  }
+
+  // maybe check how spatially coherent the point order is
+
+  if (ordercheck)
+  {
+    ordercheck->check(lasheader);
+  }
+
+  // maybe check that the returns of each pulse are complete
+
+  if (pulsecheck)
+  {
+    pulsecheck->check(lasheader);
+  }
+
   if (lasheader->geokeys || lasheader->ogc_wkt)
   {
+    // the CRS check keeps what it resolves inside the object and the area of use check
+    // projects the samples in chunks on the stack. only CRS VLRs that are not cached
+    // yet or too long for the stack buffer of the cache key allocate anything else
+    // than the warnings and fails that are added to the header.
+
     CRScheck crscheck;
     crscheck.check(lasheader, crsdescription, no_CRS_fail);
+
+    // the bounding box and the sampled points must be where the CRS is used
+
+    crscheck.check_area_of_use(lasheader, crs_samples[0], crs_samples[1], crs_sample_num);
+
+    crscheck.get_identity(lasheader, &crs_identity);
   }
 }
 
@@ -1241,8 +1588,82 @@ LAScheck::LAScheck(const LASheader* lasheader)
   max_y = lasheader->max_y + lasheader->y_scale_factor;
   max_z = lasheader->max_z + lasheader->z_scale_factor;
   points_outside_bounding_box = 0;
+
+  // the same bounding box in integer coordinates so the kernels need not scale and translate
+
+  F64 min_xyz[3] = { min_x, min_y, min_z };
+  F64 max_xyz[3] = { max_x, max_y, max_z };
+  F64 scale_factor[3] = { lasheader->x_scale_factor, lasheader->y_scale_factor, lasheader->z_scale_factor };
+  F64 offset[3] = { lasheader->x_offset, lasheader->y_offset, lasheader->z_offset };
+
+  for (U32 i = 0; i < 3; i++)
+  {
+    if ((min_xyz[i] != min_xyz[i]) || (max_xyz[i] != max_xyz[i]) || !(scale_factor[i] > 0.0) || (offset[i] != offset[i]))
+    {
+      // a broken header bounding box or scale factor cannot exclude any point
+
+      min_XYZ[i] = I32_MIN;
+      max_XYZ[i] = I32_MAX;
+    }
+    else
+    {
+      I64 min_X = integer_lower_bound(min_xyz[i], scale_factor[i], offset[i]);
+      I64 max_X = integer_upper_bound(max_xyz[i], scale_factor[i], offset[i]);
+      if ((min_X > max_X) || (min_X > I32_MAX) || (max_X < I32_MIN))
+      {
+        // every point is outside
+
+        min_XYZ[i] = 1;
+        max_XYZ[i] = 0;
+      }
+      else
+      {
+        min_XYZ[i] = (min_X < I32_MIN ? I32_MIN : (I32)min_X);
+        max_XYZ[i] = (max_X > I32_MAX ? I32_MAX : (I32)max_X);
+      }
+    }
+  }
+
+  laskernels = LASkernels::get();
+  batch_size = 0;
+
+  resolution_first = TRUE;
+  resolution_origin[0] = resolution_origin[1] = resolution_origin[2] = 0;
+  resolution_gcd[0] = resolution_gcd[1] = resolution_gcd[2] = 0;
+
+  crs_sample_num = 0;
+  crs_sample_step = 1;
+  crs_sample_batches = 0;
+  memset(&crs_identity, 0, sizeof(CRSidentity));
+
+  extrabytescheck = new EXTRABYTEScheck(lasheader);
+  if (!extrabytescheck->has_extra_bytes())
+  {
+    delete extrabytescheck;
+    extrabytescheck = 0;
+  }
+  report_extra_bytes = FALSE;
+
+  has_gps_time = format_has_gps_time(lasheader->point_data_format);
+  gpstimecheck = 0;
+  duplicatecheck = 0;
+  densitycheck = 0;
+  histogramcheck = 0;
+  quantilecheck = 0;
+  flightlinecheck = 0;
+  ordercheck = 0;
+  pulsecheck = 0;
 }
 
 LAScheck::~LAScheck()
 {
+  if (extrabytescheck) delete extrabytescheck;
+  if (gpstimecheck) delete gpstimecheck;
+  if (duplicatecheck) delete duplicatecheck;
+  if (densitycheck) delete densitycheck;
+  if (histogramcheck) delete histogramcheck;
+  if (quantilecheck) delete quantilecheck;
+  if (flightlinecheck) delete flightlinecheck;
+  if (ordercheck) delete ordercheck;
+  if (pulsecheck) delete pulsecheck;
 }
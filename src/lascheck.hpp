@@ -25,6 +25,20 @@
   
   CHANGE HISTORY:
   
+    19 October 2026 -- identity of the resolved CRS for grouping the files of a batch
+    19 October 2026 -- bounding box and sampled points are checked against the area of use of the CRS
+    19 October 2026 -- optional check of the return sequence of each pulse
+    19 October 2026 -- extra bytes are checked against the descriptors of the Extra Bytes VLR
+    19 October 2026 -- optional point order coherence from Morton codes of a coarse grid
+    19 October 2026 -- optional inventory of the flight lines by point source ID
+    19 October 2026 -- optional quantile sketches with heavy tail warnings
+    19 October 2026 -- optional histograms of all 8 bit point attributes
+    19 October 2026 -- tile size is applied and checked against a grid with origin
+    19 October 2026 -- optional density grid with statistics and raster output
+    19 October 2026 -- optional duplicate point check with bounded memory
+    19 October 2026 -- optional GPS time order, gaps, and pulse rate per flight line
+    19 October 2026 -- bounding box test in batches with runtime CPU dispatch
+    19 October 2026 -- effective coordinate resolution from running GCD of integers
      4 January 2020 -- optional check for heaber bounding box matching tile size
      1 April 2013 -- on Easter Monday all-nighting in Perth airport for PER->SYD
   
@@ -37,6 +51,23 @@
 #include "laspoint.hpp"
 #include "lasutility.hpp"
 
+#include "laskernels.hpp"
+#include "extrabytescheck.hpp"
+#include "gpstimecheck.hpp"
+#include "duplicatecheck.hpp"
+#include "densitycheck.hpp"
+#include "gridcheck.hpp"
+#include "histogramcheck.hpp"
+#include "quantilecheck.hpp"
+#include "flightlinecheck.hpp"
+#include "ordercheck.hpp"
+#include "pulsecheck.hpp"
+#include "crscheck.hpp"
+#include "xmlwriter.hpp"
+
+#define LASCHECK_BATCH 1024
+#define LASCHECK_CRS_SAMPLES 1024
+
 #define LASCHECK_VERSION_MAJOR 1
 #define LASCHECK_VERSION_MINOR 1
 #define LASCHECK_BUILD_DATE 200104
@@ -46,7 +77,29 @@ class LAScheck
 public:
 
   void parse(const LASpoint* laspoint);
-  void check(LASheader* lasheader, CHAR* crsdescription=0, BOOL no_CRS_fail=FALSE, F64 tile_size=0.0);
+  void check(LASheader* lasheader, CHAR* crsdescription=0, BOOL no_CRS_fail=FALSE, F64 tile_size=0.0, F64 tile_origin_x=0.0, F64 tile_origin_y=0.0);
+
+  // optional checks that need to be enabled before the first point is parsed
+
+  void check_gps_time(const F64 gap);
+  void check_duplicates(const U32 budget_in_MB);
+  void check_density(const LASheader* lasheader, const F64 cell_size, const F64 min_density);
+  void check_histograms();
+  void check_quantiles(const LASheader* lasheader);
+  void check_flightlines(const LASheader* lasheader);
+  void check_point_order(const LASheader* lasheader);
+  void check_extra_bytes();
+  void check_pulses(const LASheader* lasheader);
+
+  // results of optional checks that are not pass, warning, or fail
+
+  BOOL has_statistics() const;
+  void write_statistics(XMLwriter* xmlwriter) const;
+  BOOL write_density_raster(const CHAR* file_name) const;
+
+  // the CRS that check() resolved (all zero if the file has none)
+
+  const CRSidentity* get_crs_identity() const { return &crs_identity; };
 
   LAScheck(const LASheader* lasheader);
   ~LAScheck();
@@ -54,8 +107,49 @@ public:
 private:
   F64 min_x, min_y, min_z;
   F64 max_x, max_y, max_z;
+  I32 min_XYZ[3];
+  I32 max_XYZ[3];
   I64 points_outside_bounding_box;
   LASinventory lasinventory;
+
+  // integer coordinates are batched and handed to the kernels of the selected ISA level
+
+  const LASkernels* laskernels;
+  U32 batch_size;
+  I32 batch[3][LASCHECK_BATCH];
+  U32 differences[LASCHECK_BATCH];
+  void flush_batch();
+
+  // running GCD of the integer coordinate differences to the first point
+
+  BOOL resolution_first;
+  I32 resolution_origin[3];
+  U32 resolution_gcd[3];
+
+  // the first point of every crs_sample_step-th batch is kept to check against the area of use of the CRS
+
+  U32 crs_sample_num;
+  U32 crs_sample_step;
+  U32 crs_sample_batches;
+  I32 crs_samples[2][LASCHECK_CRS_SAMPLES];
+  CRSidentity crs_identity;
+
+  // extra bytes and their descriptors if the point records have any
+
+  EXTRABYTEScheck* extrabytescheck;
+  BOOL report_extra_bytes;
+
+  // optional checks
+
+  BOOL has_gps_time;
+  GPStimecheck* gpstimecheck;
+  DUPLICATEcheck* duplicatecheck;
+  DENSITYcheck* densitycheck;
+  HISTOGRAMcheck* histogramcheck;
+  QUANTILEcheck* quantilecheck;
+  FLIGHTLINEcheck* flightlinecheck;
+  ORDERcheck* ordercheck;
+  PULSEcheck* pulsecheck;
 };
 
 #endif
@@ -0,0 +1,187 @@
+/*
+===============================================================================
+
+  FILE:  laskernels.cpp
+  
+  CONTENTS:
+  
+    see corresponding header file
+  
+  PROGRAMMERS:
+  
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+  
+  COPYRIGHT:
+  
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  
+  CHANGE HISTORY:
+  
+    see corresponding header file
+  
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "laskernels.hpp"
+
+static LASkernels selected_kernels;
+static BOOL selected = FALSE;
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+
+static BOOL cpu_supports(const I32 level)
+{
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7)
+  {
+    return FALSE;
+  }
+  __cpuid(info, 1);
+  // the OS must save the AVX registers on context switches
+  if ((info[2] & (1 << 27)) == 0)
+  {
+    return FALSE;
+  }
+  unsigned __int64 xcr0 = _xgetbv(0);
+  __cpuidex(info, 7, 0);
+  if (level == LASKERNELS_AVX2)
+  {
+    return ((xcr0 & 0x06) == 0x06) && (info[1] & (1 << 5));
+  }
+  else if (level == LASKERNELS_AVX512)
+  {
+    return ((xcr0 & 0xE6) == 0xE6) && (info[1] & (1 << 16)) && (info[1] & (1 << 30));
+  }
+  return FALSE;
+}
+
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+static BOOL cpu_supports(const I32 level)
+{
+  __builtin_cpu_init();
+  if (level == LASKERNELS_AVX2)
+  {
+    return (__builtin_cpu_supports("avx2") != 0);
+  }
+  else if (level == LASKERNELS_AVX512)
+  {
+    return (__builtin_cpu_supports("avx512f") != 0) && (__builtin_cpu_supports("avx512bw") != 0);
+  }
+  return FALSE;
+}
+
+#else
+
+static BOOL cpu_supports(const I32 level)
+{
+  return FALSE;
+}
+
+#endif
+
+BOOL LASkernels::is_supported(const I32 level)
+{
+  LASkernels kernels;
+  if (level == LASKERNELS_SSE2)
+  {
+    return laskernels_set_sse2(&kernels);
+  }
+  else if (level == LASKERNELS_AVX2)
+  {
+    return cpu_supports(LASKERNELS_AVX2) && laskernels_set_avx2(&kernels);
+  }
+  else if (level == LASKERNELS_AVX512)
+  {
+    return cpu_supports(LASKERNELS_AVX512) && laskernels_set_avx512(&kernels);
+  }
+  return FALSE;
+}
+
+BOOL LASkernels::select(const CHAR* cpu)
+{
+  I32 level;
+
+  if (cpu == 0)
+  {
+    cpu = "auto";
+  }
+
+  if (strcmp(cpu, "auto") == 0)
+  {
+    if (is_supported(LASKERNELS_AVX512))
+    {
+      level = LASKERNELS_AVX512;
+    }
+    else if (is_supported(LASKERNELS_AVX2))
+    {
+      level = LASKERNELS_AVX2;
+    }
+    else
+    {
+      level = LASKERNELS_SSE2;
+    }
+  }
+  else if (strcmp(cpu, "sse2") == 0)
+  {
+    level = LASKERNELS_SSE2;
+  }
+  else if (strcmp(cpu, "avx2") == 0)
+  {
+    level = LASKERNELS_AVX2;
+  }
+  else if (strcmp(cpu, "avx512") == 0)
+  {
+    level = LASKERNELS_AVX512;
+  }
+  else
+  {
+    fprintf(stderr, "ERROR: unknown cpu '%s'. use 'sse2', 'avx2', 'avx512', or 'auto'\n", cpu);
+    return FALSE;
+  }
+
+  if (!is_supported(level))
+  {
+    fprintf(stderr, "ERROR: cpu '%s' is not supported by this processor or this build\n", cpu);
+    return FALSE;
+  }
+
+  if (level == LASKERNELS_AVX512)
+  {
+    laskernels_set_avx512(&selected_kernels);
+  }
+  else if (level == LASKERNELS_AVX2)
+  {
+    laskernels_set_avx2(&selected_kernels);
+  }
+  else
+  {
+    laskernels_set_sse2(&selected_kernels);
+  }
+  selected = TRUE;
+  return TRUE;
+}
+
+const LASkernels* LASkernels::get()
+{
+  if (!selected)
+  {
+    select();
+  }
+  return &selected_kernels;
+}
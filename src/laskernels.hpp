@@ -0,0 +1,82 @@
+/*
+===============================================================================
+
+  FILE:  laskernels.hpp
+  
+  CONTENTS:
+  
+    A table of the per-point kernels of LAScheck that run over batches of
+    integer coordinates or raw point records: the bounding box test, the
+    differences for the resolution GCD, and the zero and repeated record
+    test. The kernels are compiled once per ISA level (SSE2, AVX2, AVX-512)
+    and the best level the CPU supports is selected at startup (or forced
+    with '-cpu' for testing). Parsing the points and updating the inventory
+    happen inside LASread and are not in the table. Neither are hashing,
+    which is a few multiplies per point next to a random access to the hash
+    table, and formatting, which is done once per report and not per point.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+  
+  COPYRIGHT:
+  
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  
+  CHANGE HISTORY:
+  
+    19 October 2026 -- kernel to find all zero and repeated point records
+    19 October 2026 -- one binary at full speed on old and new cluster nodes
+  
+===============================================================================
+*/
+#ifndef LAS_KERNELS_HPP
+#define LAS_KERNELS_HPP
+
+#include "mydefs.hpp"
+
+#define LASKERNELS_SSE2    0
+#define LASKERNELS_AVX2    1
+#define LASKERNELS_AVX512  2
+
+#define LASKERNELS_RECORD_ZERO     1
+#define LASKERNELS_RECORD_REPEATED 2
+
+class LASkernels
+{
+public:
+  I32 level;
+  const CHAR* name;
+
+  // number of points whose integer coordinates are outside [min, max]
+
+  U32 (*count_outside_bounding_box)(const I32* X, const I32* Y, const I32* Z, const U32 n, const I32* min, const I32* max);
+
+  // absolute difference of each integer coordinate to the origin
+
+  void (*absolute_differences)(const I32* values, const U32 n, const I32 origin, U32* differences);
+
+  // marks records that are all zero or identical to the one before and returns how many are marked.
+  // the record before the first must be readable at 'records - record_length'
+
+  U32 (*classify_records)(const U8* records, const U32 n, const U32 record_length, U8* classes);
+
+  // selects the best supported level or the one named by 'cpu' (sse2, avx2, avx512, auto)
+
+  static BOOL select(const CHAR* cpu=0);
+  static BOOL is_supported(const I32 level);
+  static const LASkernels* get();
+};
+
+BOOL laskernels_set_sse2(LASkernels* kernels);
+BOOL laskernels_set_avx2(LASkernels* kernels);
+BOOL laskernels_set_avx512(LASkernels* kernels);
+
+#endif
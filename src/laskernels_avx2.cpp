@@ -0,0 +1,43 @@
+/*
+===============================================================================
+
+  FILE:  laskernels_avx2.cpp
+  
+  CONTENTS:
+  
+    Kernels for AVX2. This file must be compiled with '-mavx2' (or '/arch:AVX2')
+    otherwise it provides no kernels and the AVX2 level is not available.
+
+  PROGRAMMERS:
+  
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+  
+  COPYRIGHT:
+  
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  
+  CHANGE HISTORY:
+  
+    see corresponding header file
+  
+===============================================================================
+*/
+
+#include "laskernels_generic.hpp"
+
+BOOL laskernels_set_avx2(LASkernels* kernels)
+{
+#if defined(__AVX2__)
+  generic_set_kernels(kernels, LASKERNELS_AVX2, "avx2");
+  return TRUE;
+#else
+  return FALSE;
+#endif
+}
@@ -0,0 +1,43 @@
+/*
+===============================================================================
+
+  FILE:  laskernels_avx512.cpp
+  
+  CONTENTS:
+  
+    Kernels for AVX-512. This file must be compiled with '-mavx512f -mavx512bw'
+    (or '/arch:AVX512') otherwise the AVX-512 level is not available.
+
+  PROGRAMMERS:
+  
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+  
+  COPYRIGHT:
+  
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  
+  CHANGE HISTORY:
+  
+    see corresponding header file
+  
+===============================================================================
+*/
+
+#include "laskernels_generic.hpp"
+
+BOOL laskernels_set_avx512(LASkernels* kernels)
+{
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+  generic_set_kernels(kernels, LASKERNELS_AVX512, "avx512");
+  return TRUE;
+#else
+  return FALSE;
+#endif
+}
@@ -0,0 +1,107 @@
+/*
+===============================================================================
+
+  FILE:  laskernels_generic.hpp
+  
+  CONTENTS:
+  
+    The bodies of the per-point kernels. This file is included by exactly one
+    source file per ISA level, each compiled with its own architecture flags,
+    so that the compiler vectorizes the same loops for SSE2, AVX2 or AVX-512.
+    Everything here must stay 'static' to not leak across those files.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+  
+  COPYRIGHT:
+  
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  
+  CHANGE HISTORY:
+  
+    see corresponding header file
+  
+===============================================================================
+*/
+#ifndef LAS_KERNELS_GENERIC_HPP
+#define LAS_KERNELS_GENERIC_HPP
+
+#include <string.h>
+
+#include "laskernels.hpp"
+
+static U32 generic_count_outside_bounding_box(const I32* X, const I32* Y, const I32* Z, const U32 n, const I32* min, const I32* max)
+{
+  U32 i, outside = 0;
+  const I32 min_X = min[0], min_Y = min[1], min_Z = min[2];
+  const I32 max_X = max[0], max_Y = max[1], max_Z = max[2];
+  for (i = 0; i < n; i++)
+  {
+    outside += (U32)((X[i] < min_X) | (X[i] > max_X) | (Y[i] < min_Y) | (Y[i] > max_Y) | (Z[i] < min_Z) | (Z[i] > max_Z));
+  }
+  return outside;
+}
+
+static void generic_absolute_differences(const I32* values, const U32 n, const I32 origin, U32* differences)
+{
+  U32 i;
+  for (i = 0; i < n; i++)
+  {
+    // wrap-around arithmetic in 32 bits keeps this a blend of two subtractions
+
+    U32 above = (U32)values[i] - (U32)origin;
+    U32 below = (U32)origin - (U32)values[i];
+    differences[i] = (values[i] >= origin ? above : below);
+  }
+}
+
+static U32 generic_classify_records(const U8* records, const U32 n, const U32 record_length, U8* classes)
+{
+  U32 i, j, marked = 0;
+  for (i = 0; i < n; i++)
+  {
+    // records are only 20 to 67 bytes long, which is too short for vector
+    // compares to pay off, so this ORs eight bytes at a time in plain scalar
+    // code and then the few bytes that are left
+
+    const U8* record = records + (size_t)i * record_length;
+    const U8* previous = record - record_length;
+    U64 any = 0;
+    U64 diff = 0;
+    for (j = 0; (j + 8) <= record_length; j += 8)
+    {
+      U64 a, b;
+      memcpy(&a, record + j, 8);
+      memcpy(&b, previous + j, 8);
+      any |= a;
+      diff |= (a ^ b);
+    }
+    for (; j < record_length; j++)
+    {
+      any |= record[j];
+      diff |= (U8)(record[j] ^ previous[j]);
+    }
+    classes[i] = (any == 0 ? LASKERNELS_RECORD_ZERO : (diff == 0 ? LASKERNELS_RECORD_REPEATED : 0));
+    marked += (classes[i] != 0);
+  }
+  return marked;
+}
+
+static void generic_set_kernels(LASkernels* kernels, const I32 level, const CHAR* name)
+{
+  kernels->level = level;
+  kernels->name = name;
+  kernels->count_outside_bounding_box = generic_count_outside_bounding_box;
+  kernels->absolute_differences = generic_absolute_differences;
+  kernels->classify_records = generic_classify_records;
+}
+
+#endif
@@ -0,0 +1,39 @@
+/*
+===============================================================================
+
+  FILE:  laskernels_sse2.cpp
+  
+  CONTENTS:
+  
+    Kernels for the SSE2 baseline that every x86-64 CPU supports. This file is
+    compiled without any architecture flags and is always available.
+
+  PROGRAMMERS:
+  
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+  
+  COPYRIGHT:
+  
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  
+  CHANGE HISTORY:
+  
+    see corresponding header file
+  
+===============================================================================
+*/
+
+#include "laskernels_generic.hpp"
+
+BOOL laskernels_set_sse2(LASkernels* kernels)
+{
+  generic_set_kernels(kernels, LASKERNELS_SSE2, "sse2");
+  return TRUE;
+}
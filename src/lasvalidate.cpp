@@ -24,6 +24,22 @@
   
   CHANGE HISTORY:
   
+    19 October 2026 -- option '-crs_groups' to find files whose CRS differs from the rest of the batch
+    19 October 2026 -- option '-crs_database' to resolve EPSG codes with a memory-mapped file
+    19 October 2026 -- option '-pulses' to count missing, duplicate, and split returns of pulses
+    19 October 2026 -- option '-record_blocks' to find runs of all zero or identical point records
+    19 October 2026 -- byte ranges of header, VLRs, points, waveforms, and EVLRs are checked
+    19 October 2026 -- option '-extra_bytes' to report the range of each extra bytes attribute
+    19 October 2026 -- option '-point_order' to classify files as spatially sorted, time sorted, or scattered
+    19 October 2026 -- option '-flightlines' to report an inventory of the flight lines
+    19 October 2026 -- option '-quantiles' to report percentiles and heavy tails of Z, intensity, GPS time
+    19 October 2026 -- option '-histograms' to report the distributions of 8 bit attributes
+    19 October 2026 -- '-tile_size' is applied and checks the tile grid given by '-tile_origin'
+    19 October 2026 -- option '-tiling' to check all files for overlaps and gaps
+    19 October 2026 -- options '-density', '-density_min', '-density_raster' and statistics in report
+    19 October 2026 -- options '-duplicates' and '-duplicates_memory' to find duplicate points
+    19 October 2026 -- option '-gps_time_gap' to check time stamps per flight line
+    19 October 2026 -- option '-cpu' to force the instruction set of the kernels
      2 August 2015 -- not failing but warning if OCG WRT has intentional empty payload 
     12 April 2015 -- not failing but warning for certain empty VLR payloads 
     20 March 2015 -- fail on files containing zero point records
@@ -42,6 +58,13 @@
 #include "lasreadopener.hpp"
 #include "xmlwriter.hpp"
 #include "lascheck.hpp"
+#include "laskernels.hpp"
+#include "tilecheck.hpp"
+#include "gridcheck.hpp"
+#include "layoutcheck.hpp"
+#include "blockcheck.hpp"
+#include "crsdatabase.hpp"
+#include "crsgroupcheck.hpp"
 
 #define VALIDATE_VERSION  200104
 
@@ -93,6 +116,23 @@ static void usage(int return_code, BOOL wait=FALSE)
   fprintf(stderr,"lasvalidate -i *.las -no_CRS_fail -o report.xml\n");
   fprintf(stderr,"lasvalidate -i *.laz -o summary.xml\n");
   fprintf(stderr,"lasvalidate -i *.laz -tile_size 1000 -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -tile_size 1500 -tile_origin 500 0 -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -cpu sse2 -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i flight*.laz -gps_time_gap 0.5 -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -duplicates -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i huge.laz -duplicates_memory 256 -o report.xml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -density 1 -density_min 8 -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i tile.laz -density 2 -density_raster -oxml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -tiling -tile_size 1000 -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -histograms -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -quantiles -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -flightlines -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -point_order -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -extra_bytes -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i *.las -record_blocks -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -pulses -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -crs_database lasvalidate_crs.bin -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -crs_groups -o summary.xml\n");
   fprintf(stderr,"lasvalidate -i *.las -oxml\n");
   fprintf(stderr,"lasvalidate -i c:\\data\\lidar.las -oxml\n");
   fprintf(stderr,"lasvalidate -i ..\\subfolder\\*.las -o summary.xml\n");
@@ -124,6 +164,23 @@ int main(int argc, char *argv[])
   const CHAR* xml_output_file = 0;
   BOOL no_CRS_fail = FALSE;
   F64 tile_size = 0.0;
+  F64 tile_origin_x = 0.0;
+  F64 tile_origin_y = 0.0;
+  GRIDcheck* gridcheck = 0;
+  F64 gps_time_gap = 0.0;
+  U32 duplicates_memory = 0;
+  F64 density_cell_size = 0.0;
+  F64 density_min = 0.0;
+  BOOL density_raster = FALSE;
+  BOOL histograms = FALSE;
+  BOOL quantiles = FALSE;
+  BOOL flightlines = FALSE;
+  BOOL point_order = FALSE;
+  BOOL extra_bytes = FALSE;
+  BOOL record_blocks = FALSE;
+  BOOL pulses = FALSE;
+  TILEcheck* tilecheck = 0;
+  CRSGROUPcheck* crsgroupcheck = 0;
   BOOL one_report_per_file = FALSE;
   U32 num_pass = 0;
   U32 num_fail = 0;
@@ -246,6 +303,16 @@ int main(int argc, char *argv[])
     {
       no_CRS_fail = TRUE;
     }
+    else if (strcmp(argv[i],"-crs_database") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        fprintf(stderr,"ERROR: '%s' needs at least 1 argument: file name\n", argv[i]);
+        usage(LAS_VALIDATE_WRONG_COMMAND_LINE_SYNTAX);
+      }
+      i++;
+      CRSdatabase::set_file_name(argv[i]);
+    }
     else if (strcmp(argv[i],"-tile_size") == 0)
     {
       if ((i+1) >= argc)
@@ -256,6 +323,128 @@ int main(int argc, char *argv[])
       i++;
       tile_size = atof(argv[i]);
     }
+    else if (strcmp(argv[i],"-tile_origin") == 0)
+    {
+      if ((i+2) >= argc)
+      {
+        fprintf(stderr,"ERROR: '%s' needs 2 arguments: x y\n", argv[i]);
+        usage(LAS_VALIDATE_WRONG_COMMAND_LINE_SYNTAX);
+      }
+      tile_origin_x = atof(argv[i+1]);
+      tile_origin_y = atof(argv[i+2]);
+      i+=2;
+    }
+    else if (strcmp(argv[i],"-gps_time_gap") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        fprintf(stderr,"ERROR: '%s' needs at least 1 argument: gap in seconds\n", argv[i]);
+        usage(LAS_VALIDATE_WRONG_COMMAND_LINE_SYNTAX);
+      }
+      i++;
+      gps_time_gap = atof(argv[i]);
+      if (gps_time_gap <= 0.0)
+      {
+        fprintf(stderr,"ERROR: gap in seconds must be positive but is '%s'\n", argv[i]);
+        usage(LAS_VALIDATE_WRONG_COMMAND_LINE_SYNTAX);
+      }
+    }
+    else if (strcmp(argv[i],"-duplicates") == 0)
+    {
+      if (duplicates_memory == 0) duplicates_memory = 512;
+    }
+    else if (strcmp(argv[i],"-duplicates_memory") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        fprintf(stderr,"ERROR: '%s' needs at least 1 argument: memory in MB\n", argv[i]);
+        usage(LAS_VALIDATE_WRONG_COMMAND_LINE_SYNTAX);
+      }
+      i++;
+      if (sscanf(argv[i], "%u", &duplicates_memory) != 1 || (duplicates_memory == 0))
+      {
+        fprintf(stderr,"ERROR: memory in MB must be positive but is '%s'\n", argv[i]);
+        usage(LAS_VALIDATE_WRONG_COMMAND_LINE_SYNTAX);
+      }
+    }
+    else if (strcmp(argv[i],"-density") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        fprintf(stderr,"ERROR: '%s' needs at least 1 argument: cell size\n", argv[i]);
+        usage(LAS_VALIDATE_WRONG_COMMAND_LINE_SYNTAX);
+      }
+      i++;
+      density_cell_size = atof(argv[i]);
+      if (density_cell_size <= 0.0)
+      {
+        fprintf(stderr,"ERROR: cell size must be positive but is '%s'\n", argv[i]);
+        usage(LAS_VALIDATE_WRONG_COMMAND_LINE_SYNTAX);
+      }
+    }
+    else if (strcmp(argv[i],"-density_min") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        fprintf(stderr,"ERROR: '%s' needs at least 1 argument: pulses per square unit\n", argv[i]);
+        usage(LAS_VALIDATE_WRONG_COMMAND_LINE_SYNTAX);
+      }
+      i++;
+      density_min = atof(argv[i]);
+    }
+    else if (strcmp(argv[i],"-density_raster") == 0)
+    {
+      density_raster = TRUE;
+    }
+    else if (strcmp(argv[i],"-histograms") == 0)
+    {
+      histograms = TRUE;
+    }
+    else if (strcmp(argv[i],"-quantiles") == 0)
+    {
+      quantiles = TRUE;
+    }
+    else if (strcmp(argv[i],"-flightlines") == 0)
+    {
+      flightlines = TRUE;
+    }
+    else if (strcmp(argv[i],"-point_order") == 0)
+    {
+      point_order = TRUE;
+    }
+    else if (strcmp(argv[i],"-extra_bytes") == 0)
+    {
+      extra_bytes = TRUE;
+    }
+    else if (strcmp(argv[i],"-record_blocks") == 0)
+    {
+      record_blocks = TRUE;
+    }
+    else if (strcmp(argv[i],"-pulses") == 0)
+    {
+      pulses = TRUE;
+    }
+    else if (strcmp(argv[i],"-tiling") == 0)
+    {
+      if (tilecheck == 0) tilecheck = new TILEcheck();
+    }
+    else if (strcmp(argv[i],"-crs_groups") == 0)
+    {
+      if (crsgroupcheck == 0) crsgroupcheck = new CRSGROUPcheck();
+    }
+    else if (strcmp(argv[i],"-cpu") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        fprintf(stderr,"ERROR: '%s' needs at least 1 argument: sse2, avx2, avx512, or auto\n", argv[i]);
+        usage(LAS_VALIDATE_WRONG_COMMAND_LINE_SYNTAX);
+      }
+      i++;
+      if (!LASkernels::select(argv[i]))
+      {
+        usage(LAS_VALIDATE_WRONG_COMMAND_LINE_SYNTAX);
+      }
+    }
     else
     {
       fprintf(stderr, "ERROR: cannot understand argument '%s'\n", argv[i]);
@@ -263,10 +452,22 @@ int main(int argc, char *argv[])
     }
   }
 
+  // the density options need a cell size
+
+  if ((density_min > 0.0 || density_raster) && (density_cell_size == 0.0))
+  {
+    fprintf(stderr,"ERROR: '-density_min' and '-density_raster' need a cell size with '-density'\n");
+    usage(LAS_VALIDATE_WRONG_COMMAND_LINE_SYNTAX);
+  }
+
   // in verbose mode we measure the total time
 
   if (verbose) full_start_time = taketime();
 
+  // the kernels of the best instruction set unless '-cpu' forced one
+
+  if (very_verbose) fprintf(stderr, "using %s kernels\n", LASkernels::get()->name);
+
   // check input
 
   if (!lasreadopener.is_active())
@@ -291,6 +492,31 @@ int main(int argc, char *argv[])
     }
   }
 
+  // the tile grid is checked across all files for one summary report
+
+  if ((tile_size > 0.0) && !one_report_per_file)
+  {
+    gridcheck = new GRIDcheck(tile_size, tile_origin_x, tile_origin_y);
+  }
+
+  // the tiling is only checked for one summary report
+
+  if (tilecheck && one_report_per_file)
+  {
+    fprintf(stderr,"WARNING: '-tiling' needs a summary report and is ignored with '-oxml'\n");
+    delete tilecheck;
+    tilecheck = 0;
+  }
+
+  // the CRS groups are also only checked for one summary report
+
+  if (crsgroupcheck && one_report_per_file)
+  {
+    fprintf(stderr,"WARNING: '-crs_groups' needs a summary report and is ignored with '-oxml'\n");
+    delete crsgroupcheck;
+    crsgroupcheck = 0;
+  }
+
   // maybe we are doing one summary report
 
   if (xml_output_file)
@@ -371,20 +597,108 @@ int main(int argc, char *argv[])
     CHAR crsdescription[512];
     strcpy(crsdescription, "not valid or not specified");
 
+    // maybe collect the bounding box for checking the tiling
+
+    if (tilecheck)
+    {
+      tilecheck->add(lasreadopener.get_file_name(), lasheader);
+    }
+
+    // maybe put the file into the tile grid
+
+    if (gridcheck)
+    {
+      gridcheck->add(lasreadopener.get_file_name(), lasheader);
+    }
+
+    LAScheck* lascheck = 0;
+
     if (lasheader->fails == 0)
     {
       // header was loaded. now parse and check.
 
-      LAScheck lascheck(lasheader);
+      lascheck = new LAScheck(lasheader);
+
+      if (gps_time_gap > 0.0)
+      {
+        lascheck->check_gps_time(gps_time_gap);
+      }
+      if (duplicates_memory)
+      {
+        lascheck->check_duplicates(duplicates_memory);
+      }
+      if (density_cell_size > 0.0)
+      {
+        lascheck->check_density(lasheader, density_cell_size, density_min);
+      }
+      if (histograms)
+      {
+        lascheck->check_histograms();
+      }
+      if (quantiles)
+      {
+        lascheck->check_quantiles(lasheader);
+      }
+      if (flightlines)
+      {
+        lascheck->check_flightlines(lasheader);
+      }
+      if (point_order)
+      {
+        lascheck->check_point_order(lasheader);
+      }
+      if (extra_bytes)
+      {
+        lascheck->check_extra_bytes();
+      }
+      if (pulses)
+      {
+        lascheck->check_pulses(lasheader);
+      }
 
       while (lasreader->read_point())
       {
-        lascheck.parse(&lasreader->point);
+        lascheck->parse(&lasreader->point);
       }
 
       // check header and points and get CRS description
 
-      lascheck.check(lasheader, crsdescription, no_CRS_fail);
+      lascheck->check(lasheader, crsdescription, no_CRS_fail, tile_size, tile_origin_x, tile_origin_y);
+
+      // maybe put the file into the group of its CRS
+
+      if (crsgroupcheck)
+      {
+        crsgroupcheck->add(lasreadopener.get_file_name(), lascheck->get_crs_identity(), crsdescription);
+      }
+
+      // check that the byte ranges of the file neither overlap nor leave gaps
+
+      LAYOUTcheck layoutcheck;
+      layoutcheck.check(lasreadopener.get_path(), lasheader);
+
+      // maybe scan the raw point records for zeroed or repeated blocks
+
+      if (record_blocks)
+      {
+        BLOCKcheck blockcheck;
+        blockcheck.check(lasreadopener.get_path(), lasheader);
+      }
+
+      // maybe write the density grid next to the input file
+
+      if (density_raster)
+      {
+        int len = strlen(lasreadopener.get_path());
+        CHAR* density_raster_file = (CHAR*)malloc(len + 9);
+        strcpy(density_raster_file, lasreadopener.get_path());
+        strcpy(&(density_raster_file[len-4]), "_density.asc");
+        if (!lascheck->write_density_raster(density_raster_file))
+        {
+          fprintf(stderr,"WARNING: could not write density raster '%s'\n", density_raster_file);
+        }
+        free(density_raster_file);
+      }
     }
 
     xmlwriter.write("CRS", crsdescription);
@@ -428,6 +742,19 @@ int main(int argc, char *argv[])
       num_pass++;
     }
 
+    // report statistics of optional checks
+
+    if (lascheck)
+    {
+      if (lascheck->has_statistics())
+      {
+        xmlwriter.beginsub("statistics");
+        lascheck->write_statistics(&xmlwriter);
+        xmlwriter.endsub("statistics");
+      }
+      delete lascheck;
+    }
+
     // end the report
 
     xmlwriter.end("report");
@@ -480,6 +807,30 @@ int main(int argc, char *argv[])
 
   if (!one_report_per_file)
   {
+    // maybe check the tiling of all files
+
+    if (tilecheck)
+    {
+      tilecheck->check(tile_size, tile_origin_x, tile_origin_y);
+      if (tilecheck->has_warnings()) total_pass |= VALIDATE_WARNING;
+    }
+
+    // maybe check the tile grid
+
+    if (gridcheck)
+    {
+      gridcheck->check();
+      if (gridcheck->has_warnings()) total_pass |= VALIDATE_WARNING;
+    }
+
+    // maybe check that all files are in the same CRS
+
+    if (crsgroupcheck)
+    {
+      crsgroupcheck->check();
+      if (crsgroupcheck->has_warnings()) total_pass |= VALIDATE_WARNING;
+    }
+
     // report the total verdict
 
     xmlwriter.begin("total");
@@ -489,6 +840,27 @@ int main(int argc, char *argv[])
     xmlwriter.write("warning", num_warning);
     xmlwriter.write("fail", num_fail);
     xmlwriter.endsub("details");
+    if (tilecheck)
+    {
+      xmlwriter.beginsub("tiling");
+      tilecheck->write(&xmlwriter);
+      xmlwriter.endsub("tiling");
+      delete tilecheck;
+    }
+    if (gridcheck)
+    {
+      xmlwriter.beginsub("grid");
+      gridcheck->write(&xmlwriter);
+      xmlwriter.endsub("grid");
+      delete gridcheck;
+    }
+    if (crsgroupcheck)
+    {
+      xmlwriter.beginsub("crs_groups");
+      crsgroupcheck->write(&xmlwriter);
+      xmlwriter.endsub("crs_groups");
+      delete crsgroupcheck;
+    }
     xmlwriter.end("total");
 
     // write which validator was used
@@ -95,18 +95,98 @@ PostBuild_Cmds=copy Debug\lasvalidate.exe ..\bin\lasvalidate.exe
 # PROP Default_Filter "cpp;c;cxx;rc;def;r;odl;idl;hpj;bat"
 # Begin Source File
 
+SOURCE=.\blockcheck.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\crscheck.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\crsdatabase.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\crsgroupcheck.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\crswkt.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\densitycheck.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\duplicatecheck.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\extrabytescheck.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\flightlinecheck.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\gpstimecheck.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\gridcheck.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\histogramcheck.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\lascheck.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\laskernels.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\laskernels_avx2.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\laskernels_avx512.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\laskernels_sse2.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\lasvalidate.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\layoutcheck.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\ordercheck.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\pulsecheck.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\quantilecheck.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\tilecheck.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\xmlwriter.cpp
 # End Source File
 # End Group
@@ -115,10 +195,58 @@ SOURCE=.\xmlwriter.cpp
 # PROP Default_Filter "h;hpp;hxx;hm;inl"
 # Begin Source File
 
+SOURCE=.\blockcheck.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\checkutility.hpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\crscheck.hpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\crsdatabase.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\crsgroupcheck.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\crswkt.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\densitycheck.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\duplicatecheck.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\extrabytescheck.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\flightlinecheck.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\gpstimecheck.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\gridcheck.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\histogramcheck.hpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\lascheck.hpp
 # End Source File
 # Begin Source File
@@ -155,6 +283,34 @@ SOURCE=..\..\lasread\inc\mydefs.hpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\laskernels.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\laskernels_generic.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\layoutcheck.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\ordercheck.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\pulsecheck.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\quantilecheck.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\tilecheck.hpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\xmlwriter.hpp
 # End Source File
 # End Group
@@ -0,0 +1,345 @@
+/*
+===============================================================================
+
+  FILE:  layoutcheck.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "layoutcheck.hpp"
+#include "checkutility.hpp"
+
+static int compare_ranges(const void* a, const void* b)
+{
+  const LAYOUTrange* ra = (const LAYOUTrange*)a;
+  const LAYOUTrange* rb = (const LAYOUTrange*)b;
+  if (ra->start < rb->start) return -1;
+  if (ra->start > rb->start) return 1;
+  if (ra->end < rb->end) return -1;
+  if (ra->end > rb->end) return 1;
+  return 0;
+}
+
+LAYOUTrange* LAYOUTcheck::add(const I64 start, const I64 end, const U32 type, const U32 index)
+{
+  if (number_of_ranges == allocated_ranges)
+  {
+    U32 allocate = (allocated_ranges ? 2*allocated_ranges : 16);
+    LAYOUTrange* bigger = (LAYOUTrange*)realloc(ranges, sizeof(LAYOUTrange)*allocate);
+    if (bigger == 0)
+    {
+      return 0;
+    }
+    ranges = bigger;
+    allocated_ranges = allocate;
+  }
+  LAYOUTrange* range = &ranges[number_of_ranges];
+  memset(range, 0, sizeof(LAYOUTrange));
+  range->start = start;
+  range->end = end;
+  range->type = type;
+  range->index = index;
+  number_of_ranges++;
+  return range;
+}
+
+I32 LAYOUTcheck::describe(CHAR* string, const LAYOUTrange* range) const
+{
+  switch (range->type)
+  {
+  case LAYOUTCHECK_HEADER:
+    return sprintf(string, "header");
+  case LAYOUTCHECK_VLR:
+    return sprintf(string, "VLR %u (%s %u)", range->index, range->user_id, range->record_id);
+  case LAYOUTCHECK_POINTS:
+    return sprintf(string, "point block");
+  case LAYOUTCHECK_WAVEFORM:
+    return sprintf(string, "waveform data packets");
+  case LAYOUTCHECK_SIGNATURE:
+    return sprintf(string, "point data start signature");
+  }
+  return sprintf(string, "EVLR %u (%s %u)", range->index, range->user_id, range->record_id);
+}
+
+BOOL LAYOUTcheck::check(const CHAR* file_name, LASheader* lasheader)
+{
+  CHAR note[512];
+  CHAR name1[64];
+  CHAR name2[64];
+  U32 i;
+
+  number_of_ranges = 0;
+
+  FILE* file = fopen(file_name, "rb");
+  if (file == 0)
+  {
+    return FALSE;
+  }
+  check_seek_end(file);
+  I64 file_size = check_tell(file);
+
+  // the header fields as stored in the file because the reader may have changed some of them
+
+  CHECKrawheader raw;
+  if (!raw.read(file))
+  {
+    fclose(file);
+    return FALSE;
+  }
+
+  // the header and the VLRs follow each other without gaps
+
+  add(0, raw.header_size, LAYOUTCHECK_HEADER);
+
+  I64 position = raw.header_size;
+  for (i = 0; i < raw.number_of_variable_length_records; i++)
+  {
+    U8 vlr[54];
+    U16 record_length_after_header = 0;
+    check_seek(file, position);
+    BOOL complete = (fread(vlr, 1, 54, file) == 54);
+    if (complete)
+    {
+      memcpy(&record_length_after_header, vlr + 20, 2);
+    }
+    LAYOUTrange* range = add(position, position + 54 + record_length_after_header, LAYOUTCHECK_VLR, i);
+    if (range == 0)
+    {
+      break;
+    }
+    if (!complete)
+    {
+      strcpy(range->user_id, "truncated");
+      break;
+    }
+    memcpy(range->user_id, vlr + 2, 16);
+    range->user_id[16] = '\0';
+    memcpy(&(range->record_id), vlr + 18, 2);
+    position = range->end;
+  }
+
+  // the EVLRs follow each other starting at the position given in the header
+
+  I64 waveform_start = (I64)raw.start_of_waveform_data_packet_record;
+  BOOL waveform_found = (waveform_start == 0);
+
+  position = (I64)raw.start_of_first_extended_variable_length_record;
+  for (i = 0; (i < raw.number_of_extended_variable_length_records) && position; i++)
+  {
+    U8 evlr[60];
+    I64 record_length_after_header = 0;
+    check_seek(file, position);
+    BOOL complete = (fread(evlr, 1, 60, file) == 60);
+    if (complete)
+    {
+      memcpy(&record_length_after_header, evlr + 20, 8);
+      if ((record_length_after_header < 0) || (record_length_after_header > file_size))
+      {
+        record_length_after_header = file_size;
+      }
+    }
+    LAYOUTrange* range = add(position, position + 60 + record_length_after_header, LAYOUTCHECK_EVLR, i);
+    if (range == 0)
+    {
+      break;
+    }
+    if (!complete)
+    {
+      strcpy(range->user_id, "truncated");
+      break;
+    }
+    memcpy(range->user_id, evlr + 2, 16);
+    range->user_id[16] = '\0';
+    memcpy(&(range->record_id), evlr + 18, 2);
+    if (position == waveform_start)
+    {
+      range->type = LAYOUTCHECK_WAVEFORM;
+      waveform_found = TRUE;
+    }
+    position = range->end;
+  }
+
+  // the waveform data packets of LAS 1.3 are an EVLR that the header does not count
+
+  if (!waveform_found)
+  {
+    U8 evlr[60];
+    I64 record_length_after_header = 0;
+    check_seek(file, waveform_start);
+    if (fread(evlr, 1, 60, file) == 60)
+    {
+      memcpy(&record_length_after_header, evlr + 20, 8);
+      if ((record_length_after_header < 0) || (record_length_after_header > file_size))
+      {
+        record_length_after_header = file_size;
+      }
+    }
+    add(waveform_start, waveform_start + 60 + record_length_after_header, LAYOUTCHECK_WAVEFORM);
+  }
+
+  // the point data start signature of LAS 1.0 right in front of the points
+
+  if (raw.offset_to_point_data >= (U32)raw.header_size + 2)
+  {
+    U8 signature[2];
+    check_seek(file, raw.offset_to_point_data - 2);
+    if ((fread(signature, 1, 2, file) == 2) && (signature[0] == 0xDD) && (signature[1] == 0xCC))
+    {
+      add(raw.offset_to_point_data - 2, raw.offset_to_point_data, LAYOUTCHECK_SIGNATURE);
+    }
+  }
+  fclose(file);
+
+  // compressed points run up to whatever follows them or to the end of the file
+
+  I64 points_end;
+  if (raw.point_data_format & 0xC0)
+  {
+    points_end = file_size;
+    for (i = 0; i < number_of_ranges; i++)
+    {
+      if ((ranges[i].start > (I64)raw.offset_to_point_data) && (ranges[i].start < points_end))
+      {
+        points_end = ranges[i].start;
+      }
+    }
+  }
+  else
+  {
+    points_end = (I64)raw.offset_to_point_data + (I64)raw.number_of_point_records * raw.point_data_record_length;
+  }
+  if (points_end > (I64)raw.offset_to_point_data)
+  {
+    add(raw.offset_to_point_data, points_end, LAYOUTCHECK_POINTS);
+  }
+
+  // sweep over the ranges sorted by start
+
+  qsort(ranges, number_of_ranges, sizeof(LAYOUTrange), compare_ranges);
+
+  U32 number_of_overlaps = 0;
+  U32 number_of_gaps = 0;
+  U32 number_of_outside = 0;
+  const LAYOUTrange* covering = 0;
+  I64 covered_end = 0;
+  for (i = 0; i < number_of_ranges; i++)
+  {
+    const LAYOUTrange* range = &ranges[i];
+    if (covering && (range->start < covered_end))
+    {
+      if (number_of_overlaps < LAYOUTCHECK_MAX_REPORTS)
+      {
+        describe(name1, range);
+        describe(name2, covering);
+#ifdef _WIN32
+        sprintf(note, "%s starting at byte %I64d overlaps %s by %I64d bytes", name1, range->start, name2, ((range->end < covered_end) ? range->end : covered_end) - range->start);
+#else
+        sprintf(note, "%s starting at byte %lld overlaps %s by %lld bytes", name1, range->start, name2, ((range->end < covered_end) ? range->end : covered_end) - range->start);
+#endif
+        lasheader->add_fail("file layout", note);
+      }
+      number_of_overlaps++;
+    }
+    else if (covering && (range->start > covered_end))
+    {
+      if (number_of_gaps < LAYOUTCHECK_MAX_REPORTS)
+      {
+        describe(name1, covering);
+        describe(name2, range);
+#ifdef _WIN32
+        sprintf(note, "%I64d bytes between %s and %s are not part of any record", range->start - covered_end, name1, name2);
+#else
+        sprintf(note, "%lld bytes between %s and %s are not part of any record", range->start - covered_end, name1, name2);
+#endif
+        lasheader->add_warning("file layout", note);
+      }
+      number_of_gaps++;
+    }
+    if (range->end > file_size)
+    {
+      if (number_of_outside < LAYOUTCHECK_MAX_REPORTS)
+      {
+        describe(name1, range);
+#ifdef _WIN32
+        sprintf(note, "%s ends at byte %I64d but the file has only %I64d bytes", name1, range->end, file_size);
+#else
+        sprintf(note, "%s ends at byte %lld but the file has only %lld bytes", name1, range->end, file_size);
+#endif
+        lasheader->add_fail("file layout", note);
+      }
+      number_of_outside++;
+    }
+    if ((covering == 0) || (range->end > covered_end))
+    {
+      covering = range;
+      covered_end = range->end;
+    }
+  }
+  if (covering && (covered_end < file_size))
+  {
+    describe(name1, covering);
+#ifdef _WIN32
+    sprintf(note, "%I64d bytes after %s at the end of the file are not part of any record", file_size - covered_end, name1);
+#else
+    sprintf(note, "%lld bytes after %s at the end of the file are not part of any record", file_size - covered_end, name1);
+#endif
+    lasheader->add_warning("file layout", note);
+  }
+
+  // summarize what was not reported individually
+
+  if (number_of_overlaps > LAYOUTCHECK_MAX_REPORTS)
+  {
+    sprintf(note, "%u more overlapping ranges", number_of_overlaps - LAYOUTCHECK_MAX_REPORTS);
+    lasheader->add_fail("file layout", note);
+  }
+  if (number_of_gaps > LAYOUTCHECK_MAX_REPORTS)
+  {
+    sprintf(note, "%u more gaps between ranges", number_of_gaps - LAYOUTCHECK_MAX_REPORTS);
+    lasheader->add_warning("file layout", note);
+  }
+  if (number_of_outside > LAYOUTCHECK_MAX_REPORTS)
+  {
+    sprintf(note, "%u more ranges beyond the end of the file", number_of_outside - LAYOUTCHECK_MAX_REPORTS);
+    lasheader->add_fail("file layout", note);
+  }
+  return TRUE;
+}
+
+LAYOUTcheck::LAYOUTcheck()
+{
+  number_of_ranges = 0;
+  allocated_ranges = 0;
+  ranges = 0;
+}
+
+LAYOUTcheck::~LAYOUTcheck()
+{
+  if (ranges) free(ranges);
+}
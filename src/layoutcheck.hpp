@@ -0,0 +1,82 @@
+/*
+===============================================================================
+
+  FILE:  layoutcheck.hpp
+
+  CONTENTS:
+
+    Checks the byte layout of a LAS file. The header, every VLR, the point
+    block, the waveform data packets, and every EVLR each cover a range of
+    bytes that follows from the header fields and from the 54 and 60 byte
+    headers of the VLRs and EVLRs. Only these headers are read directly from
+    the file and their payloads are skipped. The ranges are sorted by start
+    and swept once to find overlaps, gaps, and ranges that reach beyond the
+    end of the file. The two byte point data start signature of LAS 1.0 that
+    many writers still put in front of the points is a range of its own.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    19 October 2026 -- created for finding structural corruption before reading points
+
+===============================================================================
+*/
+#ifndef LAYOUT_CHECK_HPP
+#define LAYOUT_CHECK_HPP
+
+#include <stdio.h>
+
+#include "lasheader.hpp"
+
+#define LAYOUTCHECK_HEADER    0
+#define LAYOUTCHECK_VLR       1
+#define LAYOUTCHECK_POINTS    2
+#define LAYOUTCHECK_WAVEFORM  3
+#define LAYOUTCHECK_EVLR      4
+#define LAYOUTCHECK_SIGNATURE 5
+
+#define LAYOUTCHECK_MAX_REPORTS 5
+
+class LAYOUTrange
+{
+public:
+  I64 start;
+  I64 end;
+  U32 type;
+  U32 index;
+  U16 record_id;
+  CHAR user_id[17];
+};
+
+class LAYOUTcheck
+{
+public:
+
+  BOOL check(const CHAR* file_name, LASheader* lasheader);
+
+  LAYOUTcheck();
+  ~LAYOUTcheck();
+
+private:
+  U32 number_of_ranges;
+  U32 allocated_ranges;
+  LAYOUTrange* ranges;
+  LAYOUTrange* add(const I64 start, const I64 end, const U32 type, const U32 index=0);
+  I32 describe(CHAR* string, const LAYOUTrange* range) const;
+};
+
+#endif
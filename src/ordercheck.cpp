@@ -0,0 +1,285 @@
+/*
+===============================================================================
+
+  FILE:  ordercheck.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ordercheck.hpp"
+#include "checkutility.hpp"
+
+// the finest grid is chosen so that a cell holds about this many points
+
+#define ORDERCHECK_POINTS_PER_CELL 256
+
+// a spatially sorted file enters an occupied cell no more than this many times
+
+#define ORDERCHECK_MAX_RUNS_PER_CELL 4.0
+
+// a time sorted file has no more than this fraction of time stamps going back
+
+#define ORDERCHECK_MAX_STEPS_BACK 0.01
+
+// a scattered file changes the cell of the finest grid with more than this fraction of points
+
+#define ORDERCHECK_MAX_CHANGES 0.5
+
+static const CHAR* order_names[5] = { "unknown", "spatially sorted", "time sorted", "locally coherent", "scattered" };
+
+// spreads the lower 16 bits so that a zero bit sits between every two of them
+
+static inline U32 spread_bits(U32 v)
+{
+  v &= 0x0000FFFF;
+  v = (v | (v << 8)) & 0x00FF00FF;
+  v = (v | (v << 4)) & 0x0F0F0F0F;
+  v = (v | (v << 2)) & 0x33333333;
+  v = (v | (v << 1)) & 0x55555555;
+  return v;
+}
+
+void ORDERcheck::parse(const LASpoint* laspoint)
+{
+  if (occupied == 0)
+  {
+    return;
+  }
+  I32 col = (I32)((laspoint->X - origin_X) * cell_factor_X);
+  I32 row = (I32)((laspoint->Y - origin_Y) * cell_factor_Y);
+  if (col < 0) col = 0;
+  else if (col >= (I32)cells_per_side) col = cells_per_side - 1;
+  if (row < 0) row = 0;
+  else if (row >= (I32)cells_per_side) row = cells_per_side - 1;
+  U32 code = spread_bits(col) | (spread_bits(row) << 1);
+
+  // the highest differing bit pair tells the finest level at which both points still share a cell
+
+  U32 diff = code ^ last_code;
+  if (diff && number_of_points)
+  {
+    U32 shift = 0;
+    while (diff > 3)
+    {
+      diff >>= 2;
+      shift++;
+    }
+    number_of_changes[shift]++;
+  }
+  last_code = code;
+  occupied[code >> 3] |= (1 << (code & 7));
+
+  if (has_gps_time)
+  {
+    if ((number_of_points != 0) && (laspoint->gps_time < last_gps_time))
+    {
+      number_of_time_steps_back++;
+    }
+    last_gps_time = laspoint->gps_time;
+  }
+  number_of_points++;
+}
+
+void ORDERcheck::classify()
+{
+  U32 l, code;
+  U32 last_parent[ORDERCHECK_MAX_LEVEL+1];
+
+  // the occupied cells of all levels from the occupied cells of the finest level in Morton order
+
+  for (l = 0; l <= level; l++)
+  {
+    occupied_cells[l] = 0;
+    runs_per_cell[l] = 0.0;
+  }
+  U32 number_of_cells = cells_per_side * cells_per_side;
+  for (code = 0; code < number_of_cells; code++)
+  {
+    if (occupied[code >> 3] == 0)
+    {
+      code |= 7;
+      continue;
+    }
+    if (occupied[code >> 3] & (1 << (code & 7)))
+    {
+      for (l = 1; l <= level; l++)
+      {
+        U32 parent = (code >> (2*(level - l)));
+        if ((occupied_cells[l] == 0) || (parent != last_parent[l]))
+        {
+          occupied_cells[l]++;
+          last_parent[l] = parent;
+        }
+      }
+    }
+  }
+
+  // the points change cell at level l whenever the codes differ above the lowest 2*(level - l) bits
+
+  for (l = 1; l <= level; l++)
+  {
+    I64 number_of_runs = 1;
+    for (U32 shift = level - l; shift < level; shift++)
+    {
+      number_of_runs += number_of_changes[shift];
+    }
+    runs_per_cell[l] = (occupied_cells[l] ? (F64)number_of_runs / occupied_cells[l] : 0.0);
+  }
+
+  number_of_cell_changes = 0;
+  for (U32 shift = 0; shift < level; shift++)
+  {
+    number_of_cell_changes += number_of_changes[shift];
+  }
+
+  // spatially sorted down to the finest level with at least 4 by 4 cells that is visited cell by cell
+
+  sorted_level = 0;
+  for (l = level; l >= 2; l--)
+  {
+    if ((occupied_cells[l] > 1) && (runs_per_cell[l] <= ORDERCHECK_MAX_RUNS_PER_CELL))
+    {
+      sorted_level = l;
+      break;
+    }
+  }
+
+  if ((number_of_points < 2) || (occupied_cells[level] < 2))
+  {
+    order = ORDERCHECK_UNKNOWN;
+  }
+  else if (sorted_level)
+  {
+    order = ORDERCHECK_SPATIALLY_SORTED;
+  }
+  else if (((F64)number_of_cell_changes / (number_of_points - 1)) > ORDERCHECK_MAX_CHANGES)
+  {
+    order = ORDERCHECK_SCATTERED;
+  }
+  else if (has_gps_time && (((F64)number_of_time_steps_back / (number_of_points - 1)) <= ORDERCHECK_MAX_STEPS_BACK))
+  {
+    order = ORDERCHECK_TIME_SORTED;
+  }
+  else
+  {
+    order = ORDERCHECK_LOCALLY_COHERENT;
+  }
+}
+
+void ORDERcheck::check(LASheader* lasheader)
+{
+  CHAR note[512];
+
+  if (occupied == 0)
+  {
+    return;
+  }
+
+  classify();
+
+  if (order == ORDERCHECK_SCATTERED)
+  {
+    sprintf(note, "points are scattered: %.1f%% of consecutive points lie in different cells of a %u by %u grid", 100.0*number_of_cell_changes/(number_of_points - 1), cells_per_side, cells_per_side);
+    lasheader->add_warning("point order", note);
+  }
+}
+
+void ORDERcheck::write_statistics(XMLwriter* xmlwriter) const
+{
+  CHAR value[512];
+
+  if ((occupied == 0) || (number_of_points < 2))
+  {
+    return;
+  }
+
+  xmlwriter->write("point_order", order_names[order]);
+  if (sorted_level)
+  {
+    sprintf(value, "%u by %u", 1 << sorted_level, 1 << sorted_level);
+    xmlwriter->write("order_sorted_grid", value);
+  }
+
+  // the runs per occupied cell as 'cells per side:runs' pairs
+
+  I32 len = 0;
+  for (U32 l = 1; l <= level; l++)
+  {
+    len += sprintf(&value[len], (len ? " %u:%.2f" : "%u:%.2f"), 1 << l, runs_per_cell[l]);
+  }
+  xmlwriter->write("order_runs_per_cell", value);
+  if (has_gps_time)
+  {
+    sprintf(value, "%.2f%%", 100.0*number_of_time_steps_back/(number_of_points - 1));
+    xmlwriter->write("order_gps_time_steps_back", value);
+  }
+}
+
+ORDERcheck::ORDERcheck(const LASheader* lasheader)
+{
+  has_gps_time = format_has_gps_time(lasheader->point_data_format);
+
+  // pick the finest level of the grid from the number of points in the header
+
+  I64 npoints = (I64)lasheader->number_of_point_records;
+  level = 2;
+  while ((level < ORDERCHECK_MAX_LEVEL) && (((I64)1 << (2*level)) * ORDERCHECK_POINTS_PER_CELL < npoints))
+  {
+    level++;
+  }
+  cells_per_side = (1 << level);
+
+  // the cell of a point is computed directly from its integer coordinates
+
+  origin_X = (lasheader->min_x - lasheader->x_offset) / lasheader->x_scale_factor;
+  origin_Y = (lasheader->min_y - lasheader->y_offset) / lasheader->y_scale_factor;
+  F64 range_X = (lasheader->max_x - lasheader->min_x) / lasheader->x_scale_factor;
+  F64 range_Y = (lasheader->max_y - lasheader->min_y) / lasheader->y_scale_factor;
+  cell_factor_X = (range_X > 0.0 ? cells_per_side / range_X : 0.0);
+  cell_factor_Y = (range_Y > 0.0 ? cells_per_side / range_Y : 0.0);
+
+  occupied = (U8*)calloc(((cells_per_side * cells_per_side) + 7) / 8, 1);
+
+  number_of_points = 0;
+  memset(number_of_changes, 0, sizeof(number_of_changes));
+  number_of_time_steps_back = 0;
+  last_code = 0;
+  last_gps_time = 0.0;
+  order = ORDERCHECK_UNKNOWN;
+  sorted_level = 0;
+  number_of_cell_changes = 0;
+  memset(occupied_cells, 0, sizeof(occupied_cells));
+  memset(runs_per_cell, 0, sizeof(runs_per_cell));
+}
+
+ORDERcheck::~ORDERcheck()
+{
+  if (occupied) free(occupied);
+}
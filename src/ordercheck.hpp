@@ -0,0 +1,94 @@
+/*
+===============================================================================
+
+  FILE:  ordercheck.hpp
+
+  CONTENTS:
+
+    Measures how spatially coherent the order of the points in a file is. The
+    bounding box is split into a grid of 2^level by 2^level cells and each
+    point gets the Morton code of its cell. Because the codes of the cells of
+    a coarser quadtree level are prefixes of these codes, the highest bit in
+    which the codes of consecutive points differ tells at which levels the
+    points change cell, so one pass counts the runs of points in the same
+    cell for all levels at once. A file sorted along a space filling curve
+    visits each cell of the levels above its sort granularity exactly once,
+    a file in acquisition order crosses every cell once per scan line, and a
+    shuffled file changes the cell with almost every point. Together with
+    the order of the GPS time stamps this classifies the file as spatially
+    sorted, time sorted, locally coherent (neither but without jumps), or
+    scattered.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    19 October 2026 -- created for finding files that should be run through lassort
+
+===============================================================================
+*/
+#ifndef ORDER_CHECK_HPP
+#define ORDER_CHECK_HPP
+
+#include "lasheader.hpp"
+#include "laspoint.hpp"
+
+#include "xmlwriter.hpp"
+
+#define ORDERCHECK_MAX_LEVEL 10
+
+#define ORDERCHECK_UNKNOWN          0
+#define ORDERCHECK_SPATIALLY_SORTED 1
+#define ORDERCHECK_TIME_SORTED      2
+#define ORDERCHECK_LOCALLY_COHERENT 3
+#define ORDERCHECK_SCATTERED        4
+
+class ORDERcheck
+{
+public:
+
+  void parse(const LASpoint* laspoint);
+  void check(LASheader* lasheader);
+  void write_statistics(XMLwriter* xmlwriter) const;
+
+  ORDERcheck(const LASheader* lasheader);
+  ~ORDERcheck();
+
+private:
+  BOOL has_gps_time;
+  U32 level;
+  U32 cells_per_side;
+  F64 origin_X, origin_Y;
+  F64 cell_factor_X, cell_factor_Y;
+  U8* occupied;
+
+  I64 number_of_points;
+  I64 number_of_changes[ORDERCHECK_MAX_LEVEL];
+  I64 number_of_time_steps_back;
+  U32 last_code;
+  F64 last_gps_time;
+
+  // the results for the levels 1 to level
+
+  U32 order;
+  U32 sorted_level;
+  I64 number_of_cell_changes;
+  U32 occupied_cells[ORDERCHECK_MAX_LEVEL+1];
+  F64 runs_per_cell[ORDERCHECK_MAX_LEVEL+1];
+  void classify();
+};
+
+#endif
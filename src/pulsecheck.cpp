@@ -0,0 +1,237 @@
+/*
+===============================================================================
+
+  FILE:  pulsecheck.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <string.h>
+
+#include "pulsecheck.hpp"
+
+void PULSEcheck::close(PULSEentry* entry)
+{
+  if (!entry->open)
+  {
+    return;
+  }
+  U32 missing = 0;
+  for (U32 r = 1; r <= entry->number_of_returns; r++)
+  {
+    if ((entry->returns & (1 << r)) == 0)
+    {
+      missing++;
+    }
+  }
+  number_of_pulses++;
+  if (missing)
+  {
+    number_of_incomplete_pulses++;
+    number_of_missing_returns += missing;
+  }
+  if (entry->split)
+  {
+    number_of_split_pulses++;
+  }
+  entry->open = FALSE;
+}
+
+void PULSEcheck::close_all()
+{
+  for (U32 i = 0; i < PULSECHECK_WINDOW; i++)
+  {
+    close(&(window[i]));
+  }
+}
+
+void PULSEcheck::parse(const LASpoint* laspoint)
+{
+  U32 return_number;
+  U32 number_of_returns;
+  if (laspoint->extended_point_type)
+  {
+    return_number = laspoint->extended_return_number;
+    number_of_returns = laspoint->extended_number_of_returns_of_given_pulse;
+  }
+  else
+  {
+    return_number = laspoint->return_number;
+    number_of_returns = laspoint->number_of_returns_of_given_pulse;
+  }
+
+  // almost always the point belongs to the same pulse as the point before
+
+  PULSEentry* entry = &(window[current]);
+  if (!entry->open || (entry->gps_time != laspoint->gps_time) || (entry->point_source_ID != laspoint->point_source_ID))
+  {
+    // otherwise it may continue a pulse that is still open
+
+    U32 i;
+    for (i = 0; i < PULSECHECK_WINDOW; i++)
+    {
+      if (window[i].open && (window[i].gps_time == laspoint->gps_time) && (window[i].point_source_ID == laspoint->point_source_ID))
+      {
+        break;
+      }
+    }
+    if (i < PULSECHECK_WINDOW)
+    {
+      window[i].split = TRUE;
+      current = i;
+    }
+    else
+    {
+      // or it starts a new pulse that replaces the oldest one
+
+      current = oldest;
+      oldest = (oldest + 1) % PULSECHECK_WINDOW;
+      close(&(window[current]));
+      window[current].gps_time = laspoint->gps_time;
+      window[current].point_source_ID = laspoint->point_source_ID;
+      window[current].number_of_returns = (U8)number_of_returns;
+      window[current].split = FALSE;
+      window[current].open = TRUE;
+      window[current].returns = 0;
+    }
+    entry = &(window[current]);
+  }
+
+  if (number_of_returns != entry->number_of_returns)
+  {
+    number_of_inconsistent_points++;
+    if (number_of_returns > entry->number_of_returns)
+    {
+      entry->number_of_returns = (U8)number_of_returns;
+    }
+  }
+
+  // return numbers of 0 are reported by the inventory already
+
+  if (return_number)
+  {
+    U16 bit = (U16)(1 << return_number);
+    if (entry->returns & bit)
+    {
+      number_of_duplicate_returns++;
+    }
+    entry->returns |= bit;
+  }
+}
+
+void PULSEcheck::check(LASheader* lasheader)
+{
+  CHAR note[512];
+
+  close_all();
+
+  if (number_of_missing_returns)
+  {
+#ifdef _WIN32
+    sprintf(note, "%I64d of %I64d pulses miss a total of %I64d returns", number_of_incomplete_pulses, number_of_pulses, number_of_missing_returns);
+#else
+    sprintf(note, "%lld of %lld pulses miss a total of %lld returns", number_of_incomplete_pulses, number_of_pulses, number_of_missing_returns);
+#endif
+    lasheader->add_warning("pulses", note);
+  }
+  if (number_of_duplicate_returns)
+  {
+#ifdef _WIN32
+    sprintf(note, "there are %I64d points with the same return number as another point of their pulse", number_of_duplicate_returns);
+#else
+    sprintf(note, "there are %lld points with the same return number as another point of their pulse", number_of_duplicate_returns);
+#endif
+    lasheader->add_warning("pulses", note);
+  }
+  if (number_of_split_pulses)
+  {
+#ifdef _WIN32
+    sprintf(note, "the returns of %I64d pulses do not follow each other in the file", number_of_split_pulses);
+#else
+    sprintf(note, "the returns of %lld pulses do not follow each other in the file", number_of_split_pulses);
+#endif
+    lasheader->add_warning("pulses", note);
+  }
+  if (number_of_inconsistent_points)
+  {
+#ifdef _WIN32
+    sprintf(note, "there are %I64d points with a different number of returns than another point of their pulse", number_of_inconsistent_points);
+#else
+    sprintf(note, "there are %lld points with a different number of returns than another point of their pulse", number_of_inconsistent_points);
+#endif
+    lasheader->add_warning("pulses", note);
+  }
+}
+
+void PULSEcheck::write_statistics(XMLwriter* xmlwriter) const
+{
+  CHAR value[64];
+
+#ifdef _WIN32
+  sprintf(value, "%I64d", number_of_pulses);
+  xmlwriter->write("number_of_pulses", value);
+  sprintf(value, "%I64d", number_of_incomplete_pulses);
+  xmlwriter->write("pulses_incomplete", value);
+  sprintf(value, "%I64d", number_of_missing_returns);
+  xmlwriter->write("pulses_missing_returns", value);
+  sprintf(value, "%I64d", number_of_duplicate_returns);
+  xmlwriter->write("pulses_duplicate_returns", value);
+  sprintf(value, "%I64d", number_of_split_pulses);
+  xmlwriter->write("pulses_split", value);
+  sprintf(value, "%I64d", number_of_inconsistent_points);
+  xmlwriter->write("pulses_inconsistent_points", value);
+#else
+  sprintf(value, "%lld", number_of_pulses);
+  xmlwriter->write("number_of_pulses", value);
+  sprintf(value, "%lld", number_of_incomplete_pulses);
+  xmlwriter->write("pulses_incomplete", value);
+  sprintf(value, "%lld", number_of_missing_returns);
+  xmlwriter->write("pulses_missing_returns", value);
+  sprintf(value, "%lld", number_of_duplicate_returns);
+  xmlwriter->write("pulses_duplicate_returns", value);
+  sprintf(value, "%lld", number_of_split_pulses);
+  xmlwriter->write("pulses_split", value);
+  sprintf(value, "%lld", number_of_inconsistent_points);
+  xmlwriter->write("pulses_inconsistent_points", value);
+#endif
+}
+
+PULSEcheck::PULSEcheck()
+{
+  current = 0;
+  oldest = 0;
+  memset(window, 0, sizeof(window));
+  number_of_pulses = 0;
+  number_of_incomplete_pulses = 0;
+  number_of_missing_returns = 0;
+  number_of_duplicate_returns = 0;
+  number_of_split_pulses = 0;
+  number_of_inconsistent_points = 0;
+}
+
+PULSEcheck::~PULSEcheck()
+{
+}
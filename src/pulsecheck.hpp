@@ -0,0 +1,87 @@
+/*
+===============================================================================
+
+  FILE:  pulsecheck.hpp
+
+  CONTENTS:
+
+    Checks that the returns of each laser pulse form a complete sequence from
+    1 to their number of returns. The returns of one pulse share GPS time and
+    point source ID and are expected to follow each other in the file. The
+    check streams over the points without sorting and keeps only the last
+    PULSECHECK_WINDOW pulses open. A pulse that shows up again while it is
+    still open is counted as split and its returns are merged. A pulse is
+    closed when it drops out of the window and only then its missing returns
+    are counted. Duplicate return numbers and points of one pulse with a
+    different number of returns are counted as they arrive. Files without
+    GPS time are not checked.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    19 October 2026 -- created for checking the integrity of the returns of each pulse
+
+===============================================================================
+*/
+#ifndef PULSE_CHECK_HPP
+#define PULSE_CHECK_HPP
+
+#include "lasheader.hpp"
+#include "laspoint.hpp"
+
+#include "xmlwriter.hpp"
+
+#define PULSECHECK_WINDOW 8
+
+class PULSEentry
+{
+public:
+  F64 gps_time;
+  U16 point_source_ID;
+  U8 number_of_returns;
+  BOOL split;
+  BOOL open;
+  U16 returns;
+};
+
+class PULSEcheck
+{
+public:
+
+  void parse(const LASpoint* laspoint);
+  void check(LASheader* lasheader);
+  void write_statistics(XMLwriter* xmlwriter) const;
+
+  PULSEcheck();
+  ~PULSEcheck();
+
+private:
+  U32 current;
+  U32 oldest;
+  PULSEentry window[PULSECHECK_WINDOW];
+
+  I64 number_of_pulses;
+  I64 number_of_incomplete_pulses;
+  I64 number_of_missing_returns;
+  I64 number_of_duplicate_returns;
+  I64 number_of_split_pulses;
+  I64 number_of_inconsistent_points;
+  void close(PULSEentry* entry);
+  void close_all();
+};
+
+#endif
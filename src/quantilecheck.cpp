@@ -0,0 +1,498 @@
+/*
+===============================================================================
+
+  FILE:  quantilecheck.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "quantilecheck.hpp"
+#include "checkutility.hpp"
+
+// a tail is heavy when it reaches further beyond the 0.1 or 99.9 percentile
+// than the 1 to 99 percentiles are apart from each other
+
+#define QUANTILECHECK_TAIL_FACTOR 1.0
+#define QUANTILECHECK_MIN_POINTS 1000
+
+#define QUANTILECHECK_NUMBER 5
+
+static const F64 quantile_fractions[QUANTILECHECK_NUMBER] = { 0.001, 0.01, 0.5, 0.99, 0.999 };
+static const CHAR* quantile_names[QUANTILECHECK_NUMBER] = { "0.1%", "1%", "50%", "99%", "99.9%" };
+
+class QUANTILEitem
+{
+public:
+  F64 value;
+  I64 weight;
+};
+
+static int compare_values(const void* a, const void* b)
+{
+  F64 va = *((const F64*)a);
+  F64 vb = *((const F64*)b);
+  if (va < vb) return -1;
+  if (va > vb) return 1;
+  return 0;
+}
+
+static int compare_items(const void* a, const void* b)
+{
+  return compare_values(&(((const QUANTILEitem*)a)->value), &(((const QUANTILEitem*)b)->value));
+}
+
+// sorts a level in place. qsort pays a function call per comparison, which
+// was most of the cost per point, so this is a plain quicksort with an
+// explicit stack that hands short ranges to insertion sort.
+
+static void sort_values(F64* values, U32 size)
+{
+  I32 stack[128];
+  I32 top = 0;
+  stack[top++] = 0;
+  stack[top++] = (I32)size - 1;
+  while (top)
+  {
+    I32 hi = stack[--top];
+    I32 lo = stack[--top];
+    while ((hi - lo) >= 16)
+    {
+      I32 mid = lo + ((hi - lo) >> 1);
+      F64 t;
+      if (values[mid] < values[lo]) { t = values[mid]; values[mid] = values[lo]; values[lo] = t; }
+      if (values[hi] < values[lo]) { t = values[hi]; values[hi] = values[lo]; values[lo] = t; }
+      if (values[hi] < values[mid]) { t = values[hi]; values[hi] = values[mid]; values[mid] = t; }
+      F64 pivot = values[mid];
+      I32 i = lo;
+      I32 j = hi;
+      while (i <= j)
+      {
+        while (values[i] < pivot) i++;
+        while (pivot < values[j]) j--;
+        if (i <= j)
+        {
+          t = values[i]; values[i] = values[j]; values[j] = t;
+          i++;
+          j--;
+        }
+      }
+      // push the larger part and keep going on the smaller one
+      if ((j - lo) > (hi - i))
+      {
+        stack[top++] = lo;
+        stack[top++] = j;
+        lo = i;
+      }
+      else
+      {
+        stack[top++] = i;
+        stack[top++] = hi;
+        hi = j;
+      }
+    }
+    for (I32 i = lo + 1; i <= hi; i++)
+    {
+      F64 v = values[i];
+      I32 j = i - 1;
+      while ((j >= lo) && (v < values[j]))
+      {
+        values[j + 1] = values[j];
+        j--;
+      }
+      values[j + 1] = v;
+    }
+  }
+}
+
+// the capacity of a level shrinks by 2/3 for every level below the top level
+// but never below k/8. it only changes when a level is added, so it is cached.
+
+void QUANTILEsketch::set_capacities()
+{
+  F64 capacity = QUANTILESKETCH_K;
+  for (I32 h = (I32)number_of_levels - 1; h >= 0; h--)
+  {
+    U32 c = (U32)ceil(capacity);
+    level_capacity[h] = (c < QUANTILESKETCH_MIN_CAPACITY ? QUANTILESKETCH_MIN_CAPACITY : c);
+    capacity = capacity * 2.0 / 3.0;
+  }
+}
+
+// merges number values that are stride apart into the sorted values of a
+// level. both runs are sorted, so filling from the back needs no extra space.
+
+static void merge_values(F64* values, const U32 size, const F64* more, const U32 stride, const U32 number)
+{
+  I32 i = (I32)size - 1;
+  I32 j = (I32)number - 1;
+  I32 k = (I32)(size + number) - 1;
+  while (j >= 0)
+  {
+    if ((i >= 0) && (values[i] > more[j*stride]))
+    {
+      values[k--] = values[i--];
+    }
+    else
+    {
+      values[k--] = more[j*stride];
+      j--;
+    }
+  }
+}
+
+// every level gets a buffer of 2k values up front. a level below its capacity
+// (at most k) receives at most half of a buffer from the level below before it
+// is compressed itself, so no level ever needs to grow.
+
+void QUANTILEsketch::add_level()
+{
+  levels[number_of_levels] = (F64*)malloc(sizeof(F64)*QUANTILESKETCH_BUFFER);
+  level_size[number_of_levels] = 0;
+  number_of_levels++;
+  set_capacities();
+}
+
+BOOL QUANTILEsketch::push(const U32 level, const F64 value)
+{
+  if ((levels[level] == 0) || (level_size[level] == QUANTILESKETCH_BUFFER))
+  {
+    return FALSE;
+  }
+  levels[level][level_size[level]] = value;
+  level_size[level]++;
+  return TRUE;
+}
+
+BOOL QUANTILEsketch::push_sorted(const U32 level, const F64* values, const U32 stride, U32 number)
+{
+  if (levels[level] == 0)
+  {
+    return FALSE;
+  }
+  if ((level_size[level] + number) > QUANTILESKETCH_BUFFER)
+  {
+    number = QUANTILESKETCH_BUFFER - level_size[level];
+  }
+  merge_values(levels[level], level_size[level], values, stride, number);
+  level_size[level] += number;
+  return TRUE;
+}
+
+// a full level is sorted and every other item moves up with twice the weight.
+// with an odd number of items the smallest one stays so that no weight is lost.
+// only level 0 collects values in arbitrary order. all levels above it are
+// kept sorted by merging, so only level 0 ever needs a real sort.
+
+void QUANTILEsketch::compress()
+{
+  for (U32 h = 0; h < number_of_levels; h++)
+  {
+    if (level_size[h] < level_capacity[h])
+    {
+      continue;
+    }
+    if ((h + 1) == number_of_levels)
+    {
+      if (number_of_levels == QUANTILESKETCH_MAX_LEVELS)
+      {
+        return;
+      }
+      add_level();
+    }
+    F64* values = levels[h];
+    U32 size = level_size[h];
+    if (h == 0)
+    {
+      sort_values(values, size);
+    }
+    random ^= (random << 13);
+    random ^= (random >> 17);
+    random ^= (random << 5);
+    U32 start = (size & 1);
+    push_sorted(h + 1, values + start + (random & 1), 2, (size - start) / 2);
+    level_size[h] = start;
+  }
+}
+
+void QUANTILEsketch::add(const F64 value)
+{
+  if (count == 0)
+  {
+    min = max = value;
+  }
+  else if (value < min)
+  {
+    min = value;
+  }
+  else if (value > max)
+  {
+    max = value;
+  }
+  count++;
+  if (!push(0, value))
+  {
+    return;
+  }
+  if (level_size[0] >= level_capacity[0])
+  {
+    compress();
+  }
+}
+
+// the levels are merged from the bottom up and compressed after each one so
+// that no level receives more than its buffer holds
+
+void QUANTILEsketch::merge(const QUANTILEsketch* sketch)
+{
+  if (sketch->count == 0)
+  {
+    return;
+  }
+  if (count == 0)
+  {
+    min = sketch->min;
+    max = sketch->max;
+  }
+  else
+  {
+    if (sketch->min < min) min = sketch->min;
+    if (sketch->max > max) max = sketch->max;
+  }
+  count += sketch->count;
+  while (number_of_levels < sketch->number_of_levels)
+  {
+    add_level();
+  }
+  for (U32 i = 0; i < sketch->level_size[0]; i++)
+  {
+    if (level_size[0] == QUANTILESKETCH_BUFFER)
+    {
+      compress();
+    }
+    push(0, sketch->levels[0][i]);
+  }
+  compress();
+  for (U32 h = 1; h < sketch->number_of_levels; h++)
+  {
+    push_sorted(h, sketch->levels[h], 1, sketch->level_size[h]);
+    compress();
+  }
+}
+
+F64 QUANTILEsketch::get_quantile(const F64 fraction) const
+{
+  if (count == 0)
+  {
+    return 0.0;
+  }
+  if (fraction <= 0.0)
+  {
+    return min;
+  }
+  if (fraction >= 1.0)
+  {
+    return max;
+  }
+
+  U32 h, i, n = 0;
+  for (h = 0; h < number_of_levels; h++)
+  {
+    n += level_size[h];
+  }
+  QUANTILEitem* items = (QUANTILEitem*)malloc(sizeof(QUANTILEitem)*n);
+  if (items == 0)
+  {
+    return 0.0;
+  }
+  I64 total = 0;
+  n = 0;
+  for (h = 0; h < number_of_levels; h++)
+  {
+    for (i = 0; i < level_size[h]; i++)
+    {
+      items[n].value = levels[h][i];
+      items[n].weight = ((I64)1) << h;
+      total += items[n].weight;
+      n++;
+    }
+  }
+  qsort(items, n, sizeof(QUANTILEitem), compare_items);
+
+  F64 rank = fraction * total;
+  F64 value = max;
+  I64 cumulative = 0;
+  for (i = 0; i < n; i++)
+  {
+    cumulative += items[i].weight;
+    if (cumulative >= rank)
+    {
+      value = items[i].value;
+      break;
+    }
+  }
+  free(items);
+  return value;
+}
+
+QUANTILEsketch::QUANTILEsketch()
+{
+  count = 0;
+  min = max = 0.0;
+  random = 0x9E3779B9;
+  number_of_levels = 0;
+  memset(level_size, 0, sizeof(level_size));
+  memset(level_capacity, 0, sizeof(level_capacity));
+  memset(levels, 0, sizeof(levels));
+  add_level();
+}
+
+QUANTILEsketch::~QUANTILEsketch()
+{
+  for (U32 h = 0; h < number_of_levels; h++)
+  {
+    if (levels[h]) free(levels[h]);
+  }
+}
+
+void QUANTILEcheck::parse(const LASpoint* laspoint)
+{
+  sketches[QUANTILECHECK_Z].add((F64)laspoint->Z);
+  sketches[QUANTILECHECK_INTENSITY].add((F64)laspoint->intensity);
+  if (has_gps_time)
+  {
+    sketches[QUANTILECHECK_GPS_TIME].add(laspoint->gps_time);
+  }
+}
+
+// the Z sketch holds the integers which are scaled and offset only for reporting
+
+F64 QUANTILEcheck::get_value(const U32 attribute, const F64 value) const
+{
+  if (attribute == QUANTILECHECK_Z)
+  {
+    return z_scale_factor*value + z_offset;
+  }
+  return value;
+}
+
+I32 QUANTILEcheck::format_value(CHAR* string, const U32 attribute, const F64 value) const
+{
+  if (attribute == QUANTILECHECK_Z)
+  {
+    return sprintf(string, "%.*f", decimal_digits(z_scale_factor), get_value(attribute, value));
+  }
+  else if (attribute == QUANTILECHECK_INTENSITY)
+  {
+    return sprintf(string, "%.0f", value);
+  }
+  return sprintf(string, "%.6f", value);
+}
+
+I32 QUANTILEcheck::format_distance(CHAR* string, const U32 attribute, const F64 distance) const
+{
+  if (attribute == QUANTILECHECK_Z)
+  {
+    return sprintf(string, "%.*f", decimal_digits(z_scale_factor), distance);
+  }
+  return format_value(string, attribute, distance);
+}
+
+void QUANTILEcheck::check(LASheader* lasheader)
+{
+  CHAR note[512];
+  CHAR extreme[64], quantile[64], tail[64], spread[64];
+  const CHAR* variables[QUANTILECHECK_ATTRIBUTES] = { "Z values", "intensity", "GPS time" };
+
+  for (U32 a = 0; a < QUANTILECHECK_ATTRIBUTES; a++)
+  {
+    const QUANTILEsketch* sketch = &sketches[a];
+    if (sketch->get_count() < QUANTILECHECK_MIN_POINTS)
+    {
+      continue;
+    }
+    F64 p0_1 = sketch->get_quantile(0.001);
+    F64 p1 = sketch->get_quantile(0.01);
+    F64 p99 = sketch->get_quantile(0.99);
+    F64 p99_9 = sketch->get_quantile(0.999);
+    F64 central = get_value(a, p99) - get_value(a, p1);
+    F64 lower = get_value(a, p0_1) - get_value(a, sketch->get_min());
+    F64 upper = get_value(a, sketch->get_max()) - get_value(a, p99_9);
+    format_distance(spread, a, central);
+    if (lower > QUANTILECHECK_TAIL_FACTOR*central)
+    {
+      format_value(extreme, a, sketch->get_min());
+      format_value(quantile, a, p0_1);
+      format_distance(tail, a, lower);
+      sprintf(note, "heavy lower tail: minimum of %s is %s below the 0.1 percentile of %s while the 1 to 99 percentiles span %s", extreme, tail, quantile, spread);
+      lasheader->add_warning(variables[a], note);
+    }
+    if (upper > QUANTILECHECK_TAIL_FACTOR*central)
+    {
+      format_value(extreme, a, sketch->get_max());
+      format_value(quantile, a, p99_9);
+      format_distance(tail, a, upper);
+      sprintf(note, "heavy upper tail: maximum of %s is %s above the 99.9 percentile of %s while the 1 to 99 percentiles span %s", extreme, tail, quantile, spread);
+      lasheader->add_warning(variables[a], note);
+    }
+  }
+}
+
+void QUANTILEcheck::write_statistics(XMLwriter* xmlwriter) const
+{
+  CHAR value[512];
+  const CHAR* names[QUANTILECHECK_ATTRIBUTES] = { "z_quantiles", "intensity_quantiles", "gps_time_quantiles" };
+
+  for (U32 a = 0; a < QUANTILECHECK_ATTRIBUTES; a++)
+  {
+    if (sketches[a].get_count() == 0)
+    {
+      continue;
+    }
+    I32 len = 0;
+    for (U32 q = 0; q < QUANTILECHECK_NUMBER; q++)
+    {
+      len += sprintf(&value[len], (q ? " %s:" : "%s:"), quantile_names[q]);
+      len += format_value(&value[len], a, sketches[a].get_quantile(quantile_fractions[q]));
+    }
+    xmlwriter->write(names[a], value);
+  }
+}
+
+QUANTILEcheck::QUANTILEcheck(const LASheader* lasheader)
+{
+  has_gps_time = format_has_gps_time(lasheader->point_data_format);
+  z_scale_factor = lasheader->z_scale_factor;
+  z_offset = lasheader->z_offset;
+}
+
+QUANTILEcheck::~QUANTILEcheck()
+{
+}
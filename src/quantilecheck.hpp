@@ -0,0 +1,106 @@
+/*
+===============================================================================
+
+  FILE:  quantilecheck.hpp
+
+  CONTENTS:
+
+    Streaming quantile sketches for Z, intensity, and GPS time that find
+    outliers without sorting or a second pass. QUANTILEsketch is a KLL sketch
+    (Karnin, Lang, Liberty 2016): a stack of levels where each item of level h
+    stands for 2^h values. A full level is sorted and every other item moves
+    up one level, where it is merged into the already sorted items. Each level has a fixed buffer of 2k values that is
+    allocated once, and the number of levels only grows with log(n). The rank error is about 1.7/k. Two sketches can be
+    merged, for example to combine the files of a batch.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    19 October 2026 -- cached capacities, fixed level buffers, sorted levels
+    19 October 2026 -- created for telling outlier spikes from bad files
+
+===============================================================================
+*/
+#ifndef QUANTILE_CHECK_HPP
+#define QUANTILE_CHECK_HPP
+
+#include "lasheader.hpp"
+#include "laspoint.hpp"
+
+#include "xmlwriter.hpp"
+
+#define QUANTILESKETCH_K 2048
+#define QUANTILESKETCH_MAX_LEVELS 48
+#define QUANTILESKETCH_MIN_CAPACITY (QUANTILESKETCH_K/8)
+#define QUANTILESKETCH_BUFFER (2*QUANTILESKETCH_K)
+
+class QUANTILEsketch
+{
+public:
+
+  void add(const F64 value);
+  void merge(const QUANTILEsketch* sketch);
+  F64 get_quantile(const F64 fraction) const;
+
+  I64 get_count() const { return count; };
+  F64 get_min() const { return min; };
+  F64 get_max() const { return max; };
+
+  QUANTILEsketch();
+  ~QUANTILEsketch();
+
+private:
+  I64 count;
+  F64 min, max;
+  U32 random;
+  U32 number_of_levels;
+  U32 level_size[QUANTILESKETCH_MAX_LEVELS];
+  U32 level_capacity[QUANTILESKETCH_MAX_LEVELS];
+  F64* levels[QUANTILESKETCH_MAX_LEVELS];
+  void set_capacities();
+  void add_level();
+  BOOL push(const U32 level, const F64 value);
+  BOOL push_sorted(const U32 level, const F64* values, const U32 stride, U32 number);
+  void compress();
+};
+
+#define QUANTILECHECK_Z          0
+#define QUANTILECHECK_INTENSITY  1
+#define QUANTILECHECK_GPS_TIME   2
+#define QUANTILECHECK_ATTRIBUTES 3
+
+class QUANTILEcheck
+{
+public:
+
+  void parse(const LASpoint* laspoint);
+  void check(LASheader* lasheader);
+  void write_statistics(XMLwriter* xmlwriter) const;
+
+  QUANTILEcheck(const LASheader* lasheader);
+  ~QUANTILEcheck();
+
+private:
+  BOOL has_gps_time;
+  F64 z_scale_factor, z_offset;
+  QUANTILEsketch sketches[QUANTILECHECK_ATTRIBUTES];
+  F64 get_value(const U32 attribute, const F64 value) const;
+  I32 format_value(CHAR* string, const U32 attribute, const F64 value) const;
+  I32 format_distance(CHAR* string, const U32 attribute, const F64 distance) const;
+};
+
+#endif
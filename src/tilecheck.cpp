@@ -0,0 +1,496 @@
+/*
+===============================================================================
+
+  FILE:  tilecheck.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "tilecheck.hpp"
+
+// boxes are snapped to the grid with this fraction of a cell as tolerance
+
+#define TILECHECK_SNAP 0.01
+
+// boxes are sorted by min_x and then by everything else so that identical boxes
+// end up next to each other
+
+static int compare_boxes(const void* a, const void* b)
+{
+  const TILEbox* box_a = (const TILEbox*)a;
+  const TILEbox* box_b = (const TILEbox*)b;
+  if (box_a->min_x != box_b->min_x) return (box_a->min_x < box_b->min_x ? -1 : 1);
+  if (box_a->max_x != box_b->max_x) return (box_a->max_x < box_b->max_x ? -1 : 1);
+  if (box_a->min_y != box_b->min_y) return (box_a->min_y < box_b->min_y ? -1 : 1);
+  if (box_a->max_y != box_b->max_y) return (box_a->max_y < box_b->max_y ? -1 : 1);
+  return (box_a->file < box_b->file ? -1 : (box_a->file > box_b->file ? 1 : 0));
+}
+
+static int compare_coordinates(const void* a, const void* b)
+{
+  const TILEcoordinate* coordinate_a = (const TILEcoordinate*)a;
+  const TILEcoordinate* coordinate_b = (const TILEcoordinate*)b;
+  if (coordinate_a->value != coordinate_b->value) return (coordinate_a->value < coordinate_b->value ? -1 : 1);
+  return (coordinate_a->box < coordinate_b->box ? -1 : (coordinate_a->box > coordinate_b->box ? 1 : 0));
+}
+
+static BOOL same_box(const TILEbox* a, const TILEbox* b)
+{
+  return ((a->min_x == b->min_x) && (a->min_y == b->min_y) && (a->max_x == b->max_x) && (a->max_y == b->max_y));
+}
+
+// sets a leaf of the max tree and updates the maxima above it
+
+static void set_leaf(F64* tree, const U32 leaves, const U32 leaf, const F64 value)
+{
+  U32 node = leaves + leaf;
+  tree[node] = value;
+  while (node > 1)
+  {
+    node /= 2;
+    tree[node] = (tree[2*node] > tree[2*node+1] ? tree[2*node] : tree[2*node+1]);
+  }
+}
+
+static int compare_f64(const void* a, const void* b)
+{
+  F64 value_a = *((const F64*)a);
+  F64 value_b = *((const F64*)b);
+  return (value_a < value_b ? -1 : (value_a > value_b ? 1 : 0));
+}
+
+void TILEcheck::add(const CHAR* file_name, const LASheader* lasheader)
+{
+  // only boxes that are boxes
+
+  if (!(lasheader->min_x <= lasheader->max_x) || !(lasheader->min_y <= lasheader->max_y))
+  {
+    return;
+  }
+
+  if (number_of_tiles == allocated_tiles)
+  {
+    allocated_tiles = (allocated_tiles ? 2*allocated_tiles : 256);
+    boxes = (TILEbox*)realloc(boxes, sizeof(TILEbox)*allocated_tiles);
+    file_names = (CHAR**)realloc(file_names, sizeof(CHAR*)*allocated_tiles);
+  }
+
+  boxes[number_of_tiles].min_x = lasheader->min_x;
+  boxes[number_of_tiles].min_y = lasheader->min_y;
+  boxes[number_of_tiles].max_x = lasheader->max_x;
+  boxes[number_of_tiles].max_y = lasheader->max_y;
+  boxes[number_of_tiles].file = number_of_tiles;
+  file_names[number_of_tiles] = (CHAR*)malloc(strlen(file_name) + 1);
+  strcpy(file_names[number_of_tiles], file_name);
+  number_of_tiles++;
+}
+
+void TILEcheck::add_pair(const TILEbox* other, const TILEbox* box)
+{
+  TILEpair pair;
+  pair.file1 = (other->file < box->file ? other->file : box->file);
+  pair.file2 = (other->file < box->file ? box->file : other->file);
+  if (same_box(other, box))
+  {
+    pair.width = box->max_x - box->min_x;
+    pair.height = box->max_y - box->min_y;
+    if (number_of_duplicate_samples < TILECHECK_SAMPLES)
+    {
+      duplicate_samples[number_of_duplicate_samples++] = pair;
+    }
+    number_of_duplicates++;
+  }
+  else
+  {
+    pair.width = (other->max_x < box->max_x ? other->max_x : box->max_x) - box->min_x;
+    pair.height = (other->max_y < box->max_y ? other->max_y : box->max_y) - (other->min_y > box->min_y ? other->min_y : box->min_y);
+    if (number_of_overlap_samples < TILECHECK_SAMPLES)
+    {
+      overlap_samples[number_of_overlap_samples++] = pair;
+    }
+    number_of_overlaps++;
+  }
+}
+
+void TILEcheck::check_overlaps()
+{
+  U32 i, j;
+
+  // the ranks of the boxes in the order of their min_y
+
+  TILEcoordinate* min_ys = (TILEcoordinate*)malloc(sizeof(TILEcoordinate)*number_of_tiles);
+  for (i = 0; i < number_of_tiles; i++)
+  {
+    min_ys[i].value = boxes[i].min_y;
+    min_ys[i].box = i;
+  }
+  qsort(min_ys, number_of_tiles, sizeof(TILEcoordinate), compare_coordinates);
+  U32* ranks = (U32*)malloc(sizeof(U32)*number_of_tiles);
+  for (i = 0; i < number_of_tiles; i++)
+  {
+    ranks[min_ys[i].box] = i;
+  }
+
+  // a max tree over the ranks. the leaf of a box that crosses the sweep line holds its
+  // max_y and all other leaves hold minus infinity, so the search for the boxes that
+  // reach into this box only descends into subtrees with a max_y above its min_y.
+
+  U32 leaves = 1;
+  while (leaves < number_of_tiles)
+  {
+    leaves *= 2;
+  }
+  F64* tree = (F64*)malloc(sizeof(F64)*2*leaves);
+  for (i = 0; i < 2*leaves; i++)
+  {
+    tree[i] = -HUGE_VAL;
+  }
+
+  // the boxes that cross the sweep line in a min heap by max_x
+
+  U32* heap = (U32*)malloc(sizeof(U32)*number_of_tiles);
+  U32 heap_size = 0;
+
+  U32 stack_node[64];
+  U32 stack_lo[64];
+  U32 stack_width[64];
+
+  for (i = 0; i < number_of_tiles; i++)
+  {
+    const TILEbox* box = &(boxes[i]);
+
+    // remove the boxes that end before the sweep line
+
+    while (heap_size && (boxes[heap[0]].max_x <= box->min_x))
+    {
+      set_leaf(tree, leaves, ranks[heap[0]], -HUGE_VAL);
+      heap_size--;
+      heap[0] = heap[heap_size];
+      U32 parent = 0;
+      while (TRUE)
+      {
+        U32 child = 2*parent + 1;
+        if (child >= heap_size) break;
+        if (((child + 1) < heap_size) && (boxes[heap[child+1]].max_x < boxes[heap[child]].max_x)) child++;
+        if (boxes[heap[parent]].max_x <= boxes[heap[child]].max_x) break;
+        U32 swap = heap[parent]; heap[parent] = heap[child]; heap[child] = swap;
+        parent = child;
+      }
+    }
+
+    // identical boxes are next to each other in the sorted order
+
+    for (j = i; (j > 0) && same_box(&(boxes[j-1]), box); j--)
+    {
+      add_pair(&(boxes[j-1]), box);
+    }
+
+    // the active boxes that start below the top of this box ...
+
+    U32 lo = 0;
+    U32 hi = number_of_tiles;
+    while (lo < hi)
+    {
+      U32 mid = (lo + hi) / 2;
+      if (min_ys[mid].value < box->max_y)
+      {
+        lo = mid + 1;
+      }
+      else
+      {
+        hi = mid;
+      }
+    }
+    U32 end = lo;
+
+    // ... and end above its bottom
+
+    U32 stack_size = 0;
+    if (end)
+    {
+      stack_node[0] = 1;
+      stack_lo[0] = 0;
+      stack_width[0] = leaves;
+      stack_size = 1;
+    }
+    while (stack_size)
+    {
+      stack_size--;
+      U32 node = stack_node[stack_size];
+      U32 node_lo = stack_lo[stack_size];
+      U32 width = stack_width[stack_size];
+      if ((node_lo >= end) || !(tree[node] > box->min_y))
+      {
+        continue;
+      }
+      if (width == 1)
+      {
+        // a box without width does not overlap the boxes that start at its x
+
+        const TILEbox* other = &(boxes[min_ys[node_lo].box]);
+        if ((other->min_x < box->max_x) && !same_box(other, box))
+        {
+          add_pair(other, box);
+        }
+        continue;
+      }
+      width /= 2;
+      stack_node[stack_size] = 2*node + 1;
+      stack_lo[stack_size] = node_lo + width;
+      stack_width[stack_size] = width;
+      stack_node[stack_size+1] = 2*node;
+      stack_lo[stack_size+1] = node_lo;
+      stack_width[stack_size+1] = width;
+      stack_size += 2;
+    }
+
+    // insert this box into the active boxes
+
+    set_leaf(tree, leaves, ranks[i], box->max_y);
+    U32 child = heap_size++;
+    heap[child] = i;
+    while (child)
+    {
+      U32 parent = (child - 1) / 2;
+      if (boxes[heap[parent]].max_x <= boxes[heap[child]].max_x) break;
+      U32 swap = heap[parent]; heap[parent] = heap[child]; heap[child] = swap;
+      child = parent;
+    }
+  }
+
+  free(heap);
+  free(tree);
+  free(ranks);
+  free(min_ys);
+}
+
+void TILEcheck::check_gaps(const F64 tile_size, const F64 origin_x, const F64 origin_y)
+{
+  U32 i, col, row;
+
+  // the cells are tiles of the given size or as large as the median tile
+
+  F64 min_x = boxes[0].min_x;
+  F64 min_y = boxes[0].min_y;
+  F64 max_x = boxes[0].max_x;
+  F64 max_y = boxes[0].max_y;
+  for (i = 1; i < number_of_tiles; i++)
+  {
+    if (boxes[i].min_x < min_x) min_x = boxes[i].min_x;
+    if (boxes[i].min_y < min_y) min_y = boxes[i].min_y;
+    if (boxes[i].max_x > max_x) max_x = boxes[i].max_x;
+    if (boxes[i].max_y > max_y) max_y = boxes[i].max_y;
+  }
+
+  if (tile_size > 0.0)
+  {
+    cell_width = cell_height = tile_size;
+    min_x = origin_x + tile_size*floor((min_x - origin_x)/tile_size + TILECHECK_SNAP);
+    min_y = origin_y + tile_size*floor((min_y - origin_y)/tile_size + TILECHECK_SNAP);
+  }
+  else
+  {
+    F64* sizes = (F64*)malloc(sizeof(F64)*number_of_tiles);
+    for (i = 0; i < number_of_tiles; i++) sizes[i] = boxes[i].max_x - boxes[i].min_x;
+    qsort(sizes, number_of_tiles, sizeof(F64), compare_f64);
+    cell_width = sizes[number_of_tiles/2];
+    for (i = 0; i < number_of_tiles; i++) sizes[i] = boxes[i].max_y - boxes[i].min_y;
+    qsort(sizes, number_of_tiles, sizeof(F64), compare_f64);
+    cell_height = sizes[number_of_tiles/2];
+    free(sizes);
+  }
+
+  if (!(cell_width > 0.0) || !(cell_height > 0.0))
+  {
+    return;
+  }
+
+  F64 width = ceil((max_x - min_x)/cell_width - TILECHECK_SNAP);
+  F64 height = ceil((max_y - min_y)/cell_height - TILECHECK_SNAP);
+  if (width < 1.0) width = 1.0;
+  if (height < 1.0) height = 1.0;
+  if ((width * height) > TILECHECK_MAX_CELLS)
+  {
+    too_many_cells = TRUE;
+    return;
+  }
+  U32 ncols = (U32)width;
+  U32 nrows = (U32)height;
+
+  // mark the cells covered by a box with 1
+
+  U8* cells = (U8*)calloc(ncols*nrows, sizeof(U8));
+  for (i = 0; i < number_of_tiles; i++)
+  {
+    I32 col0 = (I32)floor((boxes[i].min_x - min_x)/cell_width + TILECHECK_SNAP);
+    I32 col1 = (I32)ceil((boxes[i].max_x - min_x)/cell_width - TILECHECK_SNAP);
+    I32 row0 = (I32)floor((boxes[i].min_y - min_y)/cell_height + TILECHECK_SNAP);
+    I32 row1 = (I32)ceil((boxes[i].max_y - min_y)/cell_height - TILECHECK_SNAP);
+    if (col1 <= col0) col1 = col0 + 1;
+    if (row1 <= row0) row1 = row0 + 1;
+    if (col0 < 0) col0 = 0;
+    if (row0 < 0) row0 = 0;
+    if (col1 > (I32)ncols) col1 = ncols;
+    if (row1 > (I32)nrows) row1 = nrows;
+    for (row = row0; row < (U32)row1; row++)
+    {
+      for (col = col0; col < (U32)col1; col++)
+      {
+        cells[row*ncols+col] = 1;
+      }
+    }
+  }
+
+  // flood the uncovered cells connected to the border with 2 and then each gap with 3
+
+  U32* stack = (U32*)malloc(sizeof(U32)*ncols*nrows);
+  for (U32 pass = 0; pass < 2; pass++)
+  {
+    for (i = 0; i < ncols*nrows; i++)
+    {
+      col = i % ncols;
+      row = i / ncols;
+      if (cells[i] != 0)
+      {
+        continue;
+      }
+      if ((pass == 0) && (col != 0) && (row != 0) && (col != ncols-1) && (row != nrows-1))
+      {
+        continue;
+      }
+      U32 number_of_cells = 0;
+      U32 number_of_stack = 0;
+      cells[i] = (U8)(pass + 2);
+      stack[number_of_stack++] = i;
+      while (number_of_stack)
+      {
+        U32 c = stack[--number_of_stack];
+        U32 c_col = c % ncols;
+        U32 c_row = c / ncols;
+        number_of_cells++;
+        if ((c_col > 0) && (cells[c-1] == 0)) { cells[c-1] = (U8)(pass + 2); stack[number_of_stack++] = c-1; }
+        if ((c_col < ncols-1) && (cells[c+1] == 0)) { cells[c+1] = (U8)(pass + 2); stack[number_of_stack++] = c+1; }
+        if ((c_row > 0) && (cells[c-ncols] == 0)) { cells[c-ncols] = (U8)(pass + 2); stack[number_of_stack++] = c-ncols; }
+        if ((c_row < nrows-1) && (cells[c+ncols] == 0)) { cells[c+ncols] = (U8)(pass + 2); stack[number_of_stack++] = c+ncols; }
+      }
+      if (pass == 1)
+      {
+        if (number_of_gap_samples < TILECHECK_SAMPLES)
+        {
+          gap_samples[number_of_gap_samples].cells = number_of_cells;
+          gap_samples[number_of_gap_samples].x = min_x + (col + 0.5)*cell_width;
+          gap_samples[number_of_gap_samples].y = min_y + (row + 0.5)*cell_height;
+          number_of_gap_samples++;
+        }
+        number_of_gaps++;
+        number_of_gap_cells += number_of_cells;
+      }
+    }
+  }
+  free(stack);
+  free(cells);
+}
+
+void TILEcheck::check(const F64 tile_size, const F64 origin_x, const F64 origin_y)
+{
+  if (number_of_tiles < 2)
+  {
+    return;
+  }
+  qsort(boxes, number_of_tiles, sizeof(TILEbox), compare_boxes);
+  check_overlaps();
+  check_gaps(tile_size, origin_x, origin_y);
+}
+
+BOOL TILEcheck::has_warnings() const
+{
+  return (number_of_overlaps || number_of_duplicates || number_of_gaps || too_many_cells);
+}
+
+void TILEcheck::write(XMLwriter* xmlwriter) const
+{
+  U32 i;
+  CHAR note[1024];
+
+  xmlwriter->write("tiles", (I32)number_of_tiles);
+  xmlwriter->write("overlaps", (I32)number_of_overlaps);
+  xmlwriter->write("duplicates", (I32)number_of_duplicates);
+  xmlwriter->write("gaps", (I32)number_of_gaps);
+  xmlwriter->write("gap_cells", (I32)number_of_gap_cells);
+
+  for (i = 0; i < number_of_duplicate_samples; i++)
+  {
+    sprintf(note, "'%.400s' and '%.400s' have identical bounding boxes of %g by %g", file_names[duplicate_samples[i].file1], file_names[duplicate_samples[i].file2], duplicate_samples[i].width, duplicate_samples[i].height);
+    xmlwriter->write("duplicate tiles", "warning", note);
+  }
+  for (i = 0; i < number_of_overlap_samples; i++)
+  {
+    sprintf(note, "'%.400s' and '%.400s' overlap by %g by %g", file_names[overlap_samples[i].file1], file_names[overlap_samples[i].file2], overlap_samples[i].width, overlap_samples[i].height);
+    xmlwriter->write("overlapping tiles", "warning", note);
+  }
+  for (i = 0; i < number_of_gap_samples; i++)
+  {
+    sprintf(note, "%u uncovered cells of size %g by %g starting at %.2f %.2f are enclosed by tiles", gap_samples[i].cells, cell_width, cell_height, gap_samples[i].x, gap_samples[i].y);
+    xmlwriter->write("gap in tiles", "warning", note);
+  }
+  if (too_many_cells)
+  {
+    sprintf(note, "cannot check for gaps because the tiles of size %g by %g span too many cells", cell_width, cell_height);
+    xmlwriter->write("gap in tiles", "warning", note);
+  }
+}
+
+TILEcheck::TILEcheck()
+{
+  number_of_tiles = 0;
+  allocated_tiles = 0;
+  boxes = 0;
+  file_names = 0;
+  number_of_overlaps = 0;
+  number_of_duplicates = 0;
+  number_of_gaps = 0;
+  number_of_gap_cells = 0;
+  cell_width = cell_height = 0.0;
+  too_many_cells = FALSE;
+  number_of_overlap_samples = 0;
+  number_of_duplicate_samples = 0;
+  number_of_gap_samples = 0;
+}
+
+TILEcheck::~TILEcheck()
+{
+  for (U32 i = 0; i < number_of_tiles; i++)
+  {
+    free(file_names[i]);
+  }
+  if (file_names) free(file_names);
+  if (boxes) free(boxes);
+}
@@ -0,0 +1,117 @@
+/*
+===============================================================================
+
+  FILE:  tilecheck.hpp
+
+  CONTENTS:
+
+    Collects the header bounding boxes of all files of a batch and checks the
+    tiling as a whole. Overlapping and duplicate tiles are found with a sweep
+    over the boxes sorted by x. The boxes crossing the sweep line leave it
+    through a min heap by their max x and are found through a max tree by
+    their max y over the boxes sorted by min y, so each box costs time that
+    is logarithmic in the number of boxes plus the number of its overlaps.
+    Holes in the tiling are found by snapping the boxes onto a
+    grid of tile sized cells and flooding the uncovered cells from the border
+    of the grid. Uncovered cells that the flood does not reach are gaps.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2007-2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    19 October 2026 -- overlaps in O(n log n) with a heap and a max tree
+    19 October 2026 -- created for detecting overlaps and holes in a tiling
+
+===============================================================================
+*/
+#ifndef TILE_CHECK_HPP
+#define TILE_CHECK_HPP
+
+#include "lasheader.hpp"
+
+#include "xmlwriter.hpp"
+
+#define TILECHECK_SAMPLES 10
+#define TILECHECK_MAX_CELLS 0x4000000
+
+class TILEbox
+{
+public:
+  F64 min_x, min_y;
+  F64 max_x, max_y;
+  U32 file;
+};
+
+class TILEcoordinate
+{
+public:
+  F64 value;
+  U32 box;
+};
+
+class TILEpair
+{
+public:
+  U32 file1, file2;
+  F64 width, height;
+};
+
+class TILEgap
+{
+public:
+  U32 cells;
+  F64 x, y;
+};
+
+class TILEcheck
+{
+public:
+
+  void add(const CHAR* file_name, const LASheader* lasheader);
+  void check(const F64 tile_size=0.0, const F64 origin_x=0.0, const F64 origin_y=0.0);
+  BOOL has_warnings() const;
+  void write(XMLwriter* xmlwriter) const;
+
+  TILEcheck();
+  ~TILEcheck();
+
+private:
+  U32 number_of_tiles;
+  U32 allocated_tiles;
+  TILEbox* boxes;
+  CHAR** file_names;
+
+  void check_overlaps();
+  void add_pair(const TILEbox* other, const TILEbox* box);
+  void check_gaps(const F64 tile_size, const F64 origin_x, const F64 origin_y);
+
+  // the results
+
+  U32 number_of_overlaps;
+  U32 number_of_duplicates;
+  U32 number_of_gaps;
+  U32 number_of_gap_cells;
+  F64 cell_width, cell_height;
+  BOOL too_many_cells;
+  U32 number_of_overlap_samples;
+  TILEpair overlap_samples[TILECHECK_SAMPLES];
+  U32 number_of_duplicate_samples;
+  TILEpair duplicate_samples[TILECHECK_SAMPLES];
+  U32 number_of_gap_samples;
+  TILEgap gap_samples[TILECHECK_SAMPLES];
+};
+
+#endif